@@ -0,0 +1,65 @@
+param(
+  [int]$Rigs = 12,
+  [int]$Enemies = 8,
+  [int]$Viewers = 1,
+  [int]$Cycles = 20,
+  [switch]$UpdateBaseline
+)
+
+$ErrorActionPreference = 'Stop'
+
+function Find-UnrealEditor {
+  $cands = @(
+    'C:\Program Files\Epic Games\UE_5.6\Engine\Binaries\Win64\UnrealEditor.exe',
+    'C:\Program Files\Epic Games\UE_5.5\Engine\Binaries\Win64\UnrealEditor.exe'
+  )
+  foreach ($p in $cands) { if (Test-Path $p) { return $p } }
+  throw 'Could not find UnrealEditor.exe in common locations.'
+}
+
+$uproject = (Resolve-Path 'ThirdPersonCameraMan.uproject').Path
+$editor = Find-UnrealEditor
+
+$benchCmd = "director.Bench rigs=$Rigs enemies=$Enemies viewers=$Viewers cycles=$Cycles"
+if ($UpdateBaseline) { $benchCmd += ' baseline' }
+
+Write-Host "Starting benchmark host (listen server, null RHI)..."
+$serverArgs = @(
+  '"' + $uproject + '"',
+  '-game', '-nullrhi', '-unattended', '-nosound', '-log',
+  '-listen',
+  '-DirectorBenchAllocs', '-DirectorBenchExit',
+  '-ExecCmds="' + $benchCmd + '"'
+)
+$server = Start-Process -FilePath $editor -ArgumentList $serverArgs -PassThru
+
+Start-Sleep -Seconds 2
+
+$clients = @()
+for ($i = 0; $i -lt $Viewers; $i++) {
+  Write-Host "Starting viewer $($i + 1) (client, null RHI)..."
+  $clientArgs = @(
+    '"' + $uproject + '"',
+    '-game', '-nullrhi', '-unattended', '-nosound', '-log',
+    '-ExecCmds="open 127.0.0.1"'
+  )
+  $clients += Start-Process -FilePath $editor -ArgumentList $clientArgs -PassThru
+}
+
+$server.WaitForExit()
+foreach ($c in $clients) { if (-not $c.HasExited) { Stop-Process -Id $c.Id -Force } }
+
+# 0 = passed, 1 = regression or missed cut, 2 = ungated (a metric has no baseline yet)
+if ($server.ExitCode -eq 2 -and $UpdateBaseline) {
+  Write-Host "Director benchmark baseline recorded in Config/DefaultGame.ini."
+  exit 0
+}
+if ($server.ExitCode -eq 2) {
+  Write-Host "Director benchmark UNGATED: no stored baseline for some metrics. Record one with -UpdateBaseline. See Saved/Profiling/Director/Bench-*.csv"
+  exit 2
+}
+if ($server.ExitCode -ne 0) {
+  Write-Host "Director benchmark FAILED (exit $($server.ExitCode)). See Saved/Profiling/Director/Bench-*.csv"
+  exit $server.ExitCode
+}
+Write-Host "Director benchmark passed."
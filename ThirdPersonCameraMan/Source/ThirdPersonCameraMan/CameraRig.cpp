@@ -10,10 +10,18 @@
 
 #include "ThirdPersonCameraManGameMode.h"
 #include "DirectorGameState.h"
-#include "ThirdPersonCameraManCharacter.h"
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/Character.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "DirectorStats.h"
+#include "DirectorSwitchTelemetry.h"
+#include "DirectorRigRegistry.h"
+#include "DirectorOcclusionService.h"
+#include "DirectorLensCache.h"
+#include "DirectorRigLOD.h"
+#include "DirectorViewerProfile.h"
+#include "DirectorRigMounts.h"
+#include "DirectorCutList.h"
 
 #include <cfloat> // for FLT_MAX
 
@@ -86,9 +94,76 @@ FString ACameraRig::GetRigDisplayName() const
 #endif
 }
 
+float ACameraRig::GetSubjectOcclusion(AActor* Subject) const
+{
+    const UDirectorOcclusionService* Occlusion = UDirectorOcclusionService::Get(this);
+    float Value = -1.f;
+    return (Occlusion && Occlusion->GetOcclusion(this, Subject, Value)) ? Value : -1.f;
+}
+
+void ACameraRig::RefreshCachedStrings() const
+{
+    if (bCachedStringsValid && CachedLabel == RigLabel) return;
+
+    CachedLabel = RigLabel;
+    bCachedStringsValid = true;
+
+    const FString RigName = GetRigDisplayName();
+    CachedSwitchedToast = FString::Printf(TEXT("Switched to :  %s"), *RigName);
+    CachedPickupToasts.Reset();
+
+    // Drop toast has always shown the actor label / name rather than RigLabel
+#if WITH_EDITOR
+    CachedDroppedToast = FString::Printf(TEXT("player dropped :  %s"), *GetActorLabel());
+#else
+    CachedDroppedToast = FString::Printf(TEXT("player dropped :  %s"), *GetName());
+#endif
+}
+
+const FString& ACameraRig::GetPickupToast(int32 PlayerNum) const
+{
+    RefreshCachedStrings();
+    PlayerNum = FMath::Max(1, PlayerNum);
+    if (CachedPickupToasts.Num() < PlayerNum)
+    {
+        // New player numbers are formatted once, then reused for every later pickup
+        const FString RigName = GetRigDisplayName();
+        for (int32 i = CachedPickupToasts.Num() + 1; i <= PlayerNum; ++i)
+        {
+            CachedPickupToasts.Add(FString::Printf(TEXT("player %d picked up :  %s"), i, *RigName));
+        }
+    }
+    return CachedPickupToasts[PlayerNum - 1];
+}
+
+const FString& ACameraRig::GetSwitchedToast() const
+{
+    RefreshCachedStrings();
+    return CachedSwitchedToast;
+}
+
+const FString& ACameraRig::GetDroppedToast() const
+{
+    RefreshCachedStrings();
+    return CachedDroppedToast;
+}
+
 void ACameraRig::BeginPlay()
 {
     Super::BeginPlay();
+
+    // Format the toasts up front (first two players) so the first pickup doesn't pay for it
+    GetPickupToast(2);
+
+    if (UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this))
+    {
+        Registry->Register(this);
+    }
+
+#if STATS
+    CaptureStatId = FDynamicStats::CreateStatId<FStatGroup_STATGROUP_Director>(
+        FName(*FString::Printf(TEXT("Capture %s"), *GetRigDisplayName())));
+#endif
     // Ensure a valid render target exists, even if not set in editor
     if (!RenderTarget)
     {
@@ -117,6 +192,12 @@ void ACameraRig::BeginPlay()
         }
     }
 
+    // Device-class feed cost on this machine (rate, size, show flags)
+    if (const UDirectorViewerProfileSubsystem* ViewerProfile = UDirectorViewerProfileSubsystem::Get(this))
+    {
+        ViewerProfile->ApplyToRig(this);
+    }
+
     ApplyLocalOffsets();
 
     // If VisualMesh has no asset, mirror Mesh's asset into it and hide the root mesh
@@ -136,6 +217,15 @@ void ACameraRig::BeginPlay()
 
 
 
+void ACameraRig::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this))
+    {
+        Registry->Unregister(this);
+    }
+    Super::EndPlay(EndPlayReason);
+}
+
 bool ACameraRig::IsActiveOnServer() const
 {
     if (!HasAuthority()) return false;
@@ -147,6 +237,95 @@ bool ACameraRig::IsActiveOnServer() const
 }
 
 void ACameraRig::CalcCamera(float DeltaTime, FMinimalViewInfo& OutResult)
+{
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorCalcCamera);
+
+    // Stabilized pose when the stabilizer ran for us this frame, raw otherwise
+    if (StabilizedViewFrame == GFrameCounter)
+    {
+        OutResult.Location = StabilizedViewLocation;
+        OutResult.Rotation = StabilizedViewRotation;
+    }
+    else
+    {
+        GetViewPose(OutResult.Location, OutResult.Rotation);
+    }
+    OutResult.FOV = CameraComponent ? CameraComponent->FieldOfView : 90.f;
+}
+
+void ACameraRig::SetStabilizedViewPose(const FVector& Location, const FRotator& Rotation)
+{
+    StabilizedViewLocation = Location;
+    StabilizedViewRotation = Rotation;
+    StabilizedViewFrame = GFrameCounter;
+}
+
+bool ACameraRig::IsCapturing() const
+{
+    return SceneCapture && SceneCapture->bCaptureEveryFrame;
+}
+
+void ACameraRig::GetViewPose(FVector& OutLocation, FRotator& OutRotation) const
+{
+    if (RenderViewFrame == GFrameCounter)
+    {
+        OutLocation = RenderViewLocation;
+        OutRotation = RenderViewRotation;
+        return;
+    }
+    ComputeRawViewPose(OutLocation, OutRotation);
+}
+
+// Sub-tick interpolation: when the simulation poses change less often than we render, show them one
+// source interval late and blend between samples instead of holding each one for several frames
+void ACameraRig::UpdateRenderPose(double Now, float DeltaTime)
+{
+    FVector SimLocation;
+    FRotator SimRotation;
+    ComputeRawViewPose(SimLocation, SimRotation);
+    ViewHistory.AddSample(Now, SimLocation, SimRotation.Quaternion());
+
+    const auto ShouldInterpolate = [this, DeltaTime](const FDirectorPoseHistory& History, double& OutDelay)
+    {
+        OutDelay = History.GetSampleInterval();
+        return bInterpolateSubTick && OutDelay > DeltaTime * 1.5f && OutDelay <= MaxInterpolationDelay;
+    };
+
+    double Delay = 0.0;
+    FQuat RenderRotation;
+    if (ShouldInterpolate(ViewHistory, Delay) && ViewHistory.Evaluate(Now - Delay, RenderViewLocation, RenderRotation))
+    {
+        RenderViewRotation = RenderRotation.Rotator();
+    }
+    else
+    {
+        RenderViewLocation = SimLocation;
+        RenderViewRotation = SimRotation;
+    }
+    RenderViewFrame = GFrameCounter;
+
+    // Capture lens: simulation placement is the pivot plus the lens offsets (ApplyLocalOffsets), not the
+    // component's own transform, which we overwrite below
+    if (!SceneCapture || !ViewPivot) return;
+
+    const FTransform SimCapture = FTransform(CameraRelativeRotation, CameraRelativeLocation) * ViewPivot->GetComponentTransform();
+    CaptureHistory.AddSample(Now, SimCapture.GetLocation(), SimCapture.GetRotation());
+
+    FVector CaptureLocation;
+    FQuat CaptureRotation;
+    if (IsCapturing() && ShouldInterpolate(CaptureHistory, Delay) && CaptureHistory.Evaluate(Now - Delay, CaptureLocation, CaptureRotation))
+    {
+        SceneCapture->SetWorldLocationAndRotation(CaptureLocation, CaptureRotation);
+        bCaptureInterpolated = true;
+    }
+    else if (bCaptureInterpolated)
+    {
+        SceneCapture->SetRelativeLocationAndRotation(CameraRelativeLocation, CameraRelativeRotation);
+        bCaptureInterpolated = false;
+    }
+}
+
+void ACameraRig::ComputeRawViewPose(FVector& OutLocation, FRotator& OutRotation) const
 {
     // Compute a first-person style view from our attachment reference, zeroing roll
     FTransform RefXf = GetActorTransform();
@@ -194,10 +373,8 @@ void ACameraRig::CalcCamera(float DeltaTime, FMinimalViewInfo& OutResult)
         CamRot.Roll += AlignRollOffsetDeg;
     }
 
-    const FVector CamLoc = RefXf.GetLocation() + CamRot.RotateVector(CameraRelativeLocation);
-    OutResult.Location = CamLoc;
-    OutResult.Rotation = CamRot;
-    OutResult.FOV = CameraComponent ? CameraComponent->FieldOfView : 90.f;
+    OutLocation = RefXf.GetLocation() + CamRot.RotateVector(CameraRelativeLocation);
+    OutRotation = CamRot;
 }
 
 // Local offsets: place camera (lens) and visual mesh (prop body) independently
@@ -239,6 +416,34 @@ void ACameraRig::ApplyLocalOffsets()
     }
 }
 
+void ACameraRig::CaptureInto(UTextureRenderTarget2D* Target)
+{
+    if (!SceneCapture || !Target) return;
+
+    // CaptureScene enqueues the render with the current target, so we can restore it right away
+    UTextureRenderTarget2D* Previous = SceneCapture->TextureTarget;
+    SceneCapture->TextureTarget = Target;
+    IssueCapture();
+    SceneCapture->TextureTarget = Previous;
+}
+
+void ACameraRig::IssueCapture()
+{
+    if (!SceneCapture) return;
+
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorCaptureIssue);
+#if STATS
+    FScopeCycleCounter RigScope(CaptureStatId);
+#endif
+    INC_DWORD_STAT(STAT_DirectorCapturesIssued);
+    SceneCapture->CaptureScene();
+
+    if (UDirectorSwitchTelemetry* Telemetry = UDirectorSwitchTelemetry::Get(this))
+    {
+        Telemetry->NoteCaptureIssued(this);
+    }
+}
+
 // Upright align: face pawn forward; apply yaw/pitch/roll offsets
 void ACameraRig::ReapplyViewAlignment(APawn* ReferencePawn)
 {
@@ -296,6 +501,9 @@ void ACameraRig::OnPawnBegin(UPrimitiveComponent*, AActor* OtherActor, UPrimitiv
 {
     if (!HasAuthority()) return;
 
+    // A cut list has the live slot; the operator gets it back when playback ends
+    if (UDirectorCutListPlayer::IsPlaying(this)) return;
+
     APawn* Pawn = Cast<APawn>(OtherActor);
     if (!Pawn) { UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] Overlap ignored: not a pawn"), *GetName()); return; }
 
@@ -305,8 +513,8 @@ void ACameraRig::OnPawnBegin(UPrimitiveComponent*, AActor* OtherActor, UPrimitiv
         {
             if (Operator == Pawn->GetController())
             {
-                UE_LOG(LogDirectorRig, Log, TEXT("[Rig %s] Pickup requested by %s"), *GetName(), *Operator->GetName());
-                Server_AttachToPawn(Pawn);
+                UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] Pickup requested by %s"), *GetName(), *Operator->GetName());
+                RequestPickup(Pawn);
             }
             else
             {
@@ -328,7 +536,7 @@ void ACameraRig::OnCameraBegin(UPrimitiveComponent*, AActor* OtherActor, UPrimit
     const float Now = GetWorld()->TimeSeconds;
     if (Now - LastSwitchTime < SwitchCooldown) return;
 
-    if (!IsActiveOnServer()) return;
+    if (!IsActiveOnServer() || UDirectorCutListPlayer::IsPlaying(this)) return;
 
     ACameraRig* OtherRig = Cast<ACameraRig>(OtherActor);
     if (!OtherRig || OtherRig == this)
@@ -338,8 +546,39 @@ void ACameraRig::OnCameraBegin(UPrimitiveComponent*, AActor* OtherActor, UPrimit
     }
 
     LastSwitchTime = Now;
-    UE_LOG(LogDirectorRig, Log, TEXT("[Rig %s] Switching to nearby rig %s"), *GetName(), *OtherRig->GetName());
-    Server_SwitchTo(OtherRig);
+    UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] Switching to nearby rig %s"), *GetName(), *OtherRig->GetName());
+    RequestSwitchTo(OtherRig);
+}
+
+void ACameraRig::RequestPickup(APawn* PawnOperator)
+{
+    if (!HasAuthority() || !PawnOperator) return;
+    if (ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>())
+    {
+        GS->BeginTransition();
+    }
+    Server_AttachToPawn(PawnOperator);
+}
+
+void ACameraRig::RequestGoLive(bool bIgnoreSwitchLock)
+{
+    if (!HasAuthority()) return;
+    ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    if (!GS || GS->ActiveCamera == this || (GS->IsSwitchLocked() && !bIgnoreSwitchLock)) return;
+
+    GS->StampSwitch();
+    GS->BeginTransition();
+    Server_GoLive();
+}
+
+void ACameraRig::RequestSwitchTo(ACameraRig* NewRig)
+{
+    if (!HasAuthority() || !NewRig || NewRig == this) return;
+    if (ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>())
+    {
+        GS->BeginTransition();
+    }
+    Server_SwitchTo(NewRig);
 }
 
 // Server-authoritative pickup: attach to pawn, align, enable capture, set ActiveCamera
@@ -347,12 +586,16 @@ void ACameraRig::Server_AttachToPawn(APawn* PawnOperator)
 {
     if (!HasAuthority() || !PawnOperator) return;
 
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorSwitchCommit);
+    const double CommitStart = FPlatformTime::Seconds();
+
     // Global switch lock to avoid double processing
     if (ADirectorGameState* LGS = GetWorld() ? GetWorld()->GetGameState<ADirectorGameState>() : nullptr)
     {
         if (LGS->IsSwitchLocked())
         {
             UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] Attach ignored due to switch lock"), *GetName());
+            LGS->AbandonTransition();
             return;
         }
         LGS->StampSwitch();
@@ -364,6 +607,7 @@ void ACameraRig::Server_AttachToPawn(APawn* PawnOperator)
         if (GS->ActiveCamera == this)
         {
             UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] Already ActiveCamera"), *GetName());
+            GS->AbandonTransition();
             return;
         }
         if (ACameraRig* Old = GS->ActiveCamera)
@@ -371,11 +615,25 @@ void ACameraRig::Server_AttachToPawn(APawn* PawnOperator)
             if (Old != this)
             {
                 Old->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
-                if (Old->SceneCapture) Old->SceneCapture->bCaptureEveryFrame = false;
             }
+        }
+    }
 
-            Old->Multicast_SetCaptureEnabled(false);
+    // The operator puts down whatever rig they carry, live or not: after an auto-director cut the live rig is a
+    // fixed one, and the carried rig would otherwise stay on the pawn with its capture off
+    TArray<ACameraRig*, TInlineAllocator<4>> Carried;
+    PawnOperator->ForEachAttachedActors([this, &Carried](AActor* Attached)
+    {
+        ACameraRig* CarriedRig = Cast<ACameraRig>(Attached);
+        if (CarriedRig && CarriedRig != this)
+        {
+            Carried.Add(CarriedRig);
         }
+        return true;
+    });
+    for (ACameraRig* CarriedRig : Carried)
+    {
+        CarriedRig->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
     }
 
     USceneComponent* AttachTarget = PawnOperator->GetRootComponent();
@@ -386,26 +644,19 @@ void ACameraRig::Server_AttachToPawn(APawn* PawnOperator)
     FVector DesiredRelLoc = AttachRelativeLocation;
     FRotator DesiredRelRot = AttachRelativeRotation;
 
-    // If the pawn is our character class, override from character-configured values
-    if (AThirdPersonCameraManCharacter* TPChar = Cast<AThirdPersonCameraManCharacter>(PawnOperator))
+    // Mount preset for this (pawn class, rig class) pair, resolved once per pair and copied in one go
+    if (const UDirectorRigMountTable* MountTable = UDirectorRigMountTable::Get(this))
     {
-        if (!TPChar->AttachCameraRigSocket.IsNone())
+        if (const FDirectorRigMount* Mount = MountTable->Find(PawnOperator->GetClass(), GetClass()))
         {
-            DesiredSocket = TPChar->AttachCameraRigSocket;
+            if (!Mount->Socket.IsNone())
+            {
+                DesiredSocket = Mount->Socket;
+            }
+            DesiredRelLoc = Mount->AttachRelativeLocation;
+            DesiredRelRot = Mount->AttachRelativeRotation;
+            ApplyMount(*Mount);
         }
-        DesiredRelLoc = TPChar->AttachCameraRigRelativeLocation;
-        DesiredRelRot = TPChar->AttachCameraRigRelativeRotation;
-
-        // Also adopt the per-character desired camera offsets for this rig
-        CameraRelativeLocation = TPChar->RigCameraRelativeLocation;
-        CameraRelativeRotation = TPChar->RigCameraRelativeRotation;
-
-        // And adopt per-character alignment behavior
-        bAlignWithPawnForwardOnAttach = TPChar->bRigAlignWithPawnForwardOnAttach;
-        bZeroRollOnAttach            = TPChar->bRigZeroRollOnAttach;
-        AlignYawOffsetDeg            = TPChar->RigAlignYawOffsetDeg;
-        AlignPitchOffsetDeg          = TPChar->RigAlignPitchOffsetDeg;
-        AlignRollOffsetDeg           = TPChar->RigAlignRollOffsetDeg;
     }
 
     if (ACharacter* Char = Cast<ACharacter>(PawnOperator))
@@ -438,12 +689,52 @@ void ACameraRig::Server_AttachToPawn(APawn* PawnOperator)
     // Reapply offsets now that we've snapped to pawn
     ApplyLocalOffsets();
 
+    Server_GoLive();
+    SET_FLOAT_STAT(STAT_DirectorLastSwitchCommitMs, (FPlatformTime::Seconds() - CommitStart) * 1000.0);
+
+    // Announce pickup to all clients in a friendly format: "player N picked up :  <RigName>"
+    if (GEngine)
+    {
+        int32 PlayerNum = 1;
+        if (const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>())
+        {
+            PlayerNum = FMath::Max(1, GS->GetPlayerNumber(PawnOperator->GetPlayerState()));
+        }
+        GEngine->AddOnScreenDebugMessage(770777, 3.f, FColor::Green, GetPickupToast(PlayerNum));
+    }
+}
+
+// Lens offsets and alignment behaviour from a mount preset (attach placement is applied by the caller)
+void ACameraRig::ApplyMount(const FDirectorRigMount& Mount)
+{
+    CameraRelativeLocation        = Mount.CameraRelativeLocation;
+    CameraRelativeRotation        = Mount.CameraRelativeRotation;
+    bAlignWithPawnForwardOnAttach = Mount.bAlignWithPawnForward;
+    bZeroRollOnAttach             = Mount.bZeroRoll;
+    AlignYawOffsetDeg             = Mount.AlignYawOffsetDeg;
+    AlignPitchOffsetDeg           = Mount.AlignPitchOffsetDeg;
+    AlignRollOffsetDeg            = Mount.AlignRollOffsetDeg;
+}
+
+// Server live slot: shared by pickup/switch (after attaching) and auto-director cuts (rig stays put)
+void ACameraRig::Server_GoLive()
+{
+    if (!HasAuthority()) return;
+
+    ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    if (ACameraRig* Old = GS ? GS->ActiveCamera : nullptr)
+    {
+        if (Old != this)
+        {
+            Old->SetCaptureEnabled(false);
+            Old->Multicast_SetCaptureEnabled(false);
+        }
+    }
+
     if (SceneCapture && RenderTarget)
     {
-        SceneCapture->TextureTarget = RenderTarget;
-        SceneCapture->bCaptureEveryFrame = true;
-        SceneCapture->CaptureScene();
-        UE_LOG(LogDirectorRig, Log, TEXT("[Rig %s] Capture ON RT=%s Size=(%d x %d)"), *GetName(), *GetNameSafe(RenderTarget), RenderTarget->SizeX, RenderTarget->SizeY);
+        SetCaptureEnabled(true);
+        UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] Capture ON RT=%s Size=(%d x %d)"), *GetName(), *GetNameSafe(RenderTarget), RenderTarget->SizeX, RenderTarget->SizeY);
     }
 
     Multicast_SetCaptureEnabled(true);
@@ -451,36 +742,11 @@ void ACameraRig::Server_AttachToPawn(APawn* PawnOperator)
     if (AThirdPersonCameraManGameMode* GM = Cast<AThirdPersonCameraManGameMode>(GetWorld()->GetAuthGameMode()))
     {
         GM->SetActiveCamera(this);
-        UE_LOG(LogDirectorRig, Log, TEXT("[Rig %s] ActiveCamera set by server"), *GetName());
+        UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] ActiveCamera set by server"), *GetName());
     }
-
-    // Announce pickup to all clients in a friendly format: "player N picked up :  <RigName>"
-    if (GEngine)
+    if (GS)
     {
-        int32 PlayerNum = 1;
-        if (APlayerState* PS = PawnOperator->GetPlayerState())
-        {
-            if (AGameStateBase* GS = GetWorld() ? GetWorld()->GetGameState() : nullptr)
-            {
-                TArray<APlayerState*> Sorted = GS->PlayerArray;
-                Sorted.Sort([](const APlayerState& L, const APlayerState& R)
-                {
-                    return L.GetPlayerId() < R.GetPlayerId();
-                });
-                for (int32 i = 0; i < Sorted.Num(); ++i)
-                {
-                    if (Sorted[i] == PS)
-                    {
-                        PlayerNum = i + 1; // 1-based for presentation
-                        break;
-                    }
-                }
-            }
-        }
-
-        const FString RigName = GetRigDisplayName();
-        const FString Msg = FString::Printf(TEXT("player %d picked up :  %s"), PlayerNum, *RigName);
-        GEngine->AddOnScreenDebugMessage(770777, 3.f, FColor::Green, Msg);
+        GS->CommitTransition();
     }
 }
 
@@ -491,12 +757,13 @@ void ACameraRig::Server_SwitchTo(ACameraRig* NewRig)
 
     if (ADirectorGameState* LGS = GetWorld() ? GetWorld()->GetGameState<ADirectorGameState>() : nullptr)
     {
+        // The attach below stamps the lock; stamping here too would make it reject its own switch
         if (LGS->IsSwitchLocked())
         {
             UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] Switch ignored due to lock"), *GetName());
+            LGS->AbandonTransition();
             return;
         }
-        LGS->StampSwitch();
     }
 
     APawn* OperatorPawn = nullptr;
@@ -510,29 +777,115 @@ void ACameraRig::Server_SwitchTo(ACameraRig* NewRig)
     if (!OperatorPawn)
     {
         UE_LOG(LogDirectorRig, Warning, TEXT("[Rig %s] Switch failed: no operator pawn"), *GetName());
+        if (ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>())
+        {
+            GS->AbandonTransition();
+        }
         return;
     }
 
-    if (SceneCapture) SceneCapture->bCaptureEveryFrame = false;
+    SetCaptureEnabled(false);
 
     Multicast_SetCaptureEnabled(false);
 
-    UE_LOG(LogDirectorRig, Log, TEXT("[Rig %s] Server switching operator to %s"), *GetName(), *NewRig->GetName());
+    UE_LOG(LogDirectorRig, Verbose, TEXT("[Rig %s] Server switching operator to %s"), *GetName(), *NewRig->GetName());
     NewRig->Server_AttachToPawn(OperatorPawn);
 }
 
+void ACameraRig::PrewarmCapture(const FDirectorCaptureProfile& Profile)
+{
+    if (!HasAuthority()) return;
+    Multicast_PrewarmCapture(Profile);
+}
+
+void ACameraRig::CancelPrewarm()
+{
+    if (!HasAuthority()) return;
+    const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    if (GS && GS->ActiveCamera == this) return;
+    Multicast_SetCaptureEnabled(false);
+}
+
+void ACameraRig::RestoreCaptureProfile()
+{
+    if (!HasAuthority()) return;
+    Multicast_RestoreCaptureProfile();
+}
+
+void ACameraRig::Multicast_RestoreCaptureProfile_Implementation()
+{
+    if (!SceneCapture || !bCaptureProfileApplied) return;
+
+    bCaptureProfileApplied = false;
+    SceneCapture->FOVAngle = SavedFOVAngle;
+    SceneCapture->MaxViewDistanceOverride = SavedMaxViewDistance;
+}
+
+// Warm RT, streaming and shaders for this view before it goes live, so the cut frame isn't the first capture
+void ACameraRig::Multicast_PrewarmCapture_Implementation(const FDirectorCaptureProfile& Profile)
+{
+    if (!SceneCapture) return;
+
+    // Keep the rig's own values from before the first profile, later ones override the override
+    if (!bCaptureProfileApplied && (Profile.FOVAngle > 0.f || Profile.MaxViewDistance > 0.f))
+    {
+        bCaptureProfileApplied = true;
+        SavedFOVAngle = SceneCapture->FOVAngle;
+        SavedMaxViewDistance = SceneCapture->MaxViewDistanceOverride;
+    }
+    if (Profile.FOVAngle > 0.f)
+    {
+        SceneCapture->FOVAngle = Profile.FOVAngle;
+    }
+    if (Profile.MaxViewDistance > 0.f)
+    {
+        SceneCapture->MaxViewDistanceOverride = Profile.MaxViewDistance;
+    }
+    Multicast_SetCaptureEnabled_Implementation(true);
+}
+
 // CameraRig.cpp
 void ACameraRig::Multicast_SetCaptureEnabled_Implementation(bool bEnable)
 {
-    if (SceneCapture && RenderTarget)
+    if (RenderTarget)
+    {
+        SetCaptureEnabled(bEnable);
+    }
+}
+
+void ACameraRig::SetCaptureEnabled(bool bEnable)
+{
+    if (!SceneCapture) return;
+
+    const bool bWasCapturing = SceneCapture->bCaptureEveryFrame;
+    UDirectorLensCache* LensCache = UDirectorLensCache::Get(this);
+    if (!bEnable)
+    {
+        // Store exposure / focus while the capture's view state still exists
+        if (bWasCapturing && LensCache)
+        {
+            LensCache->NoteCaptureStopping(this);
+        }
+        SceneCapture->bCaptureEveryFrame = false;
+        return;
+    }
+
+    if (!RenderTarget) return;
+    SceneCapture->TextureTarget = RenderTarget;
+    SceneCapture->bCaptureEveryFrame = true;
+    if (!bWasCapturing)
     {
-        SceneCapture->TextureTarget = RenderTarget;
-        SceneCapture->bCaptureEveryFrame = bEnable;
-        if (bEnable)
+        // Full-size RT before the first every-frame capture, then seed its exposure
+        if (UDirectorRigLOD* LOD = UDirectorRigLOD::Get(this))
+        {
+            LOD->NoteCaptureStarting(this);
+        }
+        if (LensCache)
         {
-            SceneCapture->CaptureScene();
+            LensCache->NoteCaptureStarting(this);
         }
     }
+    IssueCapture();
 }
 
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "DirectorPoseHistory.h"
 #include "CameraRig.generated.h"
 
 UENUM(BlueprintType)
@@ -18,12 +19,23 @@ enum class EAssetForwardAxis : uint8
 };
 
 
+// Scene capture overrides a scripted cut applies to its rig (0 = keep the rig's own value)
+USTRUCT(BlueprintType)
+struct FDirectorCaptureProfile
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Capture", meta=(ClampMin=0, ClampMax=170)) float FOVAngle = 0.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Capture", meta=(ClampMin=0)) float MaxViewDistance = 0.f;
+};
+
 class USphereComponent;
 class USceneCaptureComponent2D;
 class UTextureRenderTarget2D;
 class UCameraComponent;
 class USceneComponent;
 class UStaticMesh;
+struct FDirectorRigMount;
 
 UCLASS()
 class THIRDPERSONCAMERAMAN_API ACameraRig : public AActor
@@ -62,6 +74,10 @@ public:
     UFUNCTION(BlueprintPure, Category="Rig")
     FString GetRigDisplayName() const;
 
+    // Fraction of the subject hidden from this lens (0 clear .. 1 hidden), from the occlusion service's last batch; -1 when not measured
+    UFUNCTION(BlueprintPure, Category="Rig")
+    float GetSubjectOcclusion(AActor* Subject) const;
+
     // Let BP read the RT off the rig
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Capture")
 	UTextureRenderTarget2D* RenderTarget;
@@ -127,10 +143,38 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attach", meta=(ClampMin=-180, ClampMax=180))
     float AlignRollOffsetDeg = 0.f;
 
+    // Handheld stabilization while carried: critically-damped spring on the view pose (UDirectorRigStabilizer)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View|Stabilization")
+    bool bStabilizeWhenCarried = true;
+
+    // Smoothing time when the operator stands still, and when moving at the fast speeds below (seconds)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View|Stabilization", meta=(ClampMin=0.001))
+    float StabilizationSmoothTime = 0.12f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View|Stabilization", meta=(ClampMin=0.001))
+    float StabilizationFastSmoothTime = 0.03f;
+
+    // Motion at which the fast smoothing time is reached, so deliberate moves and pans don't lag (cm/s, deg/s)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View|Stabilization", meta=(ClampMin=1))
+    float StabilizationFastLinearSpeed = 600.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View|Stabilization", meta=(ClampMin=1))
+    float StabilizationFastAngularSpeed = 180.f;
+
+    // Interpolate view and capture poses between simulation updates when they arrive slower than we render
+    // (e.g. a 30 Hz server replicating to a 120 Hz viewer). Costs one source interval of latency while active
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View|Interpolation")
+    bool bInterpolateSubTick = true;
+
+    // Sources updating slower than this are treated as stopped / teleporting rather than interpolated (seconds)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View|Interpolation", meta=(ClampMin=0.01))
+    float MaxInterpolationDelay = 0.1f;
+
 
 protected:
 	// Called when the game starts or when spawned
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UFUNCTION()
 	void OnPawnBegin(UPrimitiveComponent* Comp, AActor* Other, UPrimitiveComponent* OtherComp,
@@ -144,7 +188,16 @@ protected:
     UFUNCTION(NetMulticast, Reliable)
     void Multicast_SetCaptureEnabled(bool bEnable);
 
+    UFUNCTION(NetMulticast, Reliable)
+    void Multicast_PrewarmCapture(const FDirectorCaptureProfile& Profile);
+
+    UFUNCTION(NetMulticast, Reliable)
+    void Multicast_RestoreCaptureProfile();
+
 	void Server_AttachToPawn(class APawn* PawnOperator);
+	void ApplyMount(const FDirectorRigMount& Mount);
+	// Take the live slot where the rig stands: old rig's capture off, ours on, ActiveCamera committed
+	void Server_GoLive();
 	bool IsActiveOnServer() const;
 	void Server_SwitchTo(class ACameraRig* NewRig);
 
@@ -162,12 +215,86 @@ public:
 
     // Provide camera data when this actor is a view target
     virtual void CalcCamera(float DeltaTime, struct FMinimalViewInfo& OutResult) override;
+
+    // Simulation view pose from the attachment reference, as of the last game update
+    void ComputeRawViewPose(FVector& OutLocation, FRotator& OutRotation) const;
+
+    // Per frame (from the rig pose pass): record the simulation poses and place the view / capture at render time
+    void UpdateRenderPose(double Now, float DeltaTime);
+
+    // Render-time view pose when UpdateRenderPose ran this frame, simulation pose otherwise
+    void GetViewPose(FVector& OutLocation, FRotator& OutRotation) const;
+
+    bool IsCapturing() const;
+
+    // Every-frame capture on / off on this machine; the lens cache stores and seeds exposure / focus around it
+    void SetCaptureEnabled(bool bEnable);
+
+    // Stabilizer output for this frame; CalcCamera prefers it over the raw pose
+    void SetStabilizedViewPose(const FVector& Location, const FRotator& Rotation);
     UFUNCTION(BlueprintCallable, Category="CameraRig")
     void ReapplyViewAlignment(APawn* ReferencePawn);
 
     UFUNCTION(BlueprintCallable, Category="CameraRig")
     void ApplyLocalOffsets();
 
+    // One-off capture of this rig's view into an external RT (monitor wall tiles); keeps our own RT bound
+    void CaptureInto(UTextureRenderTarget2D* Target);
+
+    // Single choke point for explicit captures so they show up per rig in `stat Director` / Insights
+    void IssueCapture();
+
+    // Server: same paths as the pickup / bump overlaps, for scripted callers (benchmark, tools)
+    void RequestPickup(APawn* PawnOperator);
+    void RequestSwitchTo(ACameraRig* NewRig);
+    // Cut to this rig without moving it (auto-director, cut lists); honours the switch lock unless told otherwise
+    void RequestGoLive(bool bIgnoreSwitchLock = false);
+
+    // Server: apply a capture profile and start capturing everywhere ahead of a scheduled cut, or stop again
+    void PrewarmCapture(const FDirectorCaptureProfile& Profile);
+    void CancelPrewarm();
+    // Server: put back the FOV / view distance a capture profile overrode (cut list end)
+    void RestoreCaptureProfile();
+
+    // Interned toast text, formatted once per label (and per player number) so cuts don't build strings.
+    // The director side of a cut is allocation-free once warm (DirectorCutAllocationTest); the engine's on-screen
+    // message list still copies the text, which director.Bench counts in allocs_per_cut
+    const FString& GetPickupToast(int32 PlayerNum) const;
+    const FString& GetSwitchedToast() const;
+    const FString& GetDroppedToast() const;
+
+private:
+    // Rebuilds the interned strings when RigLabel changed since they were formatted
+    void RefreshCachedStrings() const;
+
+    mutable FName CachedLabel;
+    mutable bool bCachedStringsValid = false;
+    mutable FString CachedSwitchedToast;
+    mutable FString CachedDroppedToast;
+    mutable TArray<FString, TInlineAllocator<4>> CachedPickupToasts;   // [PlayerNum - 1]
+
+    // The rig's own capture settings while a profile overrides them, per machine
+    bool bCaptureProfileApplied = false;
+    float SavedFOVAngle = 0.f;
+    float SavedMaxViewDistance = 0.f;
+
+    // Simulation pose samples and where they put the view this frame
+    FDirectorPoseHistory ViewHistory;
+    FDirectorPoseHistory CaptureHistory;
+    FVector RenderViewLocation = FVector::ZeroVector;
+    FRotator RenderViewRotation = FRotator::ZeroRotator;
+    uint64 RenderViewFrame = MAX_uint64;
+    bool bCaptureInterpolated = false;
+
+    FVector StabilizedViewLocation = FVector::ZeroVector;
+    FRotator StabilizedViewRotation = FRotator::ZeroRotator;
+    uint64 StabilizedViewFrame = MAX_uint64;
+
+#if STATS
+    // Per-rig dynamic stat ("Capture <RigLabel>") for game-thread capture issue cost
+    TStatId CaptureStatId;
+#endif
+
     
 
     
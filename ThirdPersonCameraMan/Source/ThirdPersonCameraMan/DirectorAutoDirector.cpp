@@ -0,0 +1,266 @@
+#include "DirectorAutoDirector.h"
+
+#include "CameraRig.h"
+#include "DirectorCutList.h"
+#include "DirectorGameState.h"
+#include "DirectorOcclusionService.h"
+#include "DirectorRigLOD.h"
+#include "DirectorRigRegistry.h"
+#include "DirectorStats.h"
+#include "ThirdPersonCameraManGameMode.h"
+#include "Async/ParallelFor.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorAuto, Log, All);
+
+// Rigs per ParallelFor task; small enough to spread a few hundred rigs, large enough to amortise dispatch
+static constexpr int32 ScoreBatchSize = 64;
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorAutoCommand(
+    TEXT("director.Auto"),
+    TEXT("Auto-director (server). Args: 1 | 0 | scores"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDirectorAutoDirector* Auto = UDirectorAutoDirector::Get(World);
+        if (!Auto) return;
+
+        if (Args.Num() > 0 && Args[0] == TEXT("scores"))
+        {
+            Auto->PrintScores();
+        }
+        else
+        {
+            Auto->SetEnabled(Args.Num() > 0 ? Args[0].ToBool() : !Auto->IsEnabled());
+        }
+    }));
+
+UDirectorAutoDirector* UDirectorAutoDirector::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorAutoDirector>() : nullptr;
+}
+
+void UDirectorAutoDirector::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<UDirectorRigRegistry>();
+    Collection.InitializeDependency<UDirectorOcclusionService>();
+    Super::Initialize(Collection);
+}
+
+TStatId UDirectorAutoDirector::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDirectorAutoDirector, STATGROUP_Tickables);
+}
+
+void UDirectorAutoDirector::SetEnabled(bool bEnable)
+{
+    bEnabledFromGameMode = true;   // an explicit toggle wins over the GameMode default
+    if (bEnabled == bEnable) return;
+    bEnabled = bEnable;
+    UE_LOG(LogDirectorAuto, Log, TEXT("Auto-director %s"), bEnabled ? TEXT("ON") : TEXT("OFF"));
+}
+
+float UDirectorAutoDirector::GetScore(const ACameraRig* Rig) const
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    const int32 Index = (Registry && Registry->GetGeneration() == RegistryGeneration) ? Registry->IndexOf(Rig) : INDEX_NONE;
+    return Scores.IsValidIndex(Index) ? Scores[Index] : 0.f;
+}
+
+void UDirectorAutoDirector::PrintScores() const
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Registry || Registry->GetGeneration() != RegistryGeneration) return;
+
+    const TArray<ACameraRig*>& Rigs = Registry->GetRigs();
+    UE_LOG(LogDirectorAuto, Display, TEXT("Auto-director scores (%d rigs, %s):"), Rigs.Num(), bEnabled ? TEXT("on") : TEXT("off"));
+    for (int32 i = 0; i < Rigs.Num() && i < Scores.Num(); ++i)
+    {
+        UE_LOG(LogDirectorAuto, Display, TEXT("  %-24s score=%.3f vis=%.2f%s"), *GetNameSafe(Rigs[i]), Scores[i], Visibility[i],
+            Poses.bCarried[i] ? TEXT(" (carried)") : TEXT(""));
+    }
+}
+
+void UDirectorAutoDirector::FRigPoses::SetNum(int32 Num)
+{
+    PosX.SetNumUninitialized(Num); PosY.SetNumUninitialized(Num); PosZ.SetNumUninitialized(Num);
+    FwdX.SetNumUninitialized(Num); FwdY.SetNumUninitialized(Num); FwdZ.SetNumUninitialized(Num);
+    CosHalfFov.SetNumUninitialized(Num);
+    bEligible.SetNumUninitialized(Num);
+    bCarried.SetNumUninitialized(Num);
+}
+
+// Registry indices moved: resize the per-rig arrays
+void UDirectorAutoDirector::SyncWithRegistry()
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Registry || Registry->GetGeneration() == RegistryGeneration) return;
+
+    RegistryGeneration = Registry->GetGeneration();
+    const int32 Num = Registry->GetRigs().Num();
+    Poses.SetNum(Num);
+    Visibility.Init(0.f, Num);
+    Scores.Init(0.f, Num);
+}
+
+void UDirectorAutoDirector::Tick(float DeltaTime)
+{
+    UWorld* World = GetWorld();
+    if (!World || World->GetNetMode() == NM_Client) return;
+
+    const AThirdPersonCameraManGameMode* GM = World->GetAuthGameMode<AThirdPersonCameraManGameMode>();
+    if (!GM) return;
+    if (!bEnabledFromGameMode)
+    {
+        bEnabled = GM->bAutoDirector;
+        bEnabledFromGameMode = true;
+    }
+    if (!bEnabled || UDirectorCutListPlayer::IsPlaying(this)) return;
+
+    const APlayerController* Operator = GM->GetOperatorPC();
+    const APawn* Subject = Operator ? Operator->GetPawn() : nullptr;
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Subject || !Registry) return;
+
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorAutoDirector);
+
+    SyncWithRegistry();
+    const TArray<ACameraRig*>& Rigs = Registry->GetRigs();
+    if (Rigs.Num() == 0) return;
+
+    const FDirectorAutoDirectorSettings& Settings = GM->AutoDirectorSettings;
+    const FVector SubjectAim = Subject->GetActorLocation() + FVector(0.f, 0.f, Settings.SubjectAimHeight);
+
+    GatherPoses(Rigs, Subject);
+    GatherVisibility(Subject);
+    ScorePoses(SubjectAim, Settings);
+    ConsiderCut(Rigs, Settings);
+}
+
+void UDirectorAutoDirector::GatherPoses(const TArray<ACameraRig*>& Rigs, const APawn* Subject)
+{
+    const UDirectorRigLOD* LOD = UDirectorRigLOD::Get(this);
+    for (int32 i = 0; i < Rigs.Num(); ++i)
+    {
+        const ACameraRig* Rig = Rigs[i];
+        const USceneComponent* Lens = Rig ? Rig->SceneCapture : nullptr;
+        if (!Lens || (LOD && LOD->IsDormantAt(i)))
+        {
+            Poses.bEligible[i] = 0;
+            Poses.bCarried[i] = 0;
+            continue;
+        }
+
+        const FVector Pos = Lens->GetComponentLocation();
+        const FVector Fwd = Lens->GetForwardVector();
+        Poses.PosX[i] = Pos.X; Poses.PosY[i] = Pos.Y; Poses.PosZ[i] = Pos.Z;
+        Poses.FwdX[i] = Fwd.X; Poses.FwdY[i] = Fwd.Y; Poses.FwdZ[i] = Fwd.Z;
+        Poses.CosHalfFov[i] = FMath::Cos(FMath::DegreesToRadians(Rig->SceneCapture->FOVAngle * 0.5f));
+        Poses.bEligible[i] = 1;
+        Poses.bCarried[i] = Rig->GetAttachParentActor() == Subject ? 1 : 0;
+    }
+}
+
+// Last published occlusion batch; rigs the service hasn't measured yet (or a layout it hasn't caught up with) count as hidden
+void UDirectorAutoDirector::GatherVisibility(const APawn* Subject)
+{
+    const UDirectorOcclusionService* Occlusion = UDirectorOcclusionService::Get(this);
+    const int32 SubjectIndex = Occlusion ? Occlusion->GetSubjectIndex(Subject) : INDEX_NONE;
+    if (SubjectIndex == INDEX_NONE || Occlusion->GetRegistryGeneration() != RegistryGeneration)
+    {
+        Visibility.Init(0.f, Scores.Num());
+        return;
+    }
+
+    for (int32 i = 0; i < Visibility.Num(); ++i)
+    {
+        const float Occluded = Occlusion->GetOcclusionAt(i, SubjectIndex);
+        Visibility[i] = Occluded < 0.f ? 0.f : 1.f - Occluded;
+    }
+}
+
+// Pure function of the SoA arrays; each task scores a contiguous batch of rigs
+void UDirectorAutoDirector::ScorePoses(const FVector& SubjectAim, const FDirectorAutoDirectorSettings& Settings)
+{
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorAutoScore);
+
+    const int32 Num = Scores.Num();
+    const int32 NumBatches = FMath::DivideAndRoundUp(Num, ScoreBatchSize);
+    SET_DWORD_STAT(STAT_DirectorAutoRigs, Num);
+
+    const float SX = SubjectAim.X, SY = SubjectAim.Y, SZ = SubjectAim.Z;
+    const float FramingWeight = Settings.FramingWeight;
+    const float DistanceWeight = Settings.DistanceWeight;
+    const float PreferredDistance = Settings.PreferredDistance;
+    const float InvFalloff = 1.f / FMath::Max(1.f, Settings.DistanceFalloff);
+    const float CarriedShotScore = Settings.CarriedShotScore;
+
+    ParallelFor(NumBatches, [&](int32 Batch)
+    {
+        const int32 Begin = Batch * ScoreBatchSize;
+        const int32 End = FMath::Min(Begin + ScoreBatchSize, Num);
+        for (int32 i = Begin; i < End; ++i)
+        {
+            const float DX = SX - Poses.PosX[i];
+            const float DY = SY - Poses.PosY[i];
+            const float DZ = SZ - Poses.PosZ[i];
+            const float Dist = FMath::Sqrt(DX * DX + DY * DY + DZ * DZ);
+            const float InvDist = Dist > KINDA_SMALL_NUMBER ? 1.f / Dist : 0.f;
+
+            // Framing: 1 with the subject dead centre, 0 at the edge of the frame or outside it
+            const float Facing = (Poses.FwdX[i] * DX + Poses.FwdY[i] * DY + Poses.FwdZ[i] * DZ) * InvDist;
+            const float CosHalf = Poses.CosHalfFov[i];
+            const float Framing = FMath::Max(0.f, (Facing - CosHalf) / FMath::Max(1.f - CosHalf, KINDA_SMALL_NUMBER));
+
+            const float DistanceScore = 1.f - FMath::Min(1.f, FMath::Abs(Dist - PreferredDistance) * InvFalloff);
+
+            const float Score = Visibility[i] * (FramingWeight * Framing + DistanceWeight * DistanceScore);
+            Scores[i] = !Poses.bEligible[i] ? 0.f
+                : Poses.bCarried[i] ? CarriedShotScore
+                : (Framing > 0.f ? Score : 0.f);
+        }
+    }, NumBatches < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void UDirectorAutoDirector::ConsiderCut(const TArray<ACameraRig*>& Rigs, const FDirectorAutoDirectorSettings& Settings)
+{
+    const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    if (!GS || GS->IsSwitchLocked()) return;
+
+    // Shot age from the last committed cut, whoever made it (operator pickups reset it too)
+    const double ShotAge = GS->LastTransition.Id > 0
+        ? GS->GetServerWorldTimeSeconds() - GS->LastTransition.CommitServerTime
+        : TNumericLimits<float>::Max();
+    const int32 LiveIndex = GS->ActiveCamera ? Rigs.IndexOfByKey(GS->ActiveCamera) : INDEX_NONE;
+    if (LiveIndex != INDEX_NONE && ShotAge < Settings.MinShotSeconds) return;
+
+    int32 BestIndex = INDEX_NONE;
+    float BestScore = 0.f;
+    for (int32 i = 0; i < Scores.Num(); ++i)
+    {
+        if (Scores[i] > BestScore)
+        {
+            BestScore = Scores[i];
+            BestIndex = i;
+        }
+    }
+    if (BestIndex == INDEX_NONE || BestIndex == LiveIndex) return;
+
+    float LiveScore = Scores.IsValidIndex(LiveIndex) ? Scores[LiveIndex] : 0.f;
+    if (ShotAge > Settings.MaxShotSeconds)
+    {
+        LiveScore -= Settings.StaleShotPenalty;
+    }
+    if (LiveIndex != INDEX_NONE && BestScore < LiveScore + Settings.SwitchMargin) return;
+
+    if (ACameraRig* Best = Rigs[BestIndex])
+    {
+        UE_LOG(LogDirectorAuto, Verbose, TEXT("Cut to %s (score %.3f, live %.3f, shot %.1fs)"), *Best->GetName(), BestScore, LiveScore, ShotAge);
+        Best->RequestGoLive();
+    }
+}
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DirectorAutoDirector.generated.h"
+
+class ACameraRig;
+class APawn;
+
+// Shot scoring and pacing for the auto-director (set on the GameMode)
+USTRUCT(BlueprintType)
+struct FDirectorAutoDirectorSettings
+{
+    GENERATED_BODY()
+
+    // Score = visibility * (FramingWeight * framing + DistanceWeight * distance)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=0)) float FramingWeight = 1.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=0)) float DistanceWeight = 0.6f;
+
+    // Subject distance a shot is best at, and how far off it can be before the distance term reaches 0 (cm)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=0)) float PreferredDistance = 800.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=1)) float DistanceFalloff = 1200.f;
+
+    // Shot duration: a shot is held at least MinShotSeconds; past MaxShotSeconds it loses StaleShotPenalty
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=0)) float MinShotSeconds = 3.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=0)) float MaxShotSeconds = 12.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=0)) float StaleShotPenalty = 0.3f;
+
+    // A candidate has to beat the live shot by this much before we cut
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=0)) float SwitchMargin = 0.15f;
+
+    // Flat score of the rig the operator carries (it films from the subject, so framing doesn't apply):
+    // fixed shots have to beat it to take over, and the shot goes back to it when they can't
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector", meta=(ClampMin=0)) float CarriedShotScore = 0.8f;
+
+    // Aim point above the subject's origin (cm)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector") float SubjectAimHeight = 60.f;
+};
+
+/**
+ * Server-side auto-director: scores every registered rig against the operator pawn each tick and cuts to the
+ * best one through ACameraRig::RequestGoLive (same live-slot path as pickups and bumps).
+ * Poses are gathered into SoA arrays and scored with a ParallelFor; visibility is 1 - the occlusion ratio
+ * published by UDirectorOcclusionService, so the game thread never blocks on a trace.
+ * `director.Auto 1|0` toggles it, `director.Auto scores` prints the latest scores.
+ */
+UCLASS()
+class UDirectorAutoDirector : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorAutoDirector* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void SetEnabled(bool bEnable);
+    bool IsEnabled() const { return bEnabled; }
+
+    // Latest score for a rig (0 when unknown / ineligible)
+    float GetScore(const ACameraRig* Rig) const;
+    void PrintScores() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+    {
+        return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+    }
+
+private:
+    // Camera poses in structure-of-arrays form so the scoring pass streams through memory
+    struct FRigPoses
+    {
+        TArray<float> PosX, PosY, PosZ;
+        TArray<float> FwdX, FwdY, FwdZ;
+        TArray<float> CosHalfFov;
+        TArray<uint8> bEligible;   // 0 for dormant rigs and rigs without a lens
+        TArray<uint8> bCarried;    // 1 for rigs carried by the subject (they film from its head)
+
+        void SetNum(int32 Num);
+    };
+
+    void SyncWithRegistry();
+    void GatherPoses(const TArray<ACameraRig*>& Rigs, const APawn* Subject);
+    void GatherVisibility(const APawn* Subject);
+    void ScorePoses(const FVector& SubjectAim, const FDirectorAutoDirectorSettings& Settings);
+    void ConsiderCut(const TArray<ACameraRig*>& Rigs, const FDirectorAutoDirectorSettings& Settings);
+
+    bool bEnabled = false;
+    bool bEnabledFromGameMode = false;
+
+    FRigPoses Poses;
+    TArray<float> Visibility;   // 1 = clear view of the subject, 0 = fully occluded or not measured yet
+    TArray<float> Scores;
+
+    uint32 RegistryGeneration = MAX_uint32;
+};
@@ -0,0 +1,539 @@
+#include "DirectorBenchmark.h"
+
+#include "CameraRig.h"
+#include "DirectorGameState.h"
+#include "DirectorViewerProfile.h"
+#include "ThirdPersonCameraMan.h"
+#include "ThirdPersonCameraManGameMode.h"
+#include "CoreGlobals.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorBench, Log, All);
+
+using ThirdPersonCameraMan::NearestRankPercentile;
+
+namespace
+{
+    // Forwards everything to the real allocator and counts allocation calls (all threads).
+    // Installed over GMalloc at module startup with -DirectorBenchAllocs and never removed,
+    // since blocks allocated through it may be freed at any later point.
+    class FDirectorAllocCounter final : public FMalloc
+    {
+    public:
+        explicit FDirectorAllocCounter(FMalloc* InInner) : Inner(InInner) {}
+
+        uint64 GetCount() const { return Count.load(std::memory_order_relaxed); }
+
+        // Calls made from the calling thread only; lets the game thread measure a code path exactly
+        static uint64 GetThreadCount() { return ThreadCount; }
+
+        virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+        {
+            Count.fetch_add(1, std::memory_order_relaxed);
+            ++ThreadCount;
+            return Inner->Malloc(Size, Alignment);
+        }
+        virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+        {
+            Count.fetch_add(1, std::memory_order_relaxed);
+            ++ThreadCount;
+            return Inner->TryMalloc(Size, Alignment);
+        }
+        virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+        {
+            Count.fetch_add(1, std::memory_order_relaxed);
+            ++ThreadCount;
+            return Inner->Realloc(Original, Size, Alignment);
+        }
+        virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+        {
+            Count.fetch_add(1, std::memory_order_relaxed);
+            ++ThreadCount;
+            return Inner->TryRealloc(Original, Size, Alignment);
+        }
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+
+        virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+        virtual void OnMallocInitialized() override { Inner->OnMallocInitialized(); }
+        virtual void OnPreFork() override { Inner->OnPreFork(); }
+        virtual void OnPostFork() override { Inner->OnPostFork(); }
+
+    private:
+        FMalloc* Inner;
+        std::atomic<uint64> Count{0};
+        static thread_local uint64 ThreadCount;
+    };
+
+    thread_local uint64 FDirectorAllocCounter::ThreadCount = 0;
+
+    FDirectorAllocCounter* GDirectorAllocCounter = nullptr;
+}
+
+void DirectorAllocCounter::InstallIfRequested()
+{
+    check(IsInGameThread());
+    if (!GDirectorAllocCounter && GMalloc && FParse::Param(FCommandLine::Get(), TEXT("DirectorBenchAllocs")))
+    {
+        GDirectorAllocCounter = new FDirectorAllocCounter(GMalloc);
+        GMalloc = GDirectorAllocCounter;
+        UE_LOG(LogDirectorBench, Display, TEXT("Allocation counter installed over %s"), GDirectorAllocCounter->GetDescriptiveName());
+    }
+}
+
+bool DirectorAllocCounter::IsInstalled()
+{
+    return GDirectorAllocCounter != nullptr;
+}
+
+uint64 DirectorAllocCounter::GetCount()
+{
+    return GDirectorAllocCounter ? GDirectorAllocCounter->GetCount() : 0;
+}
+
+uint64 DirectorAllocCounter::GetThreadCount()
+{
+    return FDirectorAllocCounter::GetThreadCount();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorBenchCommand(
+    TEXT("director.Bench"),
+    TEXT("Scripted pickup/switch/drop benchmark (server). Args: [rigs=N] [enemies=N] [viewers=N] [cycles=N] [baseline] | stop"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDirectorBenchmark* Bench = UDirectorBenchmark::Get(World);
+        if (!Bench) return;
+
+        if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+        {
+            Bench->Stop();
+            return;
+        }
+
+        const UDirectorBenchmarkSettings* Settings = GetDefault<UDirectorBenchmarkSettings>();
+        UDirectorBenchmark::FParams Params;
+        Params.Rigs = Settings->Rigs;
+        Params.Enemies = Settings->Enemies;
+        Params.Viewers = Settings->Viewers;
+        Params.Cycles = Settings->Cycles;
+        for (const FString& Arg : Args)
+        {
+            FParse::Value(*Arg, TEXT("rigs="), Params.Rigs);
+            FParse::Value(*Arg, TEXT("enemies="), Params.Enemies);
+            FParse::Value(*Arg, TEXT("viewers="), Params.Viewers);
+            FParse::Value(*Arg, TEXT("cycles="), Params.Cycles);
+            Params.bWriteBaseline |= (Arg == TEXT("baseline"));
+        }
+        Bench->Start(Params);
+    }));
+
+UDirectorBenchmark* UDirectorBenchmark::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorBenchmark>() : nullptr;
+}
+
+void UDirectorBenchmark::Deinitialize()
+{
+    Stop();
+    Super::Deinitialize();
+}
+
+TStatId UDirectorBenchmark::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDirectorBenchmark, STATGROUP_Tickables);
+}
+
+bool UDirectorBenchmark::Start(const FParams& InParams)
+{
+    UWorld* World = GetWorld();
+    if (IsRunning())
+    {
+        UE_LOG(LogDirectorBench, Warning, TEXT("Benchmark already running; `director.Bench stop` first"));
+        return false;
+    }
+    if (!World || World->GetNetMode() == NM_Client)
+    {
+        UE_LOG(LogDirectorBench, Error, TEXT("Benchmark must run on the server / listen host"));
+        return false;
+    }
+
+    APawn* OperatorPawn = GetOperatorPawn();
+    if (!OperatorPawn)
+    {
+        UE_LOG(LogDirectorBench, Error, TEXT("Benchmark needs an operator pawn (listen server with a local player)"));
+        return false;
+    }
+
+    // Start from a clean slate: nothing live, nothing carried over from earlier cuts
+    if (AThirdPersonCameraManGameMode* GM = World->GetAuthGameMode<AThirdPersonCameraManGameMode>())
+    {
+        GM->DropActiveCamera();
+    }
+
+    Params = InParams;
+    Params.Rigs = FMath::Max(2, Params.Rigs);
+    Params.Cycles = FMath::Max(1, Params.Cycles);
+
+    SpawnScenario(OperatorPawn);
+
+    if (!DirectorAllocCounter::IsInstalled())
+    {
+        UE_LOG(LogDirectorBench, Display, TEXT("Allocations aren't counted; start the process with -DirectorBenchAllocs to gate them"));
+    }
+    Phase = EPhase::WaitingForViewers;
+    PhaseStartTime = World->GetTimeSeconds();
+    const UDirectorViewerProfileSubsystem* ViewerProfile = UDirectorViewerProfileSubsystem::Get(this);
+    UE_LOG(LogDirectorBench, Display, TEXT("Benchmark: %d rigs, %d enemies, %d viewers, %d cycles, viewer profile %s"),
+        Params.Rigs, Enemies.Num(), Params.Viewers, Params.Cycles,
+        ViewerProfile ? *ViewerProfile->GetProfile().Name.ToString() : TEXT("-"));
+    return true;
+}
+
+void UDirectorBenchmark::Stop()
+{
+    if (!IsRunning()) return;
+    DespawnScenario();
+    Phase = EPhase::Idle;
+    UE_LOG(LogDirectorBench, Display, TEXT("Benchmark stopped"));
+}
+
+APawn* UDirectorBenchmark::GetOperatorPawn() const
+{
+    const AThirdPersonCameraManGameMode* GM = GetWorld() ? GetWorld()->GetAuthGameMode<AThirdPersonCameraManGameMode>() : nullptr;
+    const APlayerController* Operator = GM ? GM->GetOperatorPC() : nullptr;
+    return Operator ? Operator->GetPawn() : nullptr;
+}
+
+int32 UDirectorBenchmark::GetViewerCount() const
+{
+    const AGameModeBase* GM = GetWorld() ? GetWorld()->GetAuthGameMode() : nullptr;
+    return GM ? FMath::Max(0, GM->GetNumPlayers() - 1) : 0;
+}
+
+// Generated layout: rigs on a ring around the operator, far enough apart that their triggers never touch
+void UDirectorBenchmark::SpawnScenario(APawn* OperatorPawn)
+{
+    UWorld* World = GetWorld();
+    const UDirectorBenchmarkSettings* Settings = GetDefault<UDirectorBenchmarkSettings>();
+
+    UClass* RigClass = Settings->RigClass.IsNull() ? ACameraRig::StaticClass() : Settings->RigClass.LoadSynchronous();
+    if (!RigClass)
+    {
+        UE_LOG(LogDirectorBench, Warning, TEXT("RigClass %s failed to load; using the native rig"), *Settings->RigClass.ToString());
+        RigClass = ACameraRig::StaticClass();
+    }
+
+    const FVector Center = OperatorPawn->GetActorLocation();
+    const float Radius = FMath::Max(1500.f, Params.Rigs * 400.f / UE_TWO_PI);
+
+    for (int32 i = 0; i < Params.Rigs; ++i)
+    {
+        const float Angle = UE_TWO_PI * i / Params.Rigs;
+        const FVector Location = Center + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * Radius;
+        const FTransform Home((Center - Location).Rotation(), Location);
+
+        // Deferred so the label is set before BeginPlay names the per-rig stat
+        ACameraRig* Rig = World->SpawnActorDeferred<ACameraRig>(RigClass, Home, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        if (!Rig) continue;
+        Rig->RigLabel = FName(*FString::Printf(TEXT("Bench %02d"), i));
+        Rig->FinishSpawning(Home);
+
+        Rigs.Add(Rig);
+        RigHomes.Add(Home);
+    }
+
+    if (Params.Enemies > 0)
+    {
+        UClass* EnemyClass = Settings->EnemyClass.LoadSynchronous();
+        if (!EnemyClass)
+        {
+            UE_LOG(LogDirectorBench, Warning, TEXT("No EnemyClass configured; running without enemies"));
+            return;
+        }
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+        for (int32 i = 0; i < Params.Enemies; ++i)
+        {
+            const float Angle = UE_TWO_PI * (i + 0.5f) / Params.Enemies;
+            const FVector Location = Center + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * Radius * 0.5f;
+            if (APawn* Enemy = World->SpawnActor<APawn>(EnemyClass, Location, (Center - Location).Rotation(), SpawnParams))
+            {
+                if (!Enemy->GetController())
+                {
+                    Enemy->SpawnDefaultController();
+                }
+                Enemies.Add(Enemy);
+            }
+        }
+    }
+}
+
+void UDirectorBenchmark::DespawnScenario()
+{
+    UWorld* World = GetWorld();
+    const ADirectorGameState* GS = World ? World->GetGameState<ADirectorGameState>() : nullptr;
+    if (GS && Rigs.Contains(GS->ActiveCamera))
+    {
+        if (AThirdPersonCameraManGameMode* GM = World->GetAuthGameMode<AThirdPersonCameraManGameMode>())
+        {
+            GM->DropActiveCamera();
+        }
+    }
+
+    for (ACameraRig* Rig : Rigs)
+    {
+        if (IsValid(Rig)) Rig->Destroy();
+    }
+    for (AActor* Enemy : Enemies)
+    {
+        if (IsValid(Enemy)) Enemy->Destroy();
+    }
+    Rigs.Reset();
+    RigHomes.Reset();
+    Enemies.Reset();
+}
+
+// Dropped / switched-away rigs go back to their slot so they can't bump into the next pickup
+void UDirectorBenchmark::SendHome(ACameraRig* Rig) const
+{
+    const int32 Index = Rigs.IndexOfByKey(Rig);
+    if (Index != INDEX_NONE && RigHomes.IsValidIndex(Index))
+    {
+        Rig->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+        Rig->SetActorTransform(RigHomes[Index], false, nullptr, ETeleportType::TeleportPhysics);
+    }
+}
+
+void UDirectorBenchmark::Tick(float DeltaTime)
+{
+    if (Phase == EPhase::Idle) return;
+
+    const UWorld* World = GetWorld();
+    const double Now = World->GetTimeSeconds();
+    const UDirectorBenchmarkSettings* Settings = GetDefault<UDirectorBenchmarkSettings>();
+
+    switch (Phase)
+    {
+    case EPhase::WaitingForViewers:
+        if (GetViewerCount() >= Params.Viewers || Now - PhaseStartTime > Settings->ViewerWaitSeconds)
+        {
+            if (GetViewerCount() < Params.Viewers)
+            {
+                UE_LOG(LogDirectorBench, Warning, TEXT("Only %d of %d viewers connected; continuing"), GetViewerCount(), Params.Viewers);
+            }
+            Phase = EPhase::Warmup;
+            PhaseStartTime = Now;
+        }
+        break;
+
+    case EPhase::Warmup:
+        if (Now - PhaseStartTime >= Settings->WarmupSeconds)
+        {
+            const ADirectorGameState* GS = World->GetGameState<ADirectorGameState>();
+            FrameMs.Reset();
+            GameThreadMs.Reset();
+            AllocsPerFrame.Reset();
+            LastFrameTime = FPlatformTime::Seconds();
+            LastAllocCount = DirectorAllocCounter::GetCount();
+            RepBytesAtStart = GS ? GS->GetEstimatedRepBytesTotal() : 0;
+            Cuts = 0;
+            StepAllocs = 0;
+            StepIndex = 0;
+            NextStepTime = Now;
+            Phase = EPhase::Running;
+        }
+        break;
+
+    case EPhase::Running:
+        SampleFrame();
+        if (Now >= NextStepTime)
+        {
+            if (StepIndex >= Params.Cycles * 3)
+            {
+                Finish();
+                return;
+            }
+            RunStep();
+            ++StepIndex;
+            NextStepTime = Now + Settings->StepIntervalSeconds;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void UDirectorBenchmark::SampleFrame()
+{
+    const double FrameNow = FPlatformTime::Seconds();
+    FrameMs.Add(static_cast<float>((FrameNow - LastFrameTime) * 1000.0));
+    LastFrameTime = FrameNow;
+
+    // Previous frame's game thread time, as `stat unit` reports it
+    GameThreadMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+
+    if (DirectorAllocCounter::IsInstalled())
+    {
+        const uint64 Count = DirectorAllocCounter::GetCount();
+        AllocsPerFrame.Add(static_cast<float>(Count - LastAllocCount));
+        LastAllocCount = Count;
+    }
+}
+
+// One cycle = pickup rig A, switch A -> B, drop B
+void UDirectorBenchmark::RunStep()
+{
+    UWorld* World = GetWorld();
+    ADirectorGameState* GS = World->GetGameState<ADirectorGameState>();
+    AThirdPersonCameraManGameMode* GM = World->GetAuthGameMode<AThirdPersonCameraManGameMode>();
+    APawn* OperatorPawn = GetOperatorPawn();
+    if (!GS || !GM || !OperatorPawn || Rigs.Num() < 2) return;
+
+    // Game-thread allocations made by the step itself (pickup / switch / drop, engine work included)
+    const uint64 AllocsBefore = DirectorAllocCounter::GetThreadCount();
+    ON_SCOPE_EXIT
+    {
+        StepAllocs += DirectorAllocCounter::GetThreadCount() - AllocsBefore;
+    };
+
+    const int32 Cycle = StepIndex / 3;
+    ACameraRig* RigA = Rigs[Cycle % Rigs.Num()];
+    ACameraRig* RigB = Rigs[(Cycle + 1) % Rigs.Num()];
+
+    switch (StepIndex % 3)
+    {
+    case 0:
+        RigA->RequestPickup(OperatorPawn);
+        Cuts += (GS->ActiveCamera == RigA) ? 1 : 0;
+        break;
+    case 1:
+        RigA->RequestSwitchTo(RigB);
+        if (GS->ActiveCamera == RigB)
+        {
+            ++Cuts;
+            SendHome(RigA);
+        }
+        break;
+    default:
+        if (ACameraRig* Dropped = GS->ActiveCamera)
+        {
+            GM->DropActiveCamera();
+            SendHome(Dropped);
+        }
+        break;
+    }
+}
+
+void UDirectorBenchmark::Finish()
+{
+    const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    UDirectorBenchmarkSettings* Settings = GetMutableDefault<UDirectorBenchmarkSettings>();
+
+    TArray<float> SortedFrame = FrameMs;
+    TArray<float> SortedGameThread = GameThreadMs;
+    SortedFrame.Sort();
+    SortedGameThread.Sort();
+
+    float AllocMean = -1.f;
+    if (AllocsPerFrame.Num() > 0)
+    {
+        double Sum = 0.0;
+        for (float A : AllocsPerFrame) Sum += A;
+        AllocMean = static_cast<float>(Sum / AllocsPerFrame.Num());
+    }
+
+    const float AllocsPerCut = (DirectorAllocCounter::IsInstalled() && Cuts > 0) ? static_cast<float>(StepAllocs) / Cuts : -1.f;
+
+    const uint64 RepBytes = GS ? GS->GetEstimatedRepBytesTotal() - RepBytesAtStart : 0;
+    const float RepBytesPerCut = Cuts > 0 ? static_cast<float>(RepBytes) / Cuts : 0.f;
+
+    // Allocation metrics are only measured when the counter was installed; -1 otherwise
+    const FMetric Metrics[] =
+    {
+        { TEXT("frame_ms_p95"),         NearestRankPercentile(SortedFrame, 0.95f),      Settings->BaselineFrameMsP95,      Settings->FrameTimeTolerancePct },
+        { TEXT("gamethread_ms_p95"),    NearestRankPercentile(SortedGameThread, 0.95f), Settings->BaselineGameThreadMsP95, Settings->FrameTimeTolerancePct },
+        { TEXT("allocs_per_frame"),     AllocMean,                                      Settings->BaselineAllocsPerFrame,  Settings->AllocTolerancePct },
+        { TEXT("allocs_per_cut"),       AllocsPerCut,                                   Settings->BaselineAllocsPerCut,    Settings->AllocTolerancePct },
+        { TEXT("rep_bytes_per_cut"),    RepBytesPerCut,                                 Settings->BaselineRepBytesPerCut,  Settings->RepBytesTolerancePct },
+    };
+
+    const int32 ExpectedCuts = Params.Cycles * 2;
+    bool bRegressed = (Cuts != ExpectedCuts);
+    int32 NumUngated = 0;
+
+    UE_LOG(LogDirectorBench, Display, TEXT("Benchmark results (%d frames, %d/%d cuts, frame p50=%.2f ms, game thread p50=%.2f ms):"),
+        FrameMs.Num(), Cuts, ExpectedCuts, NearestRankPercentile(SortedFrame, 0.5f), NearestRankPercentile(SortedGameThread, 0.5f));
+
+    FString Csv = TEXT("metric,value,baseline,limit,result");
+    Csv += LINE_TERMINATOR;
+    for (const FMetric& M : Metrics)
+    {
+        const TCHAR* Result = !M.IsGated() ? TEXT("ungated") : M.Regressed() ? TEXT("regression") : TEXT("ok");
+        bRegressed |= M.Regressed();
+        NumUngated += M.IsGated() ? 0 : 1;
+        UE_LOG(LogDirectorBench, Display, TEXT("  %-20s %10.2f  baseline %10.2f  limit %10.2f  %s"),
+            M.Name, M.Value, M.Baseline, M.IsGated() ? M.GetLimit() : -1.f,
+            !M.IsGated() ? (M.Value < 0.f ? TEXT("UNGATED (not measured)") : TEXT("UNGATED (no baseline)")) : M.Regressed() ? TEXT("REGRESSION") : TEXT("ok"));
+        Csv += FString::Printf(TEXT("%s,%.3f,%.3f,%.3f,%s"), M.Name, M.Value, M.Baseline, M.IsGated() ? M.GetLimit() : -1.f, Result);
+        Csv += LINE_TERMINATOR;
+    }
+    Csv += FString::Printf(TEXT("cuts,%d,%d,%d,%s"), Cuts, ExpectedCuts, ExpectedCuts, Cuts == ExpectedCuts ? TEXT("ok") : TEXT("regression"));
+    Csv += LINE_TERMINATOR;
+
+    if (Cuts != ExpectedCuts)
+    {
+        UE_LOG(LogDirectorBench, Error, TEXT("Only %d of %d scripted cuts committed"), Cuts, ExpectedCuts);
+    }
+
+    // A run that compared nothing isn't a pass: missing baselines exit with their own status
+    const EExitCode ExitCode = bRegressed ? ExitRegressed : NumUngated > 0 ? ExitUngated : ExitPassed;
+
+    const FString Path = FPaths::ProfilingDir() / TEXT("Director") /
+        FString::Printf(TEXT("Bench-%s.csv"), *FDateTime::Now().ToString());
+    FFileHelper::SaveStringToFile(Csv, *Path);
+    UE_LOG(LogDirectorBench, Display, TEXT("Benchmark %s; CSV: %s"),
+        ExitCode == ExitPassed ? TEXT("PASSED") : ExitCode == ExitRegressed ? TEXT("FAILED") : TEXT("UNGATED (record a baseline with `director.Bench baseline`)"), *Path);
+
+    if (Params.bWriteBaseline)
+    {
+        // Unmeasured metrics keep "not recorded"
+        Settings->BaselineFrameMsP95 = Metrics[0].Value;
+        Settings->BaselineGameThreadMsP95 = Metrics[1].Value;
+        Settings->BaselineAllocsPerFrame = Metrics[2].Value;
+        Settings->BaselineAllocsPerCut = Metrics[3].Value;
+        Settings->BaselineRepBytesPerCut = Metrics[4].Value;
+        Settings->TryUpdateDefaultConfigFile();
+        UE_LOG(LogDirectorBench, Display, TEXT("Baseline written to DefaultGame.ini"));
+    }
+
+    DespawnScenario();
+    Phase = EPhase::Idle;
+
+    if (FParse::Param(FCommandLine::Get(), TEXT("DirectorBenchExit")))
+    {
+        FPlatformMisc::RequestExitWithStatus(false, static_cast<uint8>(ExitCode));
+    }
+}
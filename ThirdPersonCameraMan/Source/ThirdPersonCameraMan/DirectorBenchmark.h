@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DirectorBenchmark.generated.h"
+
+class ACameraRig;
+class APawn;
+
+// Allocation counting for the benchmark and allocation tests. With -DirectorBenchAllocs a counting proxy is installed
+// over GMalloc once, at module startup before any world exists, and never removed; without it nothing is counted
+namespace DirectorAllocCounter
+{
+    void InstallIfRequested();
+    bool IsInstalled();
+    // Allocation calls on all threads
+    uint64 GetCount();
+    // Allocation calls made from the calling thread only; lets the game thread measure a code path exactly
+    uint64 GetThreadCount();
+}
+
+// Counts, pacing and stored baseline for `director.Bench` ([/Script/ThirdPersonCameraMan.DirectorBenchmarkSettings] in DefaultGame.ini)
+UCLASS(config=Game, defaultconfig)
+class UDirectorBenchmarkSettings : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    // Scenario defaults; each can be overridden on the command (rigs=N enemies=N viewers=N cycles=N)
+    UPROPERTY(config, EditAnywhere, Category="Scenario", meta=(ClampMin=2)) int32 Rigs = 12;
+    UPROPERTY(config, EditAnywhere, Category="Scenario", meta=(ClampMin=0)) int32 Enemies = 8;
+    UPROPERTY(config, EditAnywhere, Category="Scenario", meta=(ClampMin=0)) int32 Viewers = 0;
+    UPROPERTY(config, EditAnywhere, Category="Scenario", meta=(ClampMin=1)) int32 Cycles = 20;
+
+    // Spawned rig class (BP_CameraRig for meshes); the native rig is used when unset
+    UPROPERTY(config, EditAnywhere, Category="Scenario") TSoftClassPtr<ACameraRig> RigClass;
+    // Enemy class to populate the scene with (e.g. the combat enemy BP); no enemies when unset
+    UPROPERTY(config, EditAnywhere, Category="Scenario") TSoftClassPtr<APawn> EnemyClass;
+
+    // Time between scripted steps; must stay above the switch lock / cooldown or steps get ignored
+    UPROPERTY(config, EditAnywhere, Category="Pacing", meta=(ClampMin=0.2)) float StepIntervalSeconds = 0.4f;
+    UPROPERTY(config, EditAnywhere, Category="Pacing", meta=(ClampMin=0)) float WarmupSeconds = 2.f;
+    UPROPERTY(config, EditAnywhere, Category="Pacing", meta=(ClampMin=0)) float ViewerWaitSeconds = 30.f;
+
+    // Stored baseline. Negative = not recorded: the metric is reported as UNGATED and the run can't pass (exit 2).
+    // 0 is a real baseline (e.g. no allocations allowed). `director.Bench baseline` rewrites these
+    UPROPERTY(config, EditAnywhere, Category="Baseline") float BaselineFrameMsP95 = -1.f;
+    UPROPERTY(config, EditAnywhere, Category="Baseline") float BaselineGameThreadMsP95 = -1.f;
+    UPROPERTY(config, EditAnywhere, Category="Baseline") float BaselineAllocsPerFrame = -1.f;
+    // Game-thread allocations per scripted cut, measured around the pickup / switch / drop calls
+    UPROPERTY(config, EditAnywhere, Category="Baseline") float BaselineAllocsPerCut = -1.f;
+    UPROPERTY(config, EditAnywhere, Category="Baseline") float BaselineRepBytesPerCut = -1.f;
+
+    // Allowed regression over the baseline, in percent
+    UPROPERTY(config, EditAnywhere, Category="Baseline", meta=(ClampMin=0)) float FrameTimeTolerancePct = 15.f;
+    UPROPERTY(config, EditAnywhere, Category="Baseline", meta=(ClampMin=0)) float AllocTolerancePct = 10.f;
+    UPROPERTY(config, EditAnywhere, Category="Baseline", meta=(ClampMin=0)) float RepBytesTolerancePct = 0.f;
+};
+
+/**
+ * Scripted performance run of the director flow on the server/listen host.
+ * Spawns a ring of rigs (and optional enemies) around the operator, waits for viewers, then runs
+ * pickup -> switch -> drop cycles while sampling frame time, game-thread time, allocations per frame and
+ * per cut (with -DirectorBenchAllocs) and estimated director replication bytes. Results are compared against
+ * the stored baseline; with -DirectorBenchExit the process exits with 0 (pass), 1 (regression or missed cut)
+ * or 2 (no regression, but a metric has no baseline or couldn't be measured, so the run gated nothing).
+ */
+UCLASS()
+class UDirectorBenchmark : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    struct FParams
+    {
+        int32 Rigs = 0;
+        int32 Enemies = 0;
+        int32 Viewers = 0;
+        int32 Cycles = 0;
+        bool bWriteBaseline = false;
+    };
+
+    static UDirectorBenchmark* Get(const UObject* WorldContext);
+
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    bool Start(const FParams& InParams);
+    void Stop();
+    bool IsRunning() const { return Phase != EPhase::Idle; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+    {
+        return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+    }
+
+private:
+    enum class EPhase : uint8 { Idle, WaitingForViewers, Warmup, Running };
+
+    struct FMetric
+    {
+        const TCHAR* Name;
+        float Value;        // negative = not measured
+        float Baseline;     // negative = not recorded
+        float TolerancePct;
+        bool IsGated() const { return Value >= 0.f && Baseline >= 0.f; }
+        float GetLimit() const { return Baseline * (1.f + TolerancePct / 100.f); }
+        bool Regressed() const { return IsGated() && Value > GetLimit(); }
+    };
+
+    // -DirectorBenchExit status
+    enum EExitCode : int32 { ExitPassed = 0, ExitRegressed = 1, ExitUngated = 2 };
+
+    void SpawnScenario(APawn* OperatorPawn);
+    void DespawnScenario();
+    void RunStep();
+    void SendHome(ACameraRig* Rig) const;
+    void SampleFrame();
+    void Finish();
+
+    APawn* GetOperatorPawn() const;
+    int32 GetViewerCount() const;
+
+    FParams Params;
+    EPhase Phase = EPhase::Idle;
+    double PhaseStartTime = 0.0;
+    double NextStepTime = 0.0;
+    int32 StepIndex = 0;
+
+    UPROPERTY(Transient) TArray<ACameraRig*> Rigs;
+    UPROPERTY(Transient) TArray<AActor*> Enemies;
+    TArray<FTransform> RigHomes;
+
+    // Per-frame samples over the measured window
+    TArray<float> FrameMs;
+    TArray<float> GameThreadMs;
+    TArray<float> AllocsPerFrame;
+    double LastFrameTime = 0.0;
+    uint64 LastAllocCount = 0;
+    uint64 RepBytesAtStart = 0;
+    int32 Cuts = 0;
+    uint64 StepAllocs = 0;
+};
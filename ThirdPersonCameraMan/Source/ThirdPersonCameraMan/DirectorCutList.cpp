@@ -0,0 +1,256 @@
+#include "DirectorCutList.h"
+
+#include "DirectorRigRegistry.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorCutList, Log, All);
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorCutListCommand(
+    TEXT("director.CutList"),
+    TEXT("Scripted cut-list playback (server). Args: play <asset path> | stop | report"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDirectorCutListPlayer* Player = UDirectorCutListPlayer::Get(World);
+        if (!Player || Args.Num() == 0) return;
+
+        if (Args[0] == TEXT("play") && Args.Num() > 1)
+        {
+            Player->Play(LoadObject<UDirectorCutList>(nullptr, *Args[1]));
+        }
+        else if (Args[0] == TEXT("stop"))
+        {
+            Player->Stop();
+        }
+        else if (Args[0] == TEXT("report"))
+        {
+            Player->PrintReport();
+        }
+    }));
+
+UDirectorCutListPlayer* UDirectorCutListPlayer::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorCutListPlayer>() : nullptr;
+}
+
+bool UDirectorCutListPlayer::IsPlaying(const UObject* WorldContext)
+{
+    const UDirectorCutListPlayer* Player = Get(WorldContext);
+    return Player && Player->bPlaying;
+}
+
+TStatId UDirectorCutListPlayer::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDirectorCutListPlayer, STATGROUP_Tickables);
+}
+
+void UDirectorCutListPlayer::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (InWorld.GetNetMode() != NM_Client && FParse::Value(FCommandLine::Get(), TEXT("DirectorCutList="), AutoplayPath))
+    {
+        bExitWhenDone = FParse::Param(FCommandLine::Get(), TEXT("DirectorCutListExit"));
+    }
+}
+
+bool UDirectorCutListPlayer::Play(const UDirectorCutList* InCutList)
+{
+    UWorld* World = GetWorld();
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!InCutList || !Registry || World->GetNetMode() == NM_Client)
+    {
+        UE_LOG(LogDirectorCutList, Warning, TEXT("Cut list not played (missing asset, or not the server)"));
+        return false;
+    }
+
+    Stop();
+    CutList = InCutList;
+    Schedule.Reset(CutList->Cuts.Num());
+
+    // Rig names resolve once here; the tick only walks the schedule
+    const TArray<ACameraRig*>& Rigs = Registry->GetRigs();
+    const double FixedDt = FApp::UseFixedTimeStep() ? FApp::GetFixedDeltaTime() : 0.0;
+    for (const FDirectorCutEntry& Entry : CutList->Cuts)
+    {
+        ACameraRig* const* Found = Rigs.FindByPredicate([&Entry](const ACameraRig* Rig)
+        {
+            return Rig && (Rig->RigLabel == Entry.Rig || Rig->GetFName() == Entry.Rig);
+        });
+        if (!Found)
+        {
+            UE_LOG(LogDirectorCutList, Warning, TEXT("Cut at %.3fs skipped: no rig '%s'"), Entry.Time, *Entry.Rig.ToString());
+            continue;
+        }
+
+        FScheduledCut& Cut = Schedule.AddDefaulted_GetRef();
+        Cut.CutTime = Entry.Time;
+        Cut.PrewarmTime = FMath::Max(0.0, static_cast<double>(Entry.Time) - CutList->PrewarmLeadSeconds);
+        Cut.Rig = *Found;
+        Cut.Profile = Entry.CaptureProfile;
+        Cut.Style = Entry.Transition;
+        Cut.StyleSeconds = Entry.TransitionSeconds;
+
+        // Frame N ends at N * dt, so the cut belongs to the first frame ending at or after its time
+        if (FixedDt > 0.0)
+        {
+            Cut.ExpectedFrame = FMath::Max(1, FMath::CeilToInt(Cut.CutTime / FixedDt - UE_KINDA_SMALL_NUMBER));
+        }
+    }
+    Schedule.StableSort([](const FScheduledCut& A, const FScheduledCut& B) { return A.CutTime < B.CutTime; });
+
+    if (Schedule.Num() == 0)
+    {
+        UE_LOG(LogDirectorCutList, Warning, TEXT("Cut list %s has no playable cuts"), *GetNameSafe(CutList));
+        return false;
+    }
+
+    // The operator's shot, handed back when playback ends
+    const ADirectorGameState* GS = World->GetGameState<ADirectorGameState>();
+    ACameraRig* Live = GS ? GS->ActiveCamera : nullptr;
+    CarriedRig = Live && Cast<APawn>(Live->GetAttachParentActor()) ? Live : nullptr;
+
+    PlaybackTime = 0.0;
+    PlaybackFrame = 0;
+    NextPrewarm = 0;
+    NextCut = 0;
+    bPlaying = true;
+    UE_LOG(LogDirectorCutList, Log, TEXT("Playing cut list %s: %d cuts over %.2fs%s"), *GetNameSafe(CutList), Schedule.Num(),
+        Schedule.Last().CutTime, FixedDt > 0.0 ? TEXT(" (fixed step)") : TEXT(""));
+    return true;
+}
+
+void UDirectorCutListPlayer::Stop()
+{
+    if (!bPlaying) return;
+    bPlaying = false;
+
+    // Rigs warmed for cuts that will now never happen stop capturing
+    for (int32 i = NextCut; i < NextPrewarm; ++i)
+    {
+        if (ACameraRig* Rig = Schedule[i].Rig.Get())
+        {
+            Rig->CancelPrewarm();
+        }
+    }
+    UE_LOG(LogDirectorCutList, Log, TEXT("Cut list stopped at %.2fs (%d/%d cuts)"), PlaybackTime, NextCut, Schedule.Num());
+    Restore();
+}
+
+void UDirectorCutListPlayer::Tick(float DeltaTime)
+{
+    if (!AutoplayPath.IsEmpty())
+    {
+        const FString Path = MoveTemp(AutoplayPath);
+        AutoplayPath.Reset();
+        if (!Play(LoadObject<UDirectorCutList>(nullptr, *Path)) && bExitWhenDone)
+        {
+            FPlatformMisc::RequestExitWithStatus(false, 1);
+        }
+    }
+    if (!bPlaying) return;
+
+    // Time at the end of this frame; anything due by now happens now
+    PlaybackTime += DeltaTime;
+    ++PlaybackFrame;
+
+    const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    while (NextPrewarm < Schedule.Num() && Schedule[NextPrewarm].PrewarmTime <= PlaybackTime)
+    {
+        FScheduledCut& Cut = Schedule[NextPrewarm++];
+        ACameraRig* Rig = Cut.Rig.Get();
+        if (Rig && (!GS || GS->ActiveCamera != Rig))
+        {
+            Rig->PrewarmCapture(Cut.Profile);
+        }
+    }
+
+    // Several cuts due in one frame (a hitch): only the last one is seen, but each is committed and reported
+    while (NextCut < Schedule.Num() && Schedule[NextCut].CutTime <= PlaybackTime)
+    {
+        CommitCut(Schedule[NextCut++]);
+    }
+
+    if (NextCut >= Schedule.Num())
+    {
+        Finish();
+    }
+}
+
+void UDirectorCutListPlayer::CommitCut(FScheduledCut& Cut)
+{
+    ACameraRig* Rig = Cut.Rig.Get();
+    ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    if (!Rig || !GS) return;
+
+    // Already live (e.g. two entries in a row on one rig): counts as on time, nothing to switch
+    // RequestGoLive begins the transition itself
+    if (GS->ActiveCamera != Rig)
+    {
+        GS->SetPendingTransitionStyle(Cut.Style, Cut.StyleSeconds);
+        Rig->RequestGoLive(true);
+    }
+
+    Cut.bCommitted = GS->ActiveCamera == Rig;
+    Cut.CommitFrame = PlaybackFrame;
+    Cut.CommitTime = PlaybackTime;
+    UE_LOG(LogDirectorCutList, Verbose, TEXT("Cut %s at %.4fs (due %.4fs, frame %d)"), *Rig->GetName(), PlaybackTime, Cut.CutTime, PlaybackFrame);
+}
+
+void UDirectorCutListPlayer::Finish()
+{
+    bPlaying = false;
+    const bool bPassed = PrintReport();
+    Restore();
+
+    if (bExitWhenDone)
+    {
+        FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+    }
+}
+
+void UDirectorCutListPlayer::Restore()
+{
+    TArray<ACameraRig*, TInlineAllocator<16>> Restored;
+    for (const FScheduledCut& Cut : Schedule)
+    {
+        ACameraRig* Rig = Cut.Rig.Get();
+        if (Rig && !Restored.Contains(Rig))
+        {
+            Restored.Add(Rig);
+            Rig->RestoreCaptureProfile();
+        }
+    }
+
+    // Still on the operator's pawn (they may have dropped it meanwhile): back to their shot
+    ACameraRig* Carried = CarriedRig.Get();
+    CarriedRig.Reset();
+    const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    if (Carried && GS && GS->ActiveCamera != Carried && Cast<APawn>(Carried->GetAttachParentActor()))
+    {
+        Carried->RequestGoLive(true);
+    }
+}
+
+bool UDirectorCutListPlayer::PrintReport() const
+{
+    bool bAllOnFrame = Schedule.Num() > 0;
+    UE_LOG(LogDirectorCutList, Display, TEXT("Cut list %s: %d cuts"), *GetNameSafe(CutList), Schedule.Num());
+    for (const FScheduledCut& Cut : Schedule)
+    {
+        // Without a fixed step the best possible is committing within the frame that crossed the cut time
+        const bool bOnFrame = Cut.bCommitted && (Cut.ExpectedFrame == INDEX_NONE || Cut.CommitFrame == Cut.ExpectedFrame);
+        bAllOnFrame &= bOnFrame;
+
+        UE_LOG(LogDirectorCutList, Display, TEXT("  %8.3fs %-24s frame %5d (expected %5d) late %6.2f ms %s"),
+            Cut.CutTime, *GetNameSafe(Cut.Rig.Get()), Cut.CommitFrame, Cut.ExpectedFrame, (Cut.CommitTime - Cut.CutTime) * 1000.0,
+            !Cut.bCommitted ? TEXT("MISSED") : (bOnFrame ? TEXT("ok") : TEXT("OFF FRAME")));
+    }
+    UE_LOG(LogDirectorCutList, Display, TEXT("Cut list result: %s"), bAllOnFrame ? TEXT("PASS") : TEXT("FAIL"));
+    return bAllOnFrame;
+}
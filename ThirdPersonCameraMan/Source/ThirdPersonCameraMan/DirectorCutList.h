@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CameraRig.h"
+#include "DirectorGameState.h"
+#include "DirectorCutList.generated.h"
+
+// One scripted cut: at Time, go live on the rig whose RigLabel (or actor name) is Rig
+USTRUCT(BlueprintType)
+struct FDirectorCutEntry
+{
+    GENERATED_BODY()
+
+    // Seconds from the start of playback
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cut", meta=(ClampMin=0)) float Time = 0.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cut") FName Rig;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cut") FDirectorCaptureProfile CaptureProfile;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cut") EDirectorTransitionStyle Transition = EDirectorTransitionStyle::Cut;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Cut", meta=(ClampMin=0)) float TransitionSeconds = 0.5f;
+};
+
+// Timeline of cuts for scripted shows (`director.CutList play <asset path>`)
+UCLASS(BlueprintType)
+class UDirectorCutList : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="CutList") TArray<FDirectorCutEntry> Cuts;
+
+    // Each upcoming rig starts capturing (with its profile applied) this long before its cut
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="CutList", meta=(ClampMin=0)) float PrewarmLeadSeconds = 0.5f;
+};
+
+/**
+ * Server-side cut-list playback. The operator hands off to the timeline: pickups, bumps, drops and the
+ * auto-director stand down while it plays.
+ * Play() resolves every entry against the rig registry once into a time-sorted schedule; Tick then only walks
+ * two cursors (pre-warm, cut). Playback time is the sum of world frame deltas, so under a fixed time step
+ * (-benchmark -fps=N) every cut lands on a known frame and runs are repeatable headless. Each cut commits in
+ * the first frame at or past its time, through RequestGoLive + ADirectorGameState (switch lock bypassed).
+ * When playback ends or stops, every rig gets its own FOV / view distance back and the rig the operator was
+ * carrying when it started goes live again. The report lists per-cut frame error; `-DirectorCutList=<asset path>` plays on startup and with
+ * -DirectorCutListExit the process exits with 0 (every cut on its frame) or 1.
+ */
+UCLASS()
+class UDirectorCutListPlayer : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorCutListPlayer* Get(const UObject* WorldContext);
+    static bool IsPlaying(const UObject* WorldContext);
+
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    bool Play(const UDirectorCutList* InCutList);
+    void Stop();
+    bool IsPlaying() const { return bPlaying; }
+
+    // Per-cut results of the current / last run; returns true when every cut committed on its frame
+    bool PrintReport() const;
+
+    // Cut Index of the current / last run (schedule order): the frame it was due on (fixed time step only) and
+    // the frame it committed on. False when it was not committed
+    int32 GetNumScheduledCuts() const { return Schedule.Num(); }
+    bool GetCutFrames(int32 Index, int32& OutExpectedFrame, int32& OutCommitFrame) const
+    {
+        if (!Schedule.IsValidIndex(Index)) return false;
+        OutExpectedFrame = Schedule[Index].ExpectedFrame;
+        OutCommitFrame = Schedule[Index].CommitFrame;
+        return Schedule[Index].bCommitted;
+    }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+    {
+        return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+    }
+
+private:
+    struct FScheduledCut
+    {
+        double CutTime = 0.0;
+        double PrewarmTime = 0.0;
+        TWeakObjectPtr<ACameraRig> Rig;
+        FDirectorCaptureProfile Profile;
+        EDirectorTransitionStyle Style = EDirectorTransitionStyle::Cut;
+        float StyleSeconds = 0.f;
+
+        // Results
+        int32 ExpectedFrame = INDEX_NONE;   // fixed time step only
+        int32 CommitFrame = INDEX_NONE;
+        double CommitTime = 0.0;
+        bool bCommitted = false;
+    };
+
+    void CommitCut(FScheduledCut& Cut);
+    void Finish();
+    // Undo the cut list's overrides and hand the live slot back to the operator's rig
+    void Restore();
+
+    UPROPERTY(Transient) const UDirectorCutList* CutList = nullptr;
+    TArray<FScheduledCut> Schedule;   // sorted by cut time (and so by pre-warm time: the lead is shared)
+    int32 NextPrewarm = 0;
+    int32 NextCut = 0;
+
+    // Live and attached to a pawn when playback started
+    TWeakObjectPtr<ACameraRig> CarriedRig;
+
+    double PlaybackTime = 0.0;
+    int32 PlaybackFrame = 0;
+    bool bPlaying = false;
+    bool bExitWhenDone = false;
+
+    // -DirectorCutList= path, started on the first tick (rigs register after the subsystem's begin play)
+    FString AutoplayPath;
+};
@@ -0,0 +1,253 @@
+#include "DirectorFeedCompositor.h"
+
+#include "CameraRig.h"
+#include "CanvasItem.h"
+#include "DirectorRigRegistry.h"
+#include "DirectorStats.h"
+#include "Engine/Canvas.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/KismetRenderingLibrary.h"
+#include "RenderUtils.h"
+#include "TextureResource.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorFeedCompositor, Log, All);
+
+// 8-bit targets: the GPU blend and the CPU reference may round differently by a step
+static constexpr int32 MaxChannelError = 2;
+
+// Captures the first two same-sized rigs into scratch targets, composites every style at a few alphas on the GPU,
+// reads everything back and compares against CompositeCPU
+static FAutoConsoleCommandWithWorldAndArgs GDirectorFeedCompositeCheckCommand(
+    TEXT("director.FeedCompositeCheck"),
+    TEXT("Compare the GPU feed transitions against the CPU reference using two rig views"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(World);
+        if (!Registry) return;
+
+        ACameraRig* RigA = nullptr;
+        ACameraRig* RigB = nullptr;
+        for (ACameraRig* Rig : Registry->GetRigs())
+        {
+            if (!Rig || !Rig->RenderTarget) continue;
+            if (!RigA)
+            {
+                RigA = Rig;
+            }
+            else if (Rig->RenderTarget->SizeX == RigA->RenderTarget->SizeX && Rig->RenderTarget->SizeY == RigA->RenderTarget->SizeY)
+            {
+                RigB = Rig;
+                break;
+            }
+        }
+        if (!RigB)
+        {
+            UE_LOG(LogDirectorFeedCompositor, Warning, TEXT("FeedCompositeCheck needs two rigs with same-sized render targets"));
+            return;
+        }
+
+        const int32 W = RigA->RenderTarget->SizeX;
+        const int32 H = RigA->RenderTarget->SizeY;
+        UTextureRenderTarget2D* From = UKismetRenderingLibrary::CreateRenderTarget2D(World, W, H, ETextureRenderTargetFormat::RTF_RGBA8);
+        UTextureRenderTarget2D* To = UKismetRenderingLibrary::CreateRenderTarget2D(World, W, H, ETextureRenderTargetFormat::RTF_RGBA8);
+        UTextureRenderTarget2D* Out = UKismetRenderingLibrary::CreateRenderTarget2D(World, W, H, ETextureRenderTargetFormat::RTF_RGBA8);
+        RigA->CaptureInto(From);
+        RigB->CaptureInto(To);
+
+        TArray<FColor> FromPixels, ToPixels, GpuPixels, CpuPixels;
+        From->GameThread_GetRenderTargetResource()->ReadPixels(FromPixels);
+        To->GameThread_GetRenderTargetResource()->ReadPixels(ToPixels);
+
+        static const EDirectorTransitionStyle Styles[] = { EDirectorTransitionStyle::Crossfade, EDirectorTransitionStyle::DipToBlack, EDirectorTransitionStyle::Wipe };
+        static const float Alphas[] = { 0.f, 0.25f, 0.5f, 0.75f, 1.f };
+        bool bPassed = true;
+        for (const EDirectorTransitionStyle Style : Styles)
+        {
+            int32 WorstError = 0;
+            for (const float Alpha : Alphas)
+            {
+                FDirectorFeedCompositor::Composite(World, Out, From, To, Style, Alpha);
+                Out->GameThread_GetRenderTargetResource()->ReadPixels(GpuPixels);
+                FDirectorFeedCompositor::CompositeCPU(FromPixels, ToPixels, W, H, Style, Alpha, CpuPixels);
+                bPassed &= CpuPixels.Num() == W * H && GpuPixels.Num() == W * H;   // a short readback has nothing to compare
+
+                for (int32 i = 0; i < CpuPixels.Num() && i < GpuPixels.Num(); ++i)
+                {
+                    WorstError = FMath::Max3(WorstError, FMath::Abs(GpuPixels[i].R - CpuPixels[i].R), FMath::Abs(GpuPixels[i].G - CpuPixels[i].G));
+                    WorstError = FMath::Max(WorstError, FMath::Abs(GpuPixels[i].B - CpuPixels[i].B));
+                }
+            }
+            bPassed &= WorstError <= MaxChannelError;
+            UE_LOG(LogDirectorFeedCompositor, Display, TEXT("  %-10s max channel error %3d %s"), *UEnum::GetDisplayValueAsText(Style).ToString(),
+                WorstError, WorstError <= MaxChannelError ? TEXT("ok") : TEXT("MISMATCH"));
+        }
+        UE_LOG(LogDirectorFeedCompositor, Display, TEXT("Feed composite check (%s -> %s, %dx%d): %s"), *RigA->GetName(), *RigB->GetName(), W, H,
+            bPassed ? TEXT("PASS") : TEXT("FAIL"));
+    }));
+
+UTextureRenderTarget2D* FDirectorFeedCompositor::EnsureTarget(UObject* Outer, UTextureRenderTarget2D* Existing, int32 Width, int32 Height)
+{
+    if (Existing && Existing->SizeX == Width && Existing->SizeY == Height)
+    {
+        return Existing;
+    }
+    return UKismetRenderingLibrary::CreateRenderTarget2D(Outer, Width, Height, ETextureRenderTargetFormat::RTF_RGBA8);
+}
+
+bool FDirectorFeedCompositor::Begin(UObject* WorldContext, UTextureRenderTarget2D* From, UTextureRenderTarget2D* To, EDirectorTransitionStyle InStyle, float Seconds)
+{
+    Stop();
+    if (InStyle == EDirectorTransitionStyle::Cut || Seconds <= 0.f || !From || !To || From == To) return false;
+
+    HeldFrame = EnsureTarget(WorldContext, HeldFrame, To->SizeX, To->SizeY);
+    Output = EnsureTarget(WorldContext, Output, To->SizeX, To->SizeY);
+    if (!HeldFrame || !Output) return false;
+
+    // The outgoing rig stops capturing with the cut (and may be re-captured into for a wall tile): freeze it now
+    CopyFrame(WorldContext, HeldFrame, From);
+
+    Live = To;
+    Style = InStyle;
+    Duration = Seconds;
+    Elapsed = 0.f;
+    Composite(WorldContext, Output, HeldFrame, Live, Style, 0.f);
+    return true;
+}
+
+bool FDirectorFeedCompositor::Tick(UObject* WorldContext, float DeltaTime)
+{
+    if (!Live) return false;
+
+    Elapsed += DeltaTime;
+    if (Elapsed >= Duration)
+    {
+        Stop();
+        return false;
+    }
+
+    Composite(WorldContext, Output, HeldFrame, Live, Style, FMath::SmoothStep(0.f, 1.f, Elapsed / Duration));
+    return true;
+}
+
+void FDirectorFeedCompositor::CopyFrame(UObject* WorldContext, UTextureRenderTarget2D* Target, UTextureRenderTarget2D* Source)
+{
+    Composite(WorldContext, Target, Source, Source, EDirectorTransitionStyle::Cut, 0.f);
+}
+
+// Base layer is whichever feed dominates, drawn opaque; the other (or black) goes on top as one translucent quad
+void FDirectorFeedCompositor::Composite(UObject* WorldContext, UTextureRenderTarget2D* Target, UTextureRenderTarget2D* From, UTextureRenderTarget2D* To,
+    EDirectorTransitionStyle Style, float Alpha)
+{
+    if (!Target || !From || !To) return;
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorFeedComposite);
+
+    UCanvas* Canvas = nullptr;
+    FVector2D Size;
+    FDrawToRenderTargetContext Context;
+    UKismetRenderingLibrary::BeginDrawCanvasToRenderTarget(WorldContext, Target, Canvas, Size, Context);
+    if (!Canvas) return;
+
+    auto DrawQuad = [Canvas, &Size](const FTexture* Texture, float U0, float U1, const FLinearColor& Color, ESimpleElementBlendMode BlendMode)
+    {
+        FCanvasTileItem Item(FVector2D(U0 * Size.X, 0.f), Texture, FVector2D((U1 - U0) * Size.X, Size.Y), FVector2D(U0, 0.f), FVector2D(U1, 1.f), Color);
+        Item.BlendMode = BlendMode;
+        Canvas->DrawItem(Item);
+    };
+
+    const bool bSecondHalf = Alpha >= 0.5f;
+    switch (Style)
+    {
+    case EDirectorTransitionStyle::Crossfade:
+        DrawQuad(To->GetResource(), 0.f, 1.f, FLinearColor::White, SE_BLEND_Opaque);
+        DrawQuad(From->GetResource(), 0.f, 1.f, FLinearColor(1.f, 1.f, 1.f, 1.f - Alpha), SE_BLEND_Translucent);
+        break;
+
+    case EDirectorTransitionStyle::DipToBlack:
+        DrawQuad((bSecondHalf ? To : From)->GetResource(), 0.f, 1.f, FLinearColor::White, SE_BLEND_Opaque);
+        DrawQuad(GWhiteTexture, 0.f, 1.f, FLinearColor(0.f, 0.f, 0.f, bSecondHalf ? 2.f * (1.f - Alpha) : 2.f * Alpha), SE_BLEND_Translucent);
+        break;
+
+    case EDirectorTransitionStyle::Wipe:
+    {
+        // Incoming feed sweeps in from the left
+        const int32 Width = FMath::RoundToInt(Size.X);
+        const float Split = Width > 0 ? static_cast<float>(WipeSplit(Width, Alpha)) / Width : 1.f;
+        DrawQuad(To->GetResource(), 0.f, 1.f, FLinearColor::White, SE_BLEND_Opaque);
+        if (Split < 1.f)
+        {
+            DrawQuad(From->GetResource(), Split, 1.f, FLinearColor::White, SE_BLEND_Opaque);
+        }
+        break;
+    }
+
+    default:
+        DrawQuad(From->GetResource(), 0.f, 1.f, FLinearColor::White, SE_BLEND_Opaque);
+        break;
+    }
+
+    UKismetRenderingLibrary::EndDrawCanvasToRenderTarget(WorldContext, Context);
+}
+
+void FDirectorFeedCompositor::CompositeCPU(TConstArrayView<FColor> From, TConstArrayView<FColor> To, int32 Width, int32 Height,
+    EDirectorTransitionStyle Style, float Alpha, TArray<FColor>& Out)
+{
+    const int32 Num = Width * Height;
+    if (Width <= 0 || Height <= 0 || From.Num() < Num || To.Num() < Num)
+    {
+        Out.Reset();
+        return;
+    }
+    Out.SetNumUninitialized(Num);
+
+    // Translucent quad over an opaque base: Dst = Src * A + Dst * (1 - A)
+    auto Blend = [](const FColor& Base, const FColor& Over, float A) -> FColor
+    {
+        return FColor(
+            (uint8)FMath::RoundToInt(Over.R * A + Base.R * (1.f - A)),
+            (uint8)FMath::RoundToInt(Over.G * A + Base.G * (1.f - A)),
+            (uint8)FMath::RoundToInt(Over.B * A + Base.B * (1.f - A)),
+            Base.A);
+    };
+
+    const bool bSecondHalf = Alpha >= 0.5f;
+    switch (Style)
+    {
+    case EDirectorTransitionStyle::Crossfade:
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Out[i] = Blend(To[i], From[i], 1.f - Alpha);
+        }
+        break;
+
+    case EDirectorTransitionStyle::DipToBlack:
+    {
+        const TConstArrayView<FColor> Base = bSecondHalf ? To : From;
+        const float Black = FMath::Clamp(bSecondHalf ? 2.f * (1.f - Alpha) : 2.f * Alpha, 0.f, 1.f);
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Out[i] = Blend(Base[i], FColor::Black, Black);
+        }
+        break;
+    }
+
+    case EDirectorTransitionStyle::Wipe:
+    {
+        const int32 Split = WipeSplit(Width, Alpha);
+        for (int32 y = 0; y < Height; ++y)
+        {
+            const int32 Row = y * Width;
+            for (int32 x = 0; x < Width; ++x)
+            {
+                Out[Row + x] = x < Split ? To[Row + x] : From[Row + x];
+            }
+        }
+        break;
+    }
+
+    default:
+        FMemory::Memcpy(Out.GetData(), From.GetData(), Num * sizeof(FColor));
+        break;
+    }
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DirectorGameState.h"
+#include "DirectorFeedCompositor.generated.h"
+
+class UTextureRenderTarget2D;
+
+/**
+ * Feed transition stage between two rig render targets (crossfade, dip-to-black, wipe).
+ * The outgoing feed is copied once into HeldFrame when the transition starts; every frame after that the
+ * incoming rig's live RT and the held frame are drawn as two canvas quads into Output, which the feed widget
+ * shows until the transition ends. Neither rig is captured twice and no view poses are blended, so the cost is
+ * one held frame plus the output, at feed size, whatever the style.
+ * CompositeCPU is the per-pixel reference for the same maths (`director.FeedCompositeCheck` compares the two).
+ */
+USTRUCT()
+struct FDirectorFeedCompositor
+{
+    GENERATED_BODY()
+
+    // Starts a transition From -> To; false (nothing to do) for plain cuts, zero length or missing feeds
+    bool Begin(UObject* WorldContext, UTextureRenderTarget2D* From, UTextureRenderTarget2D* To, EDirectorTransitionStyle InStyle, float Seconds);
+
+    // Draws this frame's composite; returns false once the transition has finished (Output then equals To)
+    bool Tick(UObject* WorldContext, float DeltaTime);
+
+    void Stop() { Live = nullptr; }
+    bool IsActive() const { return Live != nullptr; }
+    UTextureRenderTarget2D* GetOutput() const { return Output; }
+
+    // Alpha 0 shows From, 1 shows To. Both inputs are scaled to Target
+    static void Composite(UObject* WorldContext, UTextureRenderTarget2D* Target, UTextureRenderTarget2D* From, UTextureRenderTarget2D* To,
+        EDirectorTransitionStyle Style, float Alpha);
+
+    // Same composite on CPU pixels (inputs and output Width x Height); bytes blended as stored, like the RGBA8 targets.
+    // Out is left empty when either input is smaller than Width x Height
+    static void CompositeCPU(TConstArrayView<FColor> From, TConstArrayView<FColor> To, int32 Width, int32 Height,
+        EDirectorTransitionStyle Style, float Alpha, TArray<FColor>& Out);
+
+    // Wipe edge in whole pixels, so the quad edge and the CPU reference agree exactly
+    static int32 WipeSplit(int32 Width, float Alpha) { return FMath::Clamp(FMath::RoundToInt(Alpha * Width), 0, Width); }
+
+    // Copies Source into Target (scaled)
+    static void CopyFrame(UObject* WorldContext, UTextureRenderTarget2D* Target, UTextureRenderTarget2D* Source);
+
+private:
+    // Reallocated only when the feed size changes
+    static UTextureRenderTarget2D* EnsureTarget(UObject* Outer, UTextureRenderTarget2D* Existing, int32 Width, int32 Height);
+
+    UPROPERTY() UTextureRenderTarget2D* HeldFrame = nullptr;
+    UPROPERTY() UTextureRenderTarget2D* Output = nullptr;
+    UPROPERTY() UTextureRenderTarget2D* Live = nullptr;   // incoming rig's RT; null = idle
+
+    EDirectorTransitionStyle Style = EDirectorTransitionStyle::Cut;
+    float Duration = 0.f;
+    float Elapsed = 0.f;
+};
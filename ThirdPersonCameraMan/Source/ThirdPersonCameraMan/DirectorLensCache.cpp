@@ -0,0 +1,292 @@
+#include "DirectorLensCache.h"
+
+#include "CameraRig.h"
+#include "DirectorRigRegistry.h"
+#include "DirectorStats.h"
+#include "ThirdPersonCameraMan.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "SceneInterface.h"
+#include "SceneManagement.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorLens, Log, All);
+
+// Activations still moving after this long are recorded at the cap
+static constexpr double SettleTimeoutSeconds = 3.0;
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorLensCacheCommand(
+    TEXT("director.LensCache"),
+    TEXT("Print cached rig exposure / focus and time-to-stable after activation. Args: [reset]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDirectorLensCache* Cache = UDirectorLensCache::Get(World);
+        if (!Cache) return;
+
+        if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+        {
+            Cache->Reset();
+            return;
+        }
+        Cache->PrintCache();
+    }));
+
+UDirectorLensCache* UDirectorLensCache::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorLensCache>() : nullptr;
+}
+
+void UDirectorLensCache::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<UDirectorRigRegistry>();
+    Super::Initialize(Collection);
+
+    FocusTraceDelegate.BindUObject(this, &UDirectorLensCache::HandleFocusTraceDone);
+}
+
+TStatId UDirectorLensCache::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDirectorLensCache, STATGROUP_Tickables);
+}
+
+// Registry indices moved: carry every rig's cache over to its new slot
+void UDirectorLensCache::SyncWithRegistry()
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Registry || Registry->GetGeneration() == RegistryGeneration) return;
+
+    RegistryGeneration = Registry->GetGeneration();
+    const TArray<ACameraRig*>& Rigs = Registry->GetRigs();
+
+    TArray<FRigLens> Old = MoveTemp(Lenses);
+    Lenses.SetNum(Rigs.Num());
+    for (int32 i = 0; i < Rigs.Num(); ++i)
+    {
+        FRigLens* Previous = Old.FindByPredicate([Rig = Rigs[i]](const FRigLens& Lens) { return Lens.Rig.Get() == Rig; });
+        if (Previous)
+        {
+            Lenses[i] = MoveTemp(*Previous);
+        }
+        Lenses[i].Rig = Rigs[i];
+    }
+}
+
+UDirectorLensCache::FRigLens* UDirectorLensCache::FindLens(const ACameraRig* Rig)
+{
+    SyncWithRegistry();
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    const int32 Index = Registry ? Registry->IndexOf(Rig) : INDEX_NONE;
+    return Lenses.IsValidIndex(Index) ? &Lenses[Index] : nullptr;
+}
+
+// Inverse of the engine's EV100 -> exposure scale (1 / (1.2 * 2^EV100)); min / max brightness are EV100 here
+// because the project extends the default luminance range (DefaultEngine.ini)
+bool UDirectorLensCache::ReadExposure(ACameraRig* Rig, float& OutEV100)
+{
+    USceneCaptureComponent2D* Capture = Rig ? Rig->SceneCapture : nullptr;
+    const FSceneViewStateInterface* ViewState = Capture && Capture->bCaptureEveryFrame ? Capture->GetViewState(0) : nullptr;
+    const float Exposure = ViewState ? ViewState->GetLastEyeAdaptationExposure() : 0.f;
+    if (Exposure <= UE_SMALL_NUMBER) return false;
+
+    OutEV100 = FMath::Log2(1.f / (1.2f * Exposure));
+    return true;
+}
+
+void UDirectorLensCache::Sample(FRigLens& Lens, ACameraRig* Rig)
+{
+    float EV100;
+    if (ReadExposure(Rig, EV100))
+    {
+        Lens.EV100 = EV100;
+        Lens.bHasExposure = true;
+    }
+
+    const UDirectorLensSettings* Settings = GetDefault<UDirectorLensSettings>();
+    if (!Settings->bAutoFocus || !Rig->SceneCapture) return;
+
+    // One async ray per sample, read back next frame in HandleFocusTraceDone; a newer sample supersedes one still in flight
+    const FVector Start = Rig->SceneCapture->GetComponentLocation();
+    const FVector End = Start + Rig->SceneCapture->GetForwardVector() * Settings->FocusTraceDistance;
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(DirectorLensFocus), false, Rig);
+    if (const AActor* Carrier = Rig->GetAttachParentActor())
+    {
+        Params.AddIgnoredActor(Carrier);
+    }
+
+    Lens.FocusTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Settings->FocusTraceChannel, Params,
+        FCollisionResponseParams::DefaultResponseParam, &FocusTraceDelegate);
+}
+
+// Lenses move slots when the registry changes, so the result is matched by handle rather than by index
+void UDirectorLensCache::HandleFocusTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+    FRigLens* Lens = Lenses.FindByPredicate([&Handle](const FRigLens& Candidate) { return Candidate.FocusTrace == Handle; });
+    ACameraRig* Rig = Lens ? Lens->Rig.Get() : nullptr;
+    if (!Rig || !Rig->SceneCapture) return;
+
+    Lens->FocusTrace = FTraceHandle();
+    Lens->FocusDistance = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit ? Datum.OutHits[0].Distance : 0.f;
+    if (Lens->FocusDistance > 0.f)
+    {
+        Rig->SceneCapture->PostProcessSettings.bOverride_DepthOfFieldFocalDistance = true;
+        Rig->SceneCapture->PostProcessSettings.DepthOfFieldFocalDistance = Lens->FocusDistance;
+    }
+}
+
+void UDirectorLensCache::NoteCaptureStopping(ACameraRig* Rig)
+{
+    if (!GetDefault<UDirectorLensSettings>()->bEnabled) return;
+
+    if (FRigLens* Lens = FindLens(Rig))
+    {
+        // Stored now: the view state (and its adaptation) goes away once the capture is off
+        if (Lens->SeedFramesLeft > 0)
+        {
+            EndSeed(*Lens, Rig);
+        }
+        else
+        {
+            Sample(*Lens, Rig);
+        }
+        Lens->ActivatedTime = -1.0;
+    }
+}
+
+void UDirectorLensCache::NoteCaptureStarting(ACameraRig* Rig)
+{
+    const UDirectorLensSettings* Settings = GetDefault<UDirectorLensSettings>();
+    FRigLens* Lens = Settings->bEnabled ? FindLens(Rig) : nullptr;
+    if (!Lens || !Rig->SceneCapture) return;
+
+    FPostProcessSettings& PP = Rig->SceneCapture->PostProcessSettings;
+    Lens->bSeeded = Lens->bHasExposure;
+    if (Lens->bHasExposure && Lens->SeedFramesLeft == 0)
+    {
+        Lens->bSavedMinOverride = PP.bOverride_AutoExposureMinBrightness;
+        Lens->bSavedMaxOverride = PP.bOverride_AutoExposureMaxBrightness;
+        Lens->SavedMinBrightness = PP.AutoExposureMinBrightness;
+        Lens->SavedMaxBrightness = PP.AutoExposureMaxBrightness;
+
+        PP.bOverride_AutoExposureMinBrightness = true;
+        PP.bOverride_AutoExposureMaxBrightness = true;
+        PP.AutoExposureMinBrightness = Lens->EV100;
+        PP.AutoExposureMaxBrightness = Lens->EV100;
+        Lens->SeedFramesLeft = Settings->SeedFrames;
+    }
+    if (Settings->bAutoFocus && Lens->FocusDistance > 0.f)
+    {
+        PP.bOverride_DepthOfFieldFocalDistance = true;
+        PP.DepthOfFieldFocalDistance = Lens->FocusDistance;
+    }
+
+    Lens->ActivatedTime = GetWorld()->GetRealTimeSeconds();
+    Lens->StableCount = 0;
+    Lens->LastEV100 = Lens->EV100;
+    Lens->NextSampleTime = Lens->ActivatedTime + 1.0 / Settings->SampleHz;
+}
+
+void UDirectorLensCache::EndSeed(FRigLens& Lens, ACameraRig* Rig)
+{
+    Lens.SeedFramesLeft = 0;
+    if (!Rig->SceneCapture) return;
+
+    FPostProcessSettings& PP = Rig->SceneCapture->PostProcessSettings;
+    PP.bOverride_AutoExposureMinBrightness = Lens.bSavedMinOverride;
+    PP.bOverride_AutoExposureMaxBrightness = Lens.bSavedMaxOverride;
+    PP.AutoExposureMinBrightness = Lens.SavedMinBrightness;
+    PP.AutoExposureMaxBrightness = Lens.SavedMaxBrightness;
+}
+
+// Measured from activation to the first frame of a run of StableFrames frames with little exposure change
+void UDirectorLensCache::TickSettle(FRigLens& Lens, ACameraRig* Rig, double Now)
+{
+    const UDirectorLensSettings* Settings = GetDefault<UDirectorLensSettings>();
+    const double Elapsed = Now - Lens.ActivatedTime;
+
+    float EV100;
+    if (ReadExposure(Rig, EV100))
+    {
+        Lens.StableCount = FMath::Abs(EV100 - Lens.LastEV100) < Settings->StableEVDelta ? Lens.StableCount + 1 : 0;
+        Lens.LastEV100 = EV100;
+    }
+
+    const bool bSettled = Lens.StableCount >= Settings->StableFrames;
+    if (!bSettled && Elapsed < SettleTimeoutSeconds) return;
+
+    // The stable run started StableFrames frames ago; frame times are close enough to the current delta
+    const float Ms = static_cast<float>(FMath::Min(Elapsed, SettleTimeoutSeconds) * 1000.0);
+    TArray<float>& Samples = Lens.bSeeded ? SettleMsSeeded : SettleMsCold;
+    if (Samples.Num() < MaxSamples)
+    {
+        Samples.Add(Ms);
+    }
+    SET_FLOAT_STAT(STAT_DirectorLastSettleMs, Ms);
+    UE_LOG(LogDirectorLens, Verbose, TEXT("%s exposure stable after %.0f ms (%s)"), *Rig->GetName(), Ms, Lens.bSeeded ? TEXT("seeded") : TEXT("cold"));
+    Lens.ActivatedTime = -1.0;
+}
+
+void UDirectorLensCache::Tick(float DeltaTime)
+{
+    const UDirectorLensSettings* Settings = GetDefault<UDirectorLensSettings>();
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Settings->bEnabled || !Registry) return;
+
+    SyncWithRegistry();
+    const TArray<ACameraRig*>& Rigs = Registry->GetRigs();
+    const double Now = GetWorld()->GetRealTimeSeconds();
+    const double Interval = 1.0 / Settings->SampleHz;
+
+    for (int32 i = 0; i < Rigs.Num(); ++i)
+    {
+        ACameraRig* Rig = Rigs[i];
+        FRigLens& Lens = Lenses[i];
+        if (!Rig || !Rig->IsCapturing()) continue;
+
+        if (Lens.SeedFramesLeft > 0)
+        {
+            if (--Lens.SeedFramesLeft == 0)
+            {
+                EndSeed(Lens, Rig);
+            }
+            continue;
+        }
+
+        if (Lens.ActivatedTime >= 0.0)
+        {
+            TickSettle(Lens, Rig, Now);
+        }
+        if (Now >= Lens.NextSampleTime)
+        {
+            Lens.NextSampleTime = Now + Interval;
+            Sample(Lens, Rig);
+        }
+    }
+}
+
+void UDirectorLensCache::Reset()
+{
+    SettleMsSeeded.Reset();
+    SettleMsCold.Reset();
+}
+
+void UDirectorLensCache::PrintCache() const
+{
+    UE_LOG(LogDirectorLens, Display, TEXT("Lens cache (%d rigs):"), Lenses.Num());
+    for (const FRigLens& Lens : Lenses)
+    {
+        UE_LOG(LogDirectorLens, Display, TEXT("  %-24s EV100 %s focus %7.0f cm%s"), *GetNameSafe(Lens.Rig.Get()),
+            Lens.bHasExposure ? *FString::Printf(TEXT("%6.2f"), Lens.EV100) : TEXT("     -"), Lens.FocusDistance,
+            Lens.ActivatedTime >= 0.0 ? TEXT(" (settling)") : TEXT(""));
+    }
+
+    auto PrintSettle = [](const TCHAR* Label, TArray<float> Samples)
+    {
+        Samples.Sort();
+        UE_LOG(LogDirectorLens, Display, TEXT("Time-to-stable %-6s n=%4d p50 %7.1f ms p95 %7.1f ms"), Label, Samples.Num(),
+            ThirdPersonCameraMan::NearestRankPercentile(Samples, 0.5f), ThirdPersonCameraMan::NearestRankPercentile(Samples, 0.95f));
+    };
+    PrintSettle(TEXT("seeded"), SettleMsSeeded);
+    PrintSettle(TEXT("cold"), SettleMsCold);
+}
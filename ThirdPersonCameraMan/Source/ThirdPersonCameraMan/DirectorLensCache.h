@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "DirectorLensCache.generated.h"
+
+class ACameraRig;
+
+// Sampling and seeding for the lens cache ([/Script/ThirdPersonCameraMan.DirectorLensSettings] in DefaultGame.ini)
+UCLASS(config=Game, defaultconfig)
+class UDirectorLensSettings : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(config, EditAnywhere, Category="Lens") bool bEnabled = true;
+
+    // How often a capturing rig's exposure and focus are sampled into the cache
+    UPROPERTY(config, EditAnywhere, Category="Lens", meta=(ClampMin=0.5, ClampMax=30)) float SampleHz = 4.f;
+
+    // Frames a restarted capture holds the cached exposure before eye adaptation takes over from there
+    UPROPERTY(config, EditAnywhere, Category="Lens", meta=(ClampMin=1, ClampMax=30)) int32 SeedFrames = 2;
+
+    // Write the sampled focus distance into the capture's depth of field (focal distance override)
+    UPROPERTY(config, EditAnywhere, Category="Lens") bool bAutoFocus = true;
+    UPROPERTY(config, EditAnywhere, Category="Lens", meta=(ClampMin=100)) float FocusTraceDistance = 20000.f;
+    UPROPERTY(config, EditAnywhere, Category="Lens") TEnumAsByte<ECollisionChannel> FocusTraceChannel = ECC_Visibility;
+
+    // Time-to-stable: exposure counts as settled once it moved less than this (EV) for StableFrames frames in a row
+    UPROPERTY(config, EditAnywhere, Category="Lens", meta=(ClampMin=0.001)) float StableEVDelta = 0.05f;
+    UPROPERTY(config, EditAnywhere, Category="Lens", meta=(ClampMin=1)) int32 StableFrames = 3;
+};
+
+/**
+ * Per-rig exposure and focus, kept warm so a capture that restarts doesn't adapt from scratch.
+ * Scene captures only keep a view state (and so eye adaptation history) while they capture every frame; every
+ * cut used to start the new rig's exposure from nothing and pump for a few hundred ms. While a rig captures, its
+ * eye adaptation exposure and a single async focus trace (read back next frame) are sampled at SampleHz; when it
+ * stops, the last values are stored. When it starts again (ACameraRig::SetCaptureEnabled) the capture is held at the cached exposure for
+ * SeedFrames frames, so adaptation resumes from there, and its focal distance is seeded.
+ * Every activation is timed until the exposure settles; `director.LensCache` prints the cache and time-to-stable
+ * percentiles for seeded vs cold starts.
+ */
+UCLASS()
+class UDirectorLensCache : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorLensCache* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // From ACameraRig::SetCaptureEnabled: before the capture turns off (its view state is still alive) / right after it turns on
+    void NoteCaptureStopping(ACameraRig* Rig);
+    void NoteCaptureStarting(ACameraRig* Rig);
+
+    void PrintCache() const;
+    void Reset();
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+    {
+        return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+    }
+
+private:
+    struct FRigLens
+    {
+        TWeakObjectPtr<ACameraRig> Rig;
+
+        // Cache
+        float EV100 = 0.f;
+        bool bHasExposure = false;
+        float FocusDistance = 0.f;   // 0 = nothing hit
+        double NextSampleTime = 0.0;
+        FTraceHandle FocusTrace;     // in flight until HandleFocusTraceDone
+
+        // Seed hold: the capture's own min / max brightness, restored when it ends
+        int32 SeedFramesLeft = 0;
+        bool bSavedMinOverride = false;
+        bool bSavedMaxOverride = false;
+        float SavedMinBrightness = 0.f;
+        float SavedMaxBrightness = 0.f;
+
+        // Time-to-stable measurement (< 0 = not measuring)
+        double ActivatedTime = -1.0;
+        float LastEV100 = 0.f;
+        int32 StableCount = 0;
+        bool bSeeded = false;
+    };
+
+    static constexpr int32 MaxSamples = 2048;
+
+    void SyncWithRegistry();
+    FRigLens* FindLens(const ACameraRig* Rig);
+
+    // Exposure of the rig's live capture view, as EV100; false while it has none yet
+    static bool ReadExposure(ACameraRig* Rig, float& OutEV100);
+    void Sample(FRigLens& Lens, ACameraRig* Rig);
+    void HandleFocusTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+    void EndSeed(FRigLens& Lens, ACameraRig* Rig);
+    void TickSettle(FRigLens& Lens, ACameraRig* Rig, double Now);
+
+    // Registry-indexed, remapped by rig when the registry generation moves so the cache survives spawns
+    TArray<FRigLens> Lenses;
+    uint32 RegistryGeneration = MAX_uint32;
+
+    TArray<float> SettleMsSeeded;
+    TArray<float> SettleMsCold;
+
+    FTraceDelegate FocusTraceDelegate;
+};
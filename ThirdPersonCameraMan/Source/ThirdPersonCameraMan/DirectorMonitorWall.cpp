@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DirectorMonitorWall.h"
+
+#include "Engine/TextureRenderTarget2D.h"
+#include "Kismet/KismetRenderingLibrary.h"
+
+UTextureRenderTarget2D* FDirectorRenderTargetPool::Acquire(UObject* Outer, int32 Width, int32 Height)
+{
+    for (int32 i = Free.Num() - 1; i >= 0; --i)
+    {
+        UTextureRenderTarget2D* RT = Free[i];
+        if (RT && RT->SizeX == Width && RT->SizeY == Height)
+        {
+            Free.RemoveAtSwap(i, 1, EAllowShrinking::No);
+            return RT;
+        }
+    }
+    return UKismetRenderingLibrary::CreateRenderTarget2D(Outer, Width, Height, ETextureRenderTargetFormat::RTF_RGBA8);
+}
+
+void FDirectorRenderTargetPool::Release(UTextureRenderTarget2D* RT)
+{
+    if (RT)
+    {
+        Free.AddUnique(RT);
+    }
+}
+
+FIntPoint DirectorMonitorWall::ComputeGrid(int32 Count)
+{
+    if (Count <= 0) return FIntPoint(0, 0);
+    const int32 Cols = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+    const int32 Rows = FMath::DivideAndRoundUp(Count, Cols);
+    return FIntPoint(Cols, Rows);
+}
+
+int32 DirectorMonitorWall::QuantizeRTSize(float Pixels)
+{
+    const int32 Rounded = FMath::DivideAndRoundUp(FMath::Max(16, FMath::CeilToInt(Pixels)), 16) * 16;
+    return FMath::Clamp(Rounded, 16, 4096);
+}
+
+void DirectorMonitorWall::ScheduleRates(TArrayView<FMonitorWallTile> Tiles, int32 FocusIndex, float PixelBudgetPerSecond, float FocusedHz, float MaxHz)
+{
+    auto TilePixels = [](const FMonitorWallTile& Tile) -> float
+    {
+        return Tile.RenderTarget ? static_cast<float>(Tile.RenderTarget->SizeX) * Tile.RenderTarget->SizeY : 0.f;
+    };
+
+    float Remaining = FMath::Max(0.f, PixelBudgetPerSecond);
+
+    // Focused tile first: it gets its promoted rate as long as the budget can pay for it
+    if (Tiles.IsValidIndex(FocusIndex))
+    {
+        FMonitorWallTile& Focus = Tiles[FocusIndex];
+        const float Pixels = TilePixels(Focus);
+        if (Focus.bShowsLiveFeed || Pixels <= 0.f)
+        {
+            Focus.RateHz = 0.f;
+        }
+        else
+        {
+            Focus.RateHz = FMath::Min(FocusedHz, Remaining / Pixels);
+            Remaining -= Focus.RateHz * Pixels;
+        }
+    }
+
+    float OtherPixels = 0.f;
+    for (int32 i = 0; i < Tiles.Num(); ++i)
+    {
+        if (i != FocusIndex && !Tiles[i].bShowsLiveFeed)
+        {
+            OtherPixels += TilePixels(Tiles[i]);
+        }
+    }
+
+    const float SharedHz = OtherPixels > 0.f ? FMath::Min(MaxHz, Remaining / OtherPixels) : 0.f;
+    for (int32 i = 0; i < Tiles.Num(); ++i)
+    {
+        if (i == FocusIndex) continue;
+        Tiles[i].RateHz = (Tiles[i].bShowsLiveFeed || TilePixels(Tiles[i]) <= 0.f) ? 0.f : SharedHz;
+    }
+}
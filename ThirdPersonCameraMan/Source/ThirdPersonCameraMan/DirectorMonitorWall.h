@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DirectorMonitorWall.generated.h"
+
+class ACameraRig;
+class UUserWidget;
+class UTextureRenderTarget2D;
+
+// One cell of the viewer monitor wall: a rig feed shown in its own widget
+USTRUCT()
+struct FMonitorWallTile
+{
+    GENERATED_BODY()
+
+    UPROPERTY() TWeakObjectPtr<ACameraRig> Rig;
+    UPROPERTY() UUserWidget* Widget = nullptr;
+
+    // Pooled RT sized to the tile; unused while the tile shows the live (program) rig
+    UPROPERTY() UTextureRenderTarget2D* RenderTarget = nullptr;
+
+    // Scheduled capture rate and phase accumulator (captures fire when >= 1)
+    float RateHz = 0.f;
+    float Accumulator = 0.f;
+
+    // True when the tile binds the rig's own full-rate RT instead of capturing itself
+    bool bShowsLiveFeed = false;
+};
+
+// Small pool of transient render targets keyed by size, so tiles can be rebuilt without reallocating
+USTRUCT()
+struct FDirectorRenderTargetPool
+{
+    GENERATED_BODY()
+
+    UTextureRenderTarget2D* Acquire(UObject* Outer, int32 Width, int32 Height);
+    void Release(UTextureRenderTarget2D* RT);
+    void Reset() { Free.Reset(); }
+
+private:
+    UPROPERTY() TArray<UTextureRenderTarget2D*> Free;
+};
+
+namespace DirectorMonitorWall
+{
+    // Columns x rows for Count tiles, as close to square as possible (wider than tall)
+    FIntPoint ComputeGrid(int32 Count);
+
+    // Tile RT dimension rounded up to a multiple of 16 so neighbouring sizes share pool entries
+    int32 QuantizeRTSize(float Pixels);
+
+    // Distribute a pixels-per-second budget over the tiles. The focused tile is promoted to FocusedHz
+    // (or whatever the budget allows); the rest share what remains evenly per pixel, capped at MaxHz.
+    // Tiles showing the live feed cost nothing extra and get a rate of zero.
+    void ScheduleRates(TArrayView<FMonitorWallTile> Tiles, int32 FocusIndex, float PixelBudgetPerSecond, float FocusedHz, float MaxHz);
+}
@@ -0,0 +1,295 @@
+#include "DirectorOcclusionService.h"
+
+#include "CameraRig.h"
+#include "DirectorGameState.h"
+#include "DirectorRigLOD.h"
+#include "DirectorRigRegistry.h"
+#include "DirectorStats.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorOcclusion, Log, All);
+
+// A batch whose results have not all come back after this many frames is dropped
+static constexpr uint64 BatchTimeoutFrames = 30;
+
+// Ray targets on the subject's cylinder, as (right * radius, up * half height); the first N are used
+static const FVector2f RayPattern[] =
+{
+    { 0.f,   0.f }, { 0.f,  0.8f }, { 0.f, -0.8f }, { -0.7f, 0.2f }, { 0.7f, 0.2f },
+    { -0.5f, 0.6f }, { 0.5f, 0.6f }, { -0.5f, -0.5f }, { 0.5f, -0.5f },
+};
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorOcclusionCommand(
+    TEXT("director.Occlusion"),
+    TEXT("Print the published rig -> subject occlusion ratios"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (const UDirectorOcclusionService* Service = UDirectorOcclusionService::Get(World))
+        {
+            Service->PrintOcclusion();
+        }
+    }));
+
+UDirectorOcclusionService* UDirectorOcclusionService::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorOcclusionService>() : nullptr;
+}
+
+void UDirectorOcclusionService::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<UDirectorRigRegistry>();
+    Super::Initialize(Collection);
+
+    TraceDelegate.BindUObject(this, &UDirectorOcclusionService::HandleTraceDone);
+
+    // Slot 0 is reserved for the operator pawn
+    Subjects.SetNum(1);
+    SubjectParams.SetNum(1);
+    SetSubjectParams(0);
+}
+
+TStatId UDirectorOcclusionService::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDirectorOcclusionService, STATGROUP_Tickables);
+}
+
+int32 UDirectorOcclusionService::TrackSubject(AActor* Subject)
+{
+    if (!Subject) return INDEX_NONE;
+
+    const int32 Existing = GetSubjectIndex(Subject);
+    if (Existing != INDEX_NONE) return Existing;
+
+    const int32 Index = Subjects.Add(Subject);
+    SubjectParams.AddDefaulted();
+    SetSubjectParams(Index);
+    bLayoutDirty = true;
+    return Index;
+}
+
+void UDirectorOcclusionService::UntrackSubject(AActor* Subject)
+{
+    const int32 Index = GetSubjectIndex(Subject);
+    if (Index <= 0) return;   // the operator slot stays
+
+    Subjects.RemoveAt(Index);
+    SubjectParams.RemoveAt(Index);
+    bLayoutDirty = true;
+}
+
+int32 UDirectorOcclusionService::GetSubjectIndex(const AActor* Subject) const
+{
+    if (!Subject) return INDEX_NONE;
+    for (int32 i = 0; i < Subjects.Num(); ++i)
+    {
+        if (Subjects[i].Get() == Subject) return i;
+    }
+    return INDEX_NONE;
+}
+
+bool UDirectorOcclusionService::GetOcclusion(const ACameraRig* Rig, const AActor* Subject, float& OutOcclusion) const
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Registry || Registry->GetGeneration() != RegistryGeneration || bLayoutDirty) return false;
+
+    const float Value = GetOcclusionAt(Registry->IndexOf(Rig), GetSubjectIndex(Subject));
+    if (Value < 0.f) return false;
+
+    OutOcclusion = Value;
+    return true;
+}
+
+float UDirectorOcclusionService::GetOcclusionAt(int32 RigIndex, int32 SubjectIndex) const
+{
+    if (bLayoutDirty || RigIndex < 0 || !Subjects.IsValidIndex(SubjectIndex)) return -1.f;
+
+    const int32 Entry = EntryIndex(RigIndex, SubjectIndex);
+    return Published.IsValidIndex(Entry) ? Published[Entry] : -1.f;
+}
+
+void UDirectorOcclusionService::PrintOcclusion() const
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Registry || Registry->GetGeneration() != RegistryGeneration) return;
+
+    const TArray<ACameraRig*>& Rigs = Registry->GetRigs();
+    UE_LOG(LogDirectorOcclusion, Display, TEXT("Occlusion (%d rigs x %d subjects, %u batches published):"), Rigs.Num(), Subjects.Num(), PublishCount);
+    for (int32 r = 0; r < Rigs.Num(); ++r)
+    {
+        for (int32 s = 0; s < Subjects.Num(); ++s)
+        {
+            const float Value = GetOcclusionAt(r, s);
+            if (Value < 0.f) continue;
+            UE_LOG(LogDirectorOcclusion, Display, TEXT("  %-24s -> %-24s %3.0f%% blocked"), *GetNameSafe(Rigs[r]), *GetNameSafe(Subjects[s].Get()), Value * 100.f);
+        }
+    }
+}
+
+// Each subject ignores only itself, so other tracked actors (the operator's body included) still occlude
+void UDirectorOcclusionService::SetSubjectParams(int32 SubjectIndex)
+{
+    FCollisionQueryParams& Params = SubjectParams[SubjectIndex];
+    Params = FCollisionQueryParams(SCENE_QUERY_STAT(DirectorOcclusion), false);
+    if (const AActor* Subject = Subjects[SubjectIndex].Get())
+    {
+        Params.AddIgnoredActor(Subject);
+    }
+}
+
+// The operator can change (or respawn) at any time; works on clients through the replicated operator PlayerState
+void UDirectorOcclusionService::SyncOperatorSubject()
+{
+    const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    AActor* OperatorPawn = (GS && GS->OperatorPlayerState) ? GS->OperatorPlayerState->GetPawn() : nullptr;
+    if (Subjects[0].Get() == OperatorPawn) return;
+
+    Subjects[0] = OperatorPawn;
+    SetSubjectParams(0);
+    bLayoutDirty = true;
+}
+
+// Registry indices or the subject list moved: forget everything and drop the in-flight batch
+void UDirectorOcclusionService::ResetLayout()
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    RegistryGeneration = Registry ? Registry->GetGeneration() : 0;
+
+    const int32 NumEntries = (Registry ? Registry->GetRigs().Num() : 0) * Subjects.Num();
+    Published.Init(-1.f, NumEntries);
+    PendingBlocked.Init(0, NumEntries);
+    PendingRays.Init(0, NumEntries);
+    BatchEntries.Reset();
+    BatchRayEntry.Reset();
+
+    ++BatchId;
+    bBatchInFlight = false;
+    RigCursor = 0;
+    bLayoutDirty = false;
+}
+
+void UDirectorOcclusionService::Tick(float DeltaTime)
+{
+    const UDirectorOcclusionSettings* Settings = GetDefault<UDirectorOcclusionSettings>();
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Settings->bEnabled || !Registry) return;
+
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorOcclusion);
+
+    SyncOperatorSubject();
+    if (bLayoutDirty || Registry->GetGeneration() != RegistryGeneration)
+    {
+        ResetLayout();
+    }
+
+    if (bBatchInFlight)
+    {
+        if (BatchRaysReturned >= BatchRaysIssued)
+        {
+            PublishBatch();
+        }
+        else if (GFrameCounter - LastIssueFrame > BatchTimeoutFrames)
+        {
+            UE_LOG(LogDirectorOcclusion, Verbose, TEXT("Batch %u timed out (%d/%d rays back)"), BatchId, BatchRaysReturned, BatchRaysIssued);
+            ResetLayout();
+        }
+    }
+
+    if (!bBatchInFlight && GFrameCounter - LastIssueFrame >= static_cast<uint64>(Settings->IntervalFrames))
+    {
+        IssueBatch();
+    }
+}
+
+void UDirectorOcclusionService::IssueBatch()
+{
+    const UDirectorOcclusionSettings* Settings = GetDefault<UDirectorOcclusionSettings>();
+    const TArray<ACameraRig*>& Rigs = UDirectorRigRegistry::Get(this)->GetRigs();
+    const int32 NumRigs = Rigs.Num();
+    const int32 NumSubjects = Subjects.Num();
+    if (NumRigs == 0) return;
+
+    UWorld* World = GetWorld();
+    const UDirectorRigLOD* LOD = UDirectorRigLOD::Get(this);
+    const int32 RaysPerSubject = FMath::Clamp(Settings->RaysPerSubject, 1, static_cast<int32>(UE_ARRAY_COUNT(RayPattern)));
+    const int32 RigsPerBatch = FMath::Clamp(Settings->MaxRaysPerBatch / (RaysPerSubject * NumSubjects), 1, NumRigs);
+
+    ++BatchId;
+    BatchEntries.Reset();
+    BatchRayEntry.Reset();
+    BatchRaysReturned = 0;
+
+    for (int32 k = 0; k < RigsPerBatch; ++k)
+    {
+        const int32 r = (RigCursor + k) % NumRigs;
+        const ACameraRig* Rig = Rigs[r];
+        const USceneComponent* Lens = Rig ? Rig->SceneCapture : nullptr;
+        if (!Lens || (LOD && LOD->IsDormantAt(r))) continue;
+
+        const FVector Start = Lens->GetComponentLocation();
+        const AActor* Carrier = Rig->GetAttachParentActor();
+
+        for (int32 s = 0; s < NumSubjects; ++s)
+        {
+            const AActor* Subject = Subjects[s].Get();
+            if (!Subject || Subject == Carrier) continue;   // a lens on the subject's head can't be blocked from it
+
+            float Radius = 0.f, HalfHeight = 0.f;
+            Subject->GetSimpleCollisionCylinder(Radius, HalfHeight);
+            const FVector Centre = Subject->GetActorLocation();
+            const FVector Right = FVector::CrossProduct(FVector::UpVector, Centre - Start).GetSafeNormal2D();
+
+            const int32 Entry = EntryIndex(r, s);
+            PendingBlocked[Entry] = 0;
+            PendingRays[Entry] = static_cast<uint16>(RaysPerSubject);
+            BatchEntries.Add(Entry);
+
+            for (int32 Ray = 0; Ray < RaysPerSubject; ++Ray)
+            {
+                const FVector End = Centre + Right * (RayPattern[Ray].X * Radius) + FVector::UpVector * (RayPattern[Ray].Y * HalfHeight);
+
+                // Batch id in the top byte so results from a dropped batch are ignored
+                const uint32 UserData = (static_cast<uint32>(BatchId) << 24) | static_cast<uint32>(BatchRayEntry.Num());
+                BatchRayEntry.Add(Entry);
+                World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Settings->TraceChannel, SubjectParams[s],
+                    FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, UserData);
+            }
+        }
+    }
+
+    RigCursor = (RigCursor + RigsPerBatch) % NumRigs;
+    BatchRaysIssued = BatchRayEntry.Num();
+    bBatchInFlight = BatchRaysIssued > 0;
+    LastIssueFrame = GFrameCounter;
+    INC_DWORD_STAT_BY(STAT_DirectorOcclusionRays, BatchRaysIssued);
+}
+
+// Results arrive at the start of the next frame; they only become visible to readers here, all at once
+void UDirectorOcclusionService::PublishBatch()
+{
+    for (const int32 Entry : BatchEntries)
+    {
+        Published[Entry] = PendingRays[Entry] > 0 ? static_cast<float>(PendingBlocked[Entry]) / PendingRays[Entry] : -1.f;
+    }
+    bBatchInFlight = false;
+    ++PublishCount;
+}
+
+void UDirectorOcclusionService::HandleTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+    if (!bBatchInFlight || (Datum.UserData >> 24) != BatchId) return;
+
+    const int32 Ray = static_cast<int32>(Datum.UserData & 0xFFFFFF);
+    if (!BatchRayEntry.IsValidIndex(Ray)) return;
+
+    if (Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit)
+    {
+        ++PendingBlocked[BatchRayEntry[Ray]];
+    }
+    ++BatchRaysReturned;
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "DirectorOcclusionService.generated.h"
+
+class ACameraRig;
+
+// Ray pattern and pacing for the occlusion service ([/Script/ThirdPersonCameraMan.DirectorOcclusionSettings] in DefaultGame.ini)
+UCLASS(config=Game, defaultconfig)
+class UDirectorOcclusionSettings : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(config, EditAnywhere, Category="Occlusion") bool bEnabled = true;
+
+    // A new batch goes out this many frames after the previous one was issued (never while one is in flight)
+    UPROPERTY(config, EditAnywhere, Category="Occlusion", meta=(ClampMin=1)) int32 IntervalFrames = 3;
+
+    // Rays per rig/subject pair, spread over the subject's collision cylinder (centre, head, feet, sides, diagonals)
+    UPROPERTY(config, EditAnywhere, Category="Occlusion", meta=(ClampMin=1, ClampMax=9)) int32 RaysPerSubject = 5;
+
+    // Upper bound on rays per batch; rigs beyond it are covered round-robin by the next batches
+    UPROPERTY(config, EditAnywhere, Category="Occlusion", meta=(ClampMin=1)) int32 MaxRaysPerBatch = 256;
+
+    UPROPERTY(config, EditAnywhere, Category="Occlusion") TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+};
+
+/**
+ * How much of each tracked subject every rig can see, on any machine.
+ * Every IntervalFrames frames a batch of multi-ray async line traces goes out from rig lenses
+ * (round-robin under a ray budget) toward points on each subject's collision cylinder. Results land in a pending
+ * buffer and are published in one go on the tick after the whole batch returned, so readers never see half a batch.
+ * Nothing here traces synchronously. The operator pawn is always tracked; other systems may add subjects.
+ * `director.Occlusion` prints the published ratios.
+ */
+UCLASS()
+class UDirectorOcclusionService : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorOcclusionService* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Extra subjects (the operator pawn is tracked automatically). Returns the subject's index
+    int32 TrackSubject(AActor* Subject);
+    void UntrackSubject(AActor* Subject);
+    int32 GetSubjectIndex(const AActor* Subject) const;
+
+    // Fraction of rays from Rig to Subject that were blocked (0 = clear, 1 = fully hidden); false until measured
+    bool GetOcclusion(const ACameraRig* Rig, const AActor* Subject, float& OutOcclusion) const;
+
+    // Same by registry index / subject index; -1 when not measured. Only valid while the registry generation is unchanged
+    float GetOcclusionAt(int32 RigIndex, int32 SubjectIndex) const;
+    uint32 GetRegistryGeneration() const { return RegistryGeneration; }
+
+    // Bumped every time a batch is published
+    uint32 GetPublishCount() const { return PublishCount; }
+
+    void PrintOcclusion() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+    {
+        return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+    }
+
+private:
+    void SyncOperatorSubject();
+    void SetSubjectParams(int32 SubjectIndex);
+    void ResetLayout();
+    void IssueBatch();
+    void PublishBatch();
+    void HandleTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+    int32 EntryIndex(int32 RigIndex, int32 SubjectIndex) const { return RigIndex * Subjects.Num() + SubjectIndex; }
+
+    // Subject 0 is always the operator pawn slot (may be empty)
+    TArray<TWeakObjectPtr<AActor>> Subjects;
+    TArray<FCollisionQueryParams> SubjectParams;   // per subject: ignores only that subject
+
+    // Published results, [RigIndex * NumSubjects + SubjectIndex]; -1 = not measured
+    TArray<float> Published;
+
+    // In-flight batch
+    TArray<uint16> PendingBlocked;
+    TArray<uint16> PendingRays;
+    TArray<int32> BatchEntries;      // entries touched by the batch
+    TArray<int32> BatchRayEntry;     // ray index -> entry
+    int32 BatchRaysIssued = 0;
+    int32 BatchRaysReturned = 0;
+    uint8 BatchId = 0;
+    bool bBatchInFlight = false;
+
+    uint32 RegistryGeneration = MAX_uint32;
+    bool bLayoutDirty = true;
+    int32 RigCursor = 0;
+    uint64 LastIssueFrame = 0;
+    uint32 PublishCount = 0;
+
+    FTraceDelegate TraceDelegate;
+};
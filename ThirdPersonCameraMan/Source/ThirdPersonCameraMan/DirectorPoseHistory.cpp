@@ -0,0 +1,59 @@
+#include "DirectorPoseHistory.h"
+
+// Below these the pose counts as unchanged (cm, radians)
+static constexpr float LocationTolerance = 0.01f;
+static constexpr float RotationTolerance = 1.e-4f;
+
+bool FDirectorPoseHistory::AddSample(double Time, const FVector& Location, const FQuat& Rotation)
+{
+    if (Count > 0)
+    {
+        const int32 Newest = Slot(0);
+        if (Locations[Newest].Equals(Location, LocationTolerance) && Rotations[Newest].Equals(Rotation, RotationTolerance))
+        {
+            return false;
+        }
+    }
+
+    Locations[Head] = Location;
+    Rotations[Head] = Rotation;
+    Times[Head] = Time;
+    Head = (Head + 1) % Capacity;
+    Count = FMath::Min(Count + 1, Capacity);
+    return true;
+}
+
+double FDirectorPoseHistory::GetSampleInterval() const
+{
+    return Count > 1 ? (Times[Slot(0)] - Times[Slot(Count - 1)]) / (Count - 1) : 0.0;
+}
+
+bool FDirectorPoseHistory::Evaluate(double Time, FVector& OutLocation, FQuat& OutRotation) const
+{
+    if (Count == 0) return false;
+
+    // Walk from the newest back to the first sample at or before Time
+    for (int32 Age = 0; Age < Count; ++Age)
+    {
+        const int32 Older = Slot(Age);
+        if (Times[Older] > Time) continue;
+
+        if (Age == 0)
+        {
+            break;   // past the newest sample: hold it
+        }
+
+        const int32 Newer = Slot(Age - 1);
+        const double Span = Times[Newer] - Times[Older];
+        const float Alpha = Span > 0.0 ? static_cast<float>((Time - Times[Older]) / Span) : 1.f;
+        OutLocation = FMath::Lerp(Locations[Older], Locations[Newer], Alpha);
+        OutRotation = FQuat::Slerp(Rotations[Older], Rotations[Newer], Alpha);
+        return true;
+    }
+
+    // Newer than everything (hold newest) or older than everything (clamp to oldest)
+    const int32 Held = Times[Slot(0)] <= Time ? Slot(0) : Slot(Count - 1);
+    OutLocation = Locations[Held];
+    OutRotation = Rotations[Held];
+    return true;
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Short ring of timestamped poses for sub-tick interpolation.
+ * Only pose changes are recorded, so the sample spacing is the rate the pose source actually updates at
+ * (a 30 Hz server replicating rig movement, a throttled pawn) rather than the local frame rate.
+ */
+struct FDirectorPoseHistory
+{
+    static constexpr int32 Capacity = 8;
+
+    // Records the pose if it moved since the newest sample; returns true when a sample was added
+    bool AddSample(double Time, const FVector& Location, const FQuat& Rotation);
+
+    // Mean spacing of the recorded samples (0 with fewer than two)
+    double GetSampleInterval() const;
+
+    // Pose at Time: lerp / slerp between the bracketing samples, clamped to the oldest / newest
+    bool Evaluate(double Time, FVector& OutLocation, FQuat& OutRotation) const;
+
+    void Reset() { Head = 0; Count = 0; }
+    int32 Num() const { return Count; }
+
+private:
+    int32 Slot(int32 AgeIndex) const { return (Head + Capacity - 1 - AgeIndex) % Capacity; }   // 0 = newest
+
+    FVector Locations[Capacity];
+    FQuat Rotations[Capacity];
+    double Times[Capacity] = {};
+    int32 Head = 0;
+    int32 Count = 0;
+};
@@ -0,0 +1,369 @@
+#include "DirectorRigLOD.h"
+
+#include "DirectorGameState.h"
+#include "DirectorMonitorWall.h"
+#include "DirectorRigRegistry.h"
+#include "DirectorStats.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Components/SphereComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorRigLOD, Log, All);
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorRigLODCommand(
+    TEXT("director.RigLOD"),
+    TEXT("Print every rig's LOD tier"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (const UDirectorRigLOD* LOD = UDirectorRigLOD::Get(World))
+        {
+            LOD->PrintTiers();
+        }
+    }));
+
+UDirectorRigLODSettings::UDirectorRigLODSettings()
+{
+    Program.NetUpdateFrequency = 30.f;
+
+    Preview.CaptureHz = 2.f;
+    Preview.ResolutionScale = 0.5f;
+    Preview.CaptureProfile.MaxViewDistance = 8000.f;
+    Preview.NetUpdateFrequency = 10.f;
+
+    Standby.ResolutionScale = 0.5f;
+    Standby.NetUpdateFrequency = 2.f;
+
+    Dormant.ResolutionScale = 0.25f;
+    Dormant.NetUpdateFrequency = 0.5f;
+    Dormant.bOverlapTriggers = false;
+}
+
+const FDirectorRigTierSettings& UDirectorRigLODSettings::GetTier(EDirectorRigTier Tier) const
+{
+    switch (Tier)
+    {
+    case EDirectorRigTier::Program: return Program;
+    case EDirectorRigTier::Preview: return Preview;
+    case EDirectorRigTier::Standby: return Standby;
+    default:                        return Dormant;
+    }
+}
+
+UDirectorRigLOD* UDirectorRigLOD::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorRigLOD>() : nullptr;
+}
+
+void UDirectorRigLOD::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<UDirectorRigRegistry>();
+    Super::Initialize(Collection);
+}
+
+TStatId UDirectorRigLOD::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDirectorRigLOD, STATGROUP_Tickables);
+}
+
+uint32 UDirectorRigLOD::CurrentRegistryGeneration() const
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    return Registry ? Registry->GetGeneration() : MAX_uint32;
+}
+
+FIntPoint UDirectorRigLOD::CellOf(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UDirectorRigLOD::AddToCell(int32 RigIndex, const FIntPoint& Cell)
+{
+    Cells.FindOrAdd(Cell).Add(RigIndex);
+    RigCells[RigIndex] = Cell;
+}
+
+void UDirectorRigLOD::RemoveFromCell(int32 RigIndex, const FIntPoint& Cell)
+{
+    if (TArray<int32>* Bucket = Cells.Find(Cell))
+    {
+        Bucket->RemoveSingleSwap(RigIndex, EAllowShrinking::No);
+    }
+}
+
+// Registry indices moved: rebuild the grid, keep each rig's tier and full RT size, and evaluate everything once
+void UDirectorRigLOD::SyncWithRegistry()
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Registry || Registry->GetGeneration() == RegistryGeneration) return;
+
+    RegistryGeneration = Registry->GetGeneration();
+    const TArray<ACameraRig*>& Rigs = Registry->GetRigs();
+    const int32 Num = Rigs.Num();
+    const UDirectorRigLODSettings* Settings = GetDefault<UDirectorRigLODSettings>();
+    CellSize = Settings->StandbyRadius * (1.f + Settings->Hysteresis);
+
+    TArray<TWeakObjectPtr<ACameraRig>> OldRigs = MoveTemp(SlotRigs);
+    TArray<EDirectorRigTier> OldTiers = MoveTemp(Tiers);
+    TArray<FIntPoint> OldSizes = MoveTemp(FullSizes);
+
+    SlotRigs.SetNum(Num);
+    Tiers.Init(EDirectorRigTier::Count, Num);
+    FullSizes.Init(FIntPoint::ZeroValue, Num);
+    RigCells.SetNum(Num);
+    CaptureAccumulators.Init(0.f, Num);
+    bAwake.Init(1, Num);
+    Awake.Reset(Num);
+    Cells.Reset();
+
+    for (int32 i = 0; i < Num; ++i)
+    {
+        ACameraRig* Rig = Rigs[i];
+        SlotRigs[i] = Rig;
+        Awake.Add(i);
+
+        const int32 Old = OldRigs.IndexOfByPredicate([Rig](const TWeakObjectPtr<ACameraRig>& Slot) { return Slot.Get() == Rig; });
+        if (Old != INDEX_NONE)
+        {
+            Tiers[i] = OldTiers[Old];
+            FullSizes[i] = OldSizes[Old];
+        }
+        else if (Rig && Rig->RenderTarget)
+        {
+            FullSizes[i] = FIntPoint(Rig->RenderTarget->SizeX, Rig->RenderTarget->SizeY);
+        }
+
+        AddToCell(i, Rig ? CellOf(Rig->GetActorLocation()) : FIntPoint::ZeroValue);
+    }
+}
+
+EDirectorRigTier UDirectorRigLOD::Evaluate(int32 RigIndex, const ACameraRig* LiveRig, TConstArrayView<FVector> Interest) const
+{
+    const ACameraRig* Rig = SlotRigs[RigIndex].Get();
+    if (!Rig) return EDirectorRigTier::Dormant;
+    if (Rig == LiveRig || Rig->IsCapturing() || Cast<APawn>(Rig->GetAttachParentActor()))
+    {
+        return EDirectorRigTier::Program;
+    }
+
+    double DistSq = TNumericLimits<double>::Max();
+    const FVector Location = Rig->GetActorLocation();
+    for (const FVector& Point : Interest)
+    {
+        DistSq = FMath::Min(DistSq, FVector::DistSquared(Location, Point));
+    }
+
+    // Hysteresis: a rig already at (or above) a tier keeps it out to the widened radius
+    const UDirectorRigLODSettings* Settings = GetDefault<UDirectorRigLODSettings>();
+    const EDirectorRigTier Current = Tiers[RigIndex];
+    auto Within = [&](float Radius, EDirectorRigTier Tier)
+    {
+        const double R = Current <= Tier ? Radius * (1.f + Settings->Hysteresis) : Radius;
+        return DistSq <= R * R;
+    };
+
+    if (Within(Settings->PreviewRadius, EDirectorRigTier::Preview)) return EDirectorRigTier::Preview;
+    if (Within(Settings->StandbyRadius, EDirectorRigTier::Standby)) return EDirectorRigTier::Standby;
+    return EDirectorRigTier::Dormant;
+}
+
+// Only runs when the tier changes
+void UDirectorRigLOD::ApplyTier(int32 RigIndex, EDirectorRigTier NewTier)
+{
+    Tiers[RigIndex] = NewTier;
+    CaptureAccumulators[RigIndex] = 0.f;
+    ACameraRig* Rig = SlotRigs[RigIndex].Get();
+    if (!Rig) return;
+
+    const FDirectorRigTierSettings& Tier = GetDefault<UDirectorRigLODSettings>()->GetTier(NewTier);
+    if (Rig->HasAuthority())
+    {
+        Rig->SetNetUpdateFrequency(Tier.NetUpdateFrequency);
+    }
+
+    // Out of the physics scene entirely, not just without overlap events
+    const ECollisionEnabled::Type TriggerCollision = Tier.bOverlapTriggers ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision;
+    if (Rig->PawnTrigger) Rig->PawnTrigger->SetCollisionEnabled(TriggerCollision);
+    if (Rig->CameraSwitchTrigger) Rig->CameraSwitchTrigger->SetCollisionEnabled(TriggerCollision);
+
+    // A capturing rig keeps its size; NoteCaptureStarting restores full size before any every-frame capture
+    UTextureRenderTarget2D* RT = Rig->RenderTarget;
+    const FIntPoint Full = FullSizes[RigIndex];
+    if (RT && Full.X > 0 && !Rig->IsCapturing() && GetWorld()->GetNetMode() != NM_DedicatedServer)
+    {
+        const int32 Width = Tier.ResolutionScale < 1.f ? DirectorMonitorWall::QuantizeRTSize(Full.X * Tier.ResolutionScale) : Full.X;
+        const int32 Height = Tier.ResolutionScale < 1.f ? DirectorMonitorWall::QuantizeRTSize(Full.Y * Tier.ResolutionScale) : Full.Y;
+        if (RT->SizeX != Width || RT->SizeY != Height)
+        {
+            RT->ResizeTarget(Width, Height);
+        }
+    }
+}
+
+void UDirectorRigLOD::Wake(int32 RigIndex)
+{
+    if (!bAwake[RigIndex])
+    {
+        bAwake[RigIndex] = 1;
+        Awake.Add(RigIndex);
+    }
+}
+
+void UDirectorRigLOD::IssueTierCapture(ACameraRig* Rig, const FDirectorRigTierSettings& Tier)
+{
+    USceneCaptureComponent2D* Capture = Rig->SceneCapture;
+    if (!Capture || !Rig->RenderTarget) return;
+
+    // CaptureScene reads the component when it enqueues, so the profile can be put back right after
+    const float SavedFOV = Capture->FOVAngle;
+    const float SavedDistance = Capture->MaxViewDistanceOverride;
+    if (Tier.CaptureProfile.FOVAngle > 0.f) Capture->FOVAngle = Tier.CaptureProfile.FOVAngle;
+    if (Tier.CaptureProfile.MaxViewDistance > 0.f) Capture->MaxViewDistanceOverride = Tier.CaptureProfile.MaxViewDistance;
+    Rig->CaptureInto(Rig->RenderTarget);
+    Capture->FOVAngle = SavedFOV;
+    Capture->MaxViewDistanceOverride = SavedDistance;
+}
+
+void UDirectorRigLOD::NoteCaptureStarting(ACameraRig* Rig)
+{
+    if (!GetDefault<UDirectorRigLODSettings>()->bEnabled) return;
+
+    SyncWithRegistry();
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    const int32 Index = Registry ? Registry->IndexOf(Rig) : INDEX_NONE;
+    if (!Tiers.IsValidIndex(Index)) return;
+
+    UTextureRenderTarget2D* RT = Rig->RenderTarget;
+    const FIntPoint Full = FullSizes[Index];
+    if (RT && Full.X > 0 && (RT->SizeX != Full.X || RT->SizeY != Full.Y))
+    {
+        RT->ResizeTarget(Full.X, Full.Y);
+    }
+    if (Tiers[Index] != EDirectorRigTier::Program)
+    {
+        ApplyTier(Index, EDirectorRigTier::Program);
+    }
+    Wake(Index);
+}
+
+void UDirectorRigLOD::Tick(float DeltaTime)
+{
+    const UDirectorRigLODSettings* Settings = GetDefault<UDirectorRigLODSettings>();
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Settings->bEnabled || !Registry) return;
+
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorRigLOD);
+    SyncWithRegistry();
+    if (SlotRigs.Num() == 0) return;
+
+    // Points of interest: the operator and the live rig
+    const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    const ACameraRig* LiveRig = GS ? GS->ActiveCamera : nullptr;
+    TArray<FVector, TInlineAllocator<2>> Interest;
+    if (const APawn* Operator = GS && GS->OperatorPlayerState ? GS->OperatorPlayerState->GetPawn() : nullptr)
+    {
+        Interest.Add(Operator->GetActorLocation());
+    }
+    if (LiveRig)
+    {
+        Interest.Add(LiveRig->GetActorLocation());
+    }
+
+    // Candidates: everything awake, plus sleeping rigs in the 3x3 cells around each point (cells span the standby radius)
+    TArray<int32, TInlineAllocator<64>> Candidates(Awake);
+    for (const FVector& Point : Interest)
+    {
+        const FIntPoint Centre = CellOf(Point);
+        for (int32 dy = -1; dy <= 1; ++dy)
+        {
+            for (int32 dx = -1; dx <= 1; ++dx)
+            {
+                const TArray<int32>* Bucket = Cells.Find(Centre + FIntPoint(dx, dy));
+                if (!Bucket) continue;
+                for (const int32 i : *Bucket)
+                {
+                    if (!bAwake[i])
+                    {
+                        bAwake[i] = 1;
+                        Candidates.Add(i);
+                    }
+                }
+            }
+        }
+    }
+    SET_DWORD_STAT(STAT_DirectorRigLODEvaluated, Candidates.Num());
+
+    const bool bCanCapture = GetWorld()->GetNetMode() != NM_DedicatedServer;
+    Awake.Reset();
+    for (const int32 i : Candidates)
+    {
+        ACameraRig* Rig = SlotRigs[i].Get();
+
+        // Awake rigs may move (carried, scripted); keep their cell current
+        if (Rig)
+        {
+            const FIntPoint Cell = CellOf(Rig->GetActorLocation());
+            if (Cell != RigCells[i])
+            {
+                RemoveFromCell(i, RigCells[i]);
+                AddToCell(i, Cell);
+            }
+        }
+
+        const EDirectorRigTier NewTier = Evaluate(i, LiveRig, Interest);
+        if (NewTier != Tiers[i])
+        {
+            ApplyTier(i, NewTier);
+        }
+
+        if (NewTier == EDirectorRigTier::Dormant)
+        {
+            bAwake[i] = 0;
+            continue;
+        }
+        Awake.Add(i);
+
+        const FDirectorRigTierSettings& Tier = Settings->GetTier(NewTier);
+        if (bCanCapture && Rig && Tier.CaptureHz > 0.f && !Rig->IsCapturing())
+        {
+            CaptureAccumulators[i] += DeltaTime * Tier.CaptureHz;
+            if (CaptureAccumulators[i] >= 1.f)
+            {
+                CaptureAccumulators[i] = FMath::Fmod(CaptureAccumulators[i], 1.f);
+                IssueTierCapture(Rig, Tier);
+            }
+        }
+    }
+}
+
+EDirectorRigTier UDirectorRigLOD::GetTier(const ACameraRig* Rig) const
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    const int32 Index = Registry && Registry->GetGeneration() == RegistryGeneration ? Registry->IndexOf(Rig) : INDEX_NONE;
+    return Tiers.IsValidIndex(Index) ? Tiers[Index] : EDirectorRigTier::Count;
+}
+
+void UDirectorRigLOD::PrintTiers() const
+{
+    int32 Counts[static_cast<int32>(EDirectorRigTier::Count) + 1] = {};
+    for (const EDirectorRigTier Tier : Tiers)
+    {
+        ++Counts[static_cast<int32>(Tier)];
+    }
+    UE_LOG(LogDirectorRigLOD, Display, TEXT("Rig LOD: %d program, %d preview, %d standby, %d dormant (%d awake)"),
+        Counts[0], Counts[1], Counts[2], Counts[3], Awake.Num());
+
+    for (int32 i = 0; i < SlotRigs.Num(); ++i)
+    {
+        const ACameraRig* Rig = SlotRigs[i].Get();
+        const UTextureRenderTarget2D* RT = Rig ? Rig->RenderTarget : nullptr;
+        UE_LOG(LogDirectorRigLOD, Display, TEXT("  %-24s %-8s RT %4dx%-4d"), *GetNameSafe(Rig),
+            Tiers[i] == EDirectorRigTier::Count ? TEXT("-") : *UEnum::GetDisplayValueAsText(Tiers[i]).ToString(),
+            RT ? RT->SizeX : 0, RT ? RT->SizeY : 0);
+    }
+}
@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CameraRig.h"
+#include "DirectorRigLOD.generated.h"
+
+// How interesting a rig is right now, most to least
+UENUM(BlueprintType)
+enum class EDirectorRigTier : uint8
+{
+    Program,    // live, carried, or capturing every frame (pre-warmed)
+    Preview,    // close to the action: periodic low-rate captures keep its feed recent
+    Standby,    // could be bumped into soon: triggers on, no captures
+    Dormant,    // far away: no triggers, no captures, minimal net updates, smallest RT
+    Count UMETA(Hidden)
+};
+
+// What a tier costs
+USTRUCT(BlueprintType)
+struct FDirectorRigTierSettings
+{
+    GENERATED_BODY()
+
+    // Periodic captures into the rig's own RT (0 = none). Program rigs capture every frame regardless
+    UPROPERTY(EditAnywhere, Category="Tier", meta=(ClampMin=0, ClampMax=60)) float CaptureHz = 0.f;
+
+    // RT size relative to the rig's own while not capturing every frame (full size is restored on capture start)
+    UPROPERTY(EditAnywhere, Category="Tier", meta=(ClampMin=0.0625, ClampMax=1)) float ResolutionScale = 1.f;
+
+    // Applied only for this tier's periodic captures (0 fields keep the rig's own)
+    UPROPERTY(EditAnywhere, Category="Tier") FDirectorCaptureProfile CaptureProfile;
+
+    // Server: actor net update rate for the rig
+    UPROPERTY(EditAnywhere, Category="Tier", meta=(ClampMin=0.1)) float NetUpdateFrequency = 10.f;
+
+    // Pickup / switch triggers take part in overlaps at all
+    UPROPERTY(EditAnywhere, Category="Tier") bool bOverlapTriggers = true;
+};
+
+// Tier radii and costs ([/Script/ThirdPersonCameraMan.DirectorRigLODSettings] in DefaultGame.ini)
+UCLASS(config=Game, defaultconfig)
+class UDirectorRigLODSettings : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UDirectorRigLODSettings();
+
+    UPROPERTY(config, EditAnywhere, Category="LOD") bool bEnabled = true;
+
+    // Distance from the nearest point of interest (operator pawn, live rig) within which a rig is Preview / Standby
+    UPROPERTY(config, EditAnywhere, Category="LOD", meta=(ClampMin=100)) float PreviewRadius = 1500.f;
+    UPROPERTY(config, EditAnywhere, Category="LOD", meta=(ClampMin=100)) float StandbyRadius = 5000.f;
+
+    // A rig only drops to a lower tier once it is this fraction beyond the radius, so tiers don't flicker on the edge
+    UPROPERTY(config, EditAnywhere, Category="LOD", meta=(ClampMin=0, ClampMax=1)) float Hysteresis = 0.1f;
+
+    UPROPERTY(config, EditAnywhere, Category="LOD") FDirectorRigTierSettings Program;
+    UPROPERTY(config, EditAnywhere, Category="LOD") FDirectorRigTierSettings Preview;
+    UPROPERTY(config, EditAnywhere, Category="LOD") FDirectorRigTierSettings Standby;
+    UPROPERTY(config, EditAnywhere, Category="LOD") FDirectorRigTierSettings Dormant;
+
+    const FDirectorRigTierSettings& GetTier(EDirectorRigTier Tier) const;
+};
+
+/**
+ * Assigns every rig a tier (program, preview, standby, dormant) and applies what the tier costs: periodic capture
+ * rate and profile, RT resolution, net update rate and whether its overlap triggers exist in the physics scene.
+ * Rigs are bucketed in a 2D grid with StandbyRadius cells. Each tick only evaluates the awake rigs (any tier
+ * above dormant) plus the cells around the points of interest, so dormant rigs far from the action cost nothing
+ * and the total scales with the rigs that matter. Dormant rigs are assumed not to move on their own (a carried
+ * rig is program). Capture start (ACameraRig::SetCaptureEnabled) promotes a rig to program immediately.
+ * The auto-director and occlusion service skip dormant rigs. `director.RigLOD` prints the tiers.
+ */
+UCLASS()
+class UDirectorRigLOD : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorRigLOD* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // From ACameraRig::SetCaptureEnabled, before the first capture: full-size RT, program tier
+    void NoteCaptureStarting(ACameraRig* Rig);
+
+    EDirectorRigTier GetTier(const ACameraRig* Rig) const;
+    // Registry index lookup for per-rig loops; false whenever the registry moved since the last tick
+    bool IsDormantAt(int32 RigIndex) const
+    {
+        return RegistryGeneration == CurrentRegistryGeneration() && Tiers.IsValidIndex(RigIndex) && Tiers[RigIndex] == EDirectorRigTier::Dormant;
+    }
+
+    void PrintTiers() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+    {
+        return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+    }
+
+private:
+    uint32 CurrentRegistryGeneration() const;
+    void SyncWithRegistry();
+    FIntPoint CellOf(const FVector& Location) const;
+    void AddToCell(int32 RigIndex, const FIntPoint& Cell);
+    void RemoveFromCell(int32 RigIndex, const FIntPoint& Cell);
+
+    EDirectorRigTier Evaluate(int32 RigIndex, const ACameraRig* LiveRig, TConstArrayView<FVector> Interest) const;
+    void IssueTierCapture(ACameraRig* Rig, const FDirectorRigTierSettings& Tier);
+    void ApplyTier(int32 RigIndex, EDirectorRigTier Tier);
+    void Wake(int32 RigIndex);
+
+    // Registry-indexed; carried over by rig when the registry generation moves
+    TArray<TWeakObjectPtr<ACameraRig>> SlotRigs;
+    TArray<EDirectorRigTier> Tiers;       // Count = not evaluated yet
+    TArray<FIntPoint> RigCells;
+    TArray<FIntPoint> FullSizes;          // RT size when first seen
+    TArray<float> CaptureAccumulators;    // periodic capture phase (fires at >= 1)
+    TArray<uint8> bAwake;
+    TArray<int32> Awake;                  // indices with bAwake set
+
+    TMap<FIntPoint, TArray<int32>> Cells;
+    float CellSize = 0.f;
+    uint32 RegistryGeneration = MAX_uint32;
+};
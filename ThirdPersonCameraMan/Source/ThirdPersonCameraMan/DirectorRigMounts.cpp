@@ -0,0 +1,155 @@
+#include "DirectorRigMounts.h"
+
+#include "CameraRig.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorRigMounts, Log, All);
+
+const FPrimaryAssetType URigMountPreset::AssetType(TEXT("RigMountPreset"));
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorRigPresetsCommand(
+    TEXT("director.RigPresets"),
+    TEXT("Rig mount presets. Args: reload | list"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDirectorRigMountTable* Table = UDirectorRigMountTable::Get(World);
+        if (!Table) return;
+
+        if (Args.Num() > 0 && Args[0] == TEXT("reload"))
+        {
+            Table->Rebuild();
+        }
+        Table->PrintTable();
+    }));
+
+FPrimaryAssetId URigMountPreset::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(AssetType, GetFName());
+}
+
+UDirectorRigMountTable* UDirectorRigMountTable::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+    return GI ? GI->GetSubsystem<UDirectorRigMountTable>() : nullptr;
+}
+
+void UDirectorRigMountTable::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    Rebuild();
+
+#if WITH_EDITOR
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UDirectorRigMountTable::HandleObjectPropertyChanged);
+#endif
+}
+
+void UDirectorRigMountTable::Deinitialize()
+{
+#if WITH_EDITOR
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+#endif
+    Super::Deinitialize();
+}
+
+#if WITH_EDITOR
+// Editing a preset while playing in editor takes effect on the next pickup
+void UDirectorRigMountTable::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    if (Cast<URigMountPreset>(Object))
+    {
+        Rebuild();
+    }
+}
+#endif
+
+// Loads every preset the asset manager knows about; presets are a handful of small assets, so this is synchronous
+void UDirectorRigMountTable::Rebuild()
+{
+    Mounts.Reset();
+    PawnClasses.Reset();
+    RigClasses.Reset();
+    PresetNames.Reset();
+    ResolvedIndices.Reset();
+
+    if (!UAssetManager::IsInitialized()) return;
+
+    UAssetManager& Manager = UAssetManager::Get();
+    TArray<FPrimaryAssetId> Ids;
+    Manager.GetPrimaryAssetIdList(URigMountPreset::AssetType, Ids);
+
+    for (const FPrimaryAssetId& Id : Ids)
+    {
+        const URigMountPreset* Preset = Cast<URigMountPreset>(Manager.GetPrimaryAssetPath(Id).TryLoad());
+        UClass* PawnClass = Preset ? Preset->PawnClass.LoadSynchronous() : nullptr;
+        if (!PawnClass)
+        {
+            UE_LOG(LogDirectorRigMounts, Warning, TEXT("Preset %s skipped: no pawn class"), *Id.ToString());
+            continue;
+        }
+
+        Mounts.Add(Preset->Mount);
+        PawnClasses.Add(PawnClass);
+        RigClasses.Add(Preset->RigClass.LoadSynchronous());
+        PresetNames.Add(Id.PrimaryAssetName);
+    }
+
+    UE_LOG(LogDirectorRigMounts, Log, TEXT("Rig mount table: %d presets"), Mounts.Num());
+}
+
+int32 UDirectorRigMountTable::FindIndex(const UClass* PawnClass, const UClass* RigClass) const
+{
+    if (!PawnClass || !RigClass) return INDEX_NONE;
+
+    const FClassPairKey Key(PawnClass, RigClass);
+    if (const int32* Cached = ResolvedIndices.Find(Key))
+    {
+        return *Cached;
+    }
+
+    // First lookup for this pair: score every preset by how close its pawn class is, rig class as tie-break
+    int32 BestIndex = INDEX_NONE;
+    int32 BestScore = MIN_int32;
+    for (int32 i = 0; i < Mounts.Num(); ++i)
+    {
+        if (!PawnClass->IsChildOf(PawnClasses[i])) continue;
+        if (RigClasses[i] && !RigClass->IsChildOf(RigClasses[i])) continue;
+
+        int32 Depth = 0;
+        for (const UClass* Class = PawnClass; Class && Class != PawnClasses[i]; Class = Class->GetSuperClass())
+        {
+            ++Depth;
+        }
+        const int32 Score = -Depth * 2 + (RigClasses[i] ? 1 : 0);
+        if (Score > BestScore)
+        {
+            BestScore = Score;
+            BestIndex = i;
+        }
+    }
+
+    ResolvedIndices.Add(Key, BestIndex);
+    return BestIndex;
+}
+
+const FDirectorRigMount* UDirectorRigMountTable::Find(const UClass* PawnClass, const UClass* RigClass) const
+{
+    const int32 Index = FindIndex(PawnClass, RigClass);
+    return Mounts.IsValidIndex(Index) ? &Mounts[Index] : nullptr;
+}
+
+void UDirectorRigMountTable::PrintTable() const
+{
+    UE_LOG(LogDirectorRigMounts, Display, TEXT("Rig mount presets (%d):"), Mounts.Num());
+    for (int32 i = 0; i < Mounts.Num(); ++i)
+    {
+        UE_LOG(LogDirectorRigMounts, Display, TEXT("  [%d] %-24s pawn=%s rig=%s socket=%s"), i, *PresetNames[i].ToString(),
+            *GetNameSafe(PawnClasses[i]), RigClasses[i] ? *RigClasses[i]->GetName() : TEXT("any"), *Mounts[i].Socket.ToString());
+    }
+}
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DirectorRigMounts.generated.h"
+
+class ACameraRig;
+
+// How a rig sits on a pawn and frames from there (what Server_AttachToPawn applies)
+USTRUCT(BlueprintType)
+struct FDirectorRigMount
+{
+    GENERATED_BODY()
+
+    // Socket on the pawn's skeletal mesh; None keeps the rig's own AttachSocketName
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attach") FName Socket = TEXT("head");
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attach") FVector AttachRelativeLocation = FVector(0.f, 0.f, 100.f);
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attach") FRotator AttachRelativeRotation = FRotator::ZeroRotator;
+
+    // Lens offsets on the rig while mounted
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View") FVector CameraRelativeLocation = FVector(30.f, 15.f, 10.f);
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="View") FRotator CameraRelativeRotation = FRotator(-10.f, 0.f, 0.f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Align") bool bAlignWithPawnForward = true;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Align") bool bZeroRoll = true;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Align", meta=(ClampMin=-180, ClampMax=180)) float AlignYawOffsetDeg = 0.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Align", meta=(ClampMin=-89, ClampMax=89)) float AlignPitchOffsetDeg = 0.f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Align", meta=(ClampMin=-180, ClampMax=180)) float AlignRollOffsetDeg = 0.f;
+};
+
+/**
+ * Rig mount preset for a (pawn class, rig class) pair. Subclasses of either match too; the most derived
+ * pawn class wins, then a specific rig class over "any rig".
+ * Scanned by the asset manager as primary asset type "RigMountPreset" (see DefaultGame.ini).
+ */
+UCLASS(BlueprintType)
+class URigMountPreset : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Match") TSoftClassPtr<APawn> PawnClass;
+    // Empty = any rig
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Match") TSoftClassPtr<ACameraRig> RigClass;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Mount", meta=(ShowOnlyInnerProperties)) FDirectorRigMount Mount;
+
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+    static const FPrimaryAssetType AssetType;
+};
+
+/**
+ * Every RigMountPreset compiled into one flat array of mounts, plus a (pawn class, rig class) -> index cache,
+ * so a pickup resolves its preset with one map lookup and copies a single struct.
+ * Rebuilt on demand: `director.RigPresets reload` (any build) and on preset edits in the editor.
+ */
+UCLASS()
+class UDirectorRigMountTable : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorRigMountTable* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Index of the best preset for the pair (INDEX_NONE = none; the rig keeps its own mount settings)
+    int32 FindIndex(const UClass* PawnClass, const UClass* RigClass) const;
+    const FDirectorRigMount* Find(const UClass* PawnClass, const UClass* RigClass) const;
+    const FDirectorRigMount& GetMount(int32 Index) const { return Mounts[Index]; }
+
+    void Rebuild();
+    void PrintTable() const;
+
+private:
+    // Compiled presets; parallel arrays so the match loop only touches the class pointers
+    TArray<FDirectorRigMount> Mounts;
+    UPROPERTY(Transient) TArray<UClass*> PawnClasses;
+    UPROPERTY(Transient) TArray<UClass*> RigClasses;   // nullptr = any rig
+    TArray<FName> PresetNames;
+
+    // (pawn class, rig class) -> FindIndex result; keyed weakly so a class unloaded and reloaded at the same address isn't a stale hit
+    using FClassPairKey = TPair<TObjectKey<UClass>, TObjectKey<UClass>>;
+    mutable TMap<FClassPairKey, int32> ResolvedIndices;
+
+#if WITH_EDITOR
+    void HandleObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+    FDelegateHandle PropertyChangedHandle;
+#endif
+};
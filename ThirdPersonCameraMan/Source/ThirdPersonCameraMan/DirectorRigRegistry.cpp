@@ -0,0 +1,28 @@
+#include "DirectorRigRegistry.h"
+
+#include "CameraRig.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+UDirectorRigRegistry* UDirectorRigRegistry::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorRigRegistry>() : nullptr;
+}
+
+void UDirectorRigRegistry::Register(ACameraRig* Rig)
+{
+    if (Rig && !Rigs.Contains(Rig))
+    {
+        Rigs.Add(Rig);
+        ++Generation;
+    }
+}
+
+void UDirectorRigRegistry::Unregister(ACameraRig* Rig)
+{
+    if (Rigs.RemoveSwap(Rig, EAllowShrinking::No) > 0)
+    {
+        ++Generation;
+    }
+}
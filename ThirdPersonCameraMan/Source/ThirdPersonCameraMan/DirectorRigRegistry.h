@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DirectorRigRegistry.generated.h"
+
+class ACameraRig;
+
+/**
+ * Every ACameraRig in the world, registered on BeginPlay / EndPlay.
+ * Indices are dense (removal swaps the last rig in) and only stay valid while GetGeneration() is unchanged,
+ * so systems keeping per-rig arrays (auto-director, occlusion, LOD) rebuild them when it moves.
+ */
+UCLASS()
+class UDirectorRigRegistry : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorRigRegistry* Get(const UObject* WorldContext);
+
+    void Register(ACameraRig* Rig);
+    void Unregister(ACameraRig* Rig);
+
+    const TArray<ACameraRig*>& GetRigs() const { return Rigs; }
+    int32 IndexOf(const ACameraRig* Rig) const { return Rigs.IndexOfByKey(Rig); }
+    uint32 GetGeneration() const { return Generation; }
+
+private:
+    UPROPERTY(Transient) TArray<ACameraRig*> Rigs;
+    uint32 Generation = 0;
+};
@@ -0,0 +1,252 @@
+#include "DirectorRigStabilizer.h"
+
+#include "CameraRig.h"
+#include "DirectorGameState.h"
+#include "DirectorRigRegistry.h"
+#include "DirectorStats.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorStabilizer, Log, All);
+
+// Frame hitches are clamped so one long frame doesn't fling the spring
+static constexpr float MaxStepSeconds = 0.1f;
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorStabilizeBenchCommand(
+    TEXT("director.StabilizeBench"),
+    TEXT("Time the rig stabilization kernel alone. Args: [rigs=N] [iterations=N]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        int32 NumRigs = 256;
+        int32 Iterations = 10000;
+        for (const FString& Arg : Args)
+        {
+            FParse::Value(*Arg, TEXT("rigs="), NumRigs);
+            FParse::Value(*Arg, TEXT("iterations="), Iterations);
+        }
+        NumRigs = FMath::Max(1, NumRigs);
+        Iterations = FMath::Max(1, Iterations);
+
+        const double NsPerRig = UDirectorRigStabilizer::BenchmarkKernel(NumRigs, Iterations);
+        UE_LOG(LogDirectorStabilizer, Display, TEXT("Stabilization kernel: %d rigs x %d steps, %.2f ns/rig"), NumRigs, Iterations, NsPerRig);
+    }));
+
+UDirectorRigStabilizer* UDirectorRigStabilizer::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorRigStabilizer>() : nullptr;
+}
+
+void UDirectorRigStabilizer::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Collection.InitializeDependency<UDirectorRigRegistry>();
+    Super::Initialize(Collection);
+}
+
+TStatId UDirectorRigStabilizer::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDirectorRigStabilizer, STATGROUP_Tickables);
+}
+
+void UDirectorRigStabilizer::FSpringLanes::SetNum(int32 NumRigs)
+{
+    NumLanes = Align(NumRigs, 4);
+    for (int32 c = 0; c < NumChannels; ++c)
+    {
+        Value[c].Init(0.f, NumLanes);
+        Velocity[c].Init(0.f, NumLanes);
+        Target[c].Init(0.f, NumLanes);
+    }
+    Omega.Init(0.f, NumLanes);
+    Decay.Init(0.f, NumLanes);
+}
+
+// Critically-damped spring, exact for a constant target over the step:
+//   d = x - t;  k = (v + w*d) * dt;  v' = (v - w*k) * e;  x' = t + (d + k) * e;  e = exp(-w*dt)
+// Four lanes per op; the per-lane omega / decay are loaded once and reused for all six channels.
+void UDirectorRigStabilizer::StepSprings(FSpringLanes& Lanes, float DeltaTime)
+{
+    const VectorRegister4Float Dt = VectorSetFloat1(DeltaTime);
+    const float* RESTRICT Omega = Lanes.Omega.GetData();
+    const float* RESTRICT Decay = Lanes.Decay.GetData();
+
+    for (int32 i = 0; i < Lanes.NumLanes; i += 4)
+    {
+        const VectorRegister4Float W = VectorLoadAligned(Omega + i);
+        const VectorRegister4Float E = VectorLoadAligned(Decay + i);
+
+        for (int32 c = 0; c < NumChannels; ++c)
+        {
+            float* RESTRICT X = Lanes.Value[c].GetData() + i;
+            float* RESTRICT V = Lanes.Velocity[c].GetData() + i;
+            const VectorRegister4Float T = VectorLoadAligned(Lanes.Target[c].GetData() + i);
+
+            const VectorRegister4Float D = VectorSubtract(VectorLoadAligned(X), T);
+            const VectorRegister4Float Vel = VectorLoadAligned(V);
+            const VectorRegister4Float K = VectorMultiply(VectorMultiplyAdd(W, D, Vel), Dt);
+
+            VectorStoreAligned(VectorMultiply(VectorNegateMultiplyAdd(W, K, Vel), E), V);
+            VectorStoreAligned(VectorMultiplyAdd(VectorAdd(D, K), E, T), X);
+        }
+    }
+}
+
+double UDirectorRigStabilizer::BenchmarkKernel(int32 NumRigs, int32 Iterations)
+{
+    FSpringLanes Bench;
+    Bench.SetNum(NumRigs);
+
+    // Targets spread over a few metres / degrees so lanes do real work instead of sitting at rest
+    const float Dt = 1.f / 60.f;
+    for (int32 i = 0; i < Bench.NumLanes; ++i)
+    {
+        for (int32 c = 0; c < NumChannels; ++c)
+        {
+            Bench.Target[c][i] = static_cast<float>((i * 37 + c * 11) % 400) - 200.f;
+        }
+        Bench.Omega[i] = 2.f / 0.12f;
+        Bench.Decay[i] = FMath::Exp(-Bench.Omega[i] * Dt);
+    }
+
+    const uint64 Start = FPlatformTime::Cycles64();
+    for (int32 It = 0; It < Iterations; ++It)
+    {
+        StepSprings(Bench, Dt);
+    }
+    const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+    return Seconds * 1e9 / (static_cast<double>(Iterations) * NumRigs);
+}
+
+void UDirectorRigStabilizer::FPoseHistory::Push(const FVector& InLocation, const FRotator& InRotation, double InTime)
+{
+    Location[Head] = FVector3f(InLocation);
+    Rotation[Head] = FRotator3f(InRotation);
+    Time[Head] = InTime;
+    Head = (Head + 1) % Capacity;
+    Count = FMath::Min(Count + 1, Capacity);
+}
+
+// Oldest-to-newest over the ring: long enough to average out bob, short enough to catch the start of a pan
+void UDirectorRigStabilizer::FPoseHistory::GetSpeeds(float& OutLinear, float& OutAngular) const
+{
+    OutLinear = 0.f;
+    OutAngular = 0.f;
+    if (Count < 2) return;
+
+    const int32 Newest = (Head + Capacity - 1) % Capacity;
+    const int32 Oldest = (Head + Capacity - Count) % Capacity;
+    const float Span = static_cast<float>(Time[Newest] - Time[Oldest]);
+    if (Span <= KINDA_SMALL_NUMBER) return;
+
+    OutLinear = FVector3f::Dist(Location[Newest], Location[Oldest]) / Span;
+    const FRotator3f Delta = (Rotation[Newest] - Rotation[Oldest]).GetNormalized();
+    OutAngular = FMath::Max(FMath::Abs(Delta.Yaw), FMath::Abs(Delta.Pitch)) / Span;
+}
+
+// Registry indices moved: every lane restarts from its rig's raw pose
+void UDirectorRigStabilizer::SyncWithRegistry()
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Registry || Registry->GetGeneration() == RegistryGeneration) return;
+
+    RegistryGeneration = Registry->GetGeneration();
+    const int32 Num = Registry->GetRigs().Num();
+    Lanes.SetNum(Num);
+    History.SetNum(Num);
+    bWasCarried.Init(0, Num);
+}
+
+void UDirectorRigStabilizer::Tick(float DeltaTime)
+{
+    const UDirectorRigRegistry* Registry = UDirectorRigRegistry::Get(this);
+    if (!Registry) return;
+
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorStabilize);
+
+    SyncWithRegistry();
+    const TArray<ACameraRig*>& Rigs = Registry->GetRigs();
+    if (Rigs.Num() == 0) return;
+
+    const float Dt = FMath::Clamp(DeltaTime, 0.f, MaxStepSeconds);
+    const double Now = GetWorld()->GetTimeSeconds();
+    const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+    const ACameraRig* LiveRig = GS ? GS->ActiveCamera : nullptr;
+    int32 NumCarried = 0;
+
+    // Gather: render-time pose -> history -> spring target and stiffness (scalar, one exp per carried rig)
+    for (int32 i = 0; i < Rigs.Num(); ++i)
+    {
+        ACameraRig* Rig = Rigs[i];
+        const bool bAttached = Rig && Cast<APawn>(Rig->GetAttachParentActor());
+        if (Rig && (bAttached || Rig == LiveRig || Rig->IsCapturing()))
+        {
+            Rig->UpdateRenderPose(Now, DeltaTime);
+        }
+
+        const bool bCarried = bAttached && Rig->bStabilizeWhenCarried;
+        if (!bCarried)
+        {
+            bWasCarried[i] = 0;
+            Lanes.Decay[i] = 0.f;
+            continue;
+        }
+
+        FVector RawLocation;
+        FRotator RawRotation;
+        Rig->GetViewPose(RawLocation, RawRotation);
+
+        FPoseHistory& Poses = History[i];
+        if (!bWasCarried[i])
+        {
+            // Just picked up: start at rest on the raw pose rather than swooping in from the old mount
+            Poses.Reset();
+            const float Raw[NumChannels] = {
+                (float)RawLocation.X, (float)RawLocation.Y, (float)RawLocation.Z,
+                (float)RawRotation.Pitch, (float)RawRotation.Yaw, (float)RawRotation.Roll };
+            for (int32 c = 0; c < NumChannels; ++c)
+            {
+                Lanes.Value[c][i] = Raw[c];
+                Lanes.Velocity[c][i] = 0.f;
+            }
+            bWasCarried[i] = 1;
+        }
+        Poses.Push(RawLocation, RawRotation, Now);
+
+        Lanes.Target[0][i] = RawLocation.X;
+        Lanes.Target[1][i] = RawLocation.Y;
+        Lanes.Target[2][i] = RawLocation.Z;
+
+        // Angles are unwrapped around the filtered value so the spring takes the short way round
+        Lanes.Target[3][i] = Lanes.Value[3][i] + FRotator::NormalizeAxis(RawRotation.Pitch - Lanes.Value[3][i]);
+        Lanes.Target[4][i] = Lanes.Value[4][i] + FRotator::NormalizeAxis(RawRotation.Yaw - Lanes.Value[4][i]);
+        Lanes.Target[5][i] = Lanes.Value[5][i] + FRotator::NormalizeAxis(RawRotation.Roll - Lanes.Value[5][i]);
+
+        float Linear, Angular;
+        Poses.GetSpeeds(Linear, Angular);
+        const float Fast = FMath::Clamp(FMath::Max(Linear / Rig->StabilizationFastLinearSpeed, Angular / Rig->StabilizationFastAngularSpeed), 0.f, 1.f);
+        const float SmoothTime = FMath::Lerp(Rig->StabilizationSmoothTime, Rig->StabilizationFastSmoothTime, Fast);
+
+        Lanes.Omega[i] = 2.f / FMath::Max(SmoothTime, 0.001f);
+        Lanes.Decay[i] = FMath::Exp(-Lanes.Omega[i] * Dt);
+        ++NumCarried;
+    }
+    if (NumCarried == 0) return;
+
+    const uint64 KernelStart = FPlatformTime::Cycles64();
+    StepSprings(Lanes, Dt);
+    SET_FLOAT_STAT(STAT_DirectorStabilizeNsPerRig, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - KernelStart) * 1e9 / Lanes.NumLanes);
+    SET_DWORD_STAT(STAT_DirectorStabilizeRigs, NumCarried);
+
+    // Scatter: CalcCamera picks these up when the camera managers update later this frame
+    for (int32 i = 0; i < Rigs.Num(); ++i)
+    {
+        if (!bWasCarried[i]) continue;
+        Rigs[i]->SetStabilizedViewPose(
+            FVector(Lanes.Value[0][i], Lanes.Value[1][i], Lanes.Value[2][i]),
+            FRotator(Lanes.Value[3][i], Lanes.Value[4][i], Lanes.Value[5][i]).GetNormalized());
+    }
+}
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DirectorRigStabilizer.generated.h"
+
+class ACameraRig;
+
+/**
+ * Per-frame rig pose pass and handheld stabilization for carried rigs, on every machine.
+ * Once per frame (tickables run after the actor tick groups and before the camera managers update) every
+ * carried, live or capturing rig places its view / capture at render time (ACameraRig::UpdateRenderPose,
+ * sub-tick interpolation). The resulting view pose of every carried rig is then pushed through a critically-damped spring on X/Y/Z and
+ * pitch/yaw/roll. Springs live in padded SoA lanes and are stepped four rigs per SIMD op, so a pass costs the
+ * same per rig whatever the mix. The smoothing time shortens with the speed measured over a small history
+ * ring of raw poses, so walking bob is absorbed while deliberate pans stay responsive.
+ * `director.StabilizeBench [rigs=N] [iterations=N]` times the kernel alone; `stat Director` shows the live ns/rig.
+ */
+UCLASS()
+class UDirectorRigStabilizer : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorRigStabilizer* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Steps the spring kernel over NumRigs synthetic rigs Iterations times; returns nanoseconds per rig per step
+    static double BenchmarkKernel(int32 NumRigs, int32 Iterations);
+
+    // X, Y, Z, Pitch, Yaw, Roll
+    static constexpr int32 NumChannels = 6;
+
+    // Spring state in structure-of-arrays form, padded to a multiple of 4 lanes and 16-byte aligned
+    struct FSpringLanes
+    {
+        TArray<float, TAlignedHeapAllocator<16>> Value[NumChannels];
+        TArray<float, TAlignedHeapAllocator<16>> Velocity[NumChannels];
+        TArray<float, TAlignedHeapAllocator<16>> Target[NumChannels];
+        TArray<float, TAlignedHeapAllocator<16>> Omega;   // 2 / smoothing time
+        TArray<float, TAlignedHeapAllocator<16>> Decay;   // exp(-Omega * dt); 0 parks the lane on its target
+        int32 NumLanes = 0;
+
+        void SetNum(int32 NumRigs);
+    };
+
+    static void StepSprings(FSpringLanes& Lanes, float DeltaTime);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+    {
+        return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+    }
+
+private:
+    // Last raw poses of a carried rig, used to measure how fast the operator is moving
+    struct FPoseHistory
+    {
+        static constexpr int32 Capacity = 8;
+        FVector3f Location[Capacity];
+        FRotator3f Rotation[Capacity];
+        double Time[Capacity];
+        int32 Head = 0;
+        int32 Count = 0;
+
+        void Reset() { Head = 0; Count = 0; }
+        void Push(const FVector& InLocation, const FRotator& InRotation, double InTime);
+        void GetSpeeds(float& OutLinear, float& OutAngular) const;
+    };
+
+    void SyncWithRegistry();
+
+    FSpringLanes Lanes;
+    TArray<FPoseHistory> History;
+    TArray<uint8> bWasCarried;
+    uint32 RegistryGeneration = MAX_uint32;
+};
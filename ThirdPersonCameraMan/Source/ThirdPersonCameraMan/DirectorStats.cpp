@@ -0,0 +1,28 @@
+#include "DirectorStats.h"
+
+UE_TRACE_CHANNEL_DEFINE(DirectorChannel);
+
+DEFINE_STAT(STAT_DirectorCalcCamera);
+DEFINE_STAT(STAT_DirectorCaptureIssue);
+DEFINE_STAT(STAT_DirectorSwitchCommit);
+DEFINE_STAT(STAT_DirectorOnRepActiveCamera);
+DEFINE_STAT(STAT_DirectorViewerCameraChanged);
+DEFINE_STAT(STAT_DirectorFeedBind);
+DEFINE_STAT(STAT_DirectorMonitorWall);
+DEFINE_STAT(STAT_DirectorAutoDirector);
+DEFINE_STAT(STAT_DirectorAutoScore);
+DEFINE_STAT(STAT_DirectorOcclusion);
+DEFINE_STAT(STAT_DirectorStabilize);
+DEFINE_STAT(STAT_DirectorRigLOD);
+DEFINE_STAT(STAT_DirectorFeedComposite);
+
+DEFINE_STAT(STAT_DirectorCapturesIssued);
+DEFINE_STAT(STAT_DirectorOcclusionRays);
+DEFINE_STAT(STAT_DirectorAutoRigs);
+DEFINE_STAT(STAT_DirectorRigLODEvaluated);
+DEFINE_STAT(STAT_DirectorStabilizeRigs);
+DEFINE_STAT(STAT_DirectorStabilizeNsPerRig);
+DEFINE_STAT(STAT_DirectorLastSettleMs);
+DEFINE_STAT(STAT_DirectorLastSwitchCommitMs);
+DEFINE_STAT(STAT_DirectorRepBytes);
+DEFINE_STAT(STAT_DirectorRepBytesTotal);
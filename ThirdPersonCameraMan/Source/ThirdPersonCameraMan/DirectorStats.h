@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// `stat Director` shows this group; `-trace=cpu,Director` records the scopes below in Unreal Insights
+DECLARE_STATS_GROUP(TEXT("Director"), STATGROUP_Director, STATCAT_Advanced);
+
+UE_TRACE_CHANNEL_EXTERN(DirectorChannel, THIRDPERSONCAMERAMAN_API);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rig CalcCamera"), STAT_DirectorCalcCamera, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture issue (all rigs)"), STAT_DirectorCaptureIssue, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Switch commit"), STAT_DirectorSwitchCommit, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnRep ActiveCamera"), STAT_DirectorOnRepActiveCamera, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Viewer camera changed"), STAT_DirectorViewerCameraChanged, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Widget feed bind"), STAT_DirectorFeedBind, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Monitor wall tick"), STAT_DirectorMonitorWall, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Auto-director tick"), STAT_DirectorAutoDirector, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Auto-director scoring (parallel)"), STAT_DirectorAutoScore, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Occlusion service tick"), STAT_DirectorOcclusion, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rig stabilization"), STAT_DirectorStabilize, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rig LOD tick"), STAT_DirectorRigLOD, STATGROUP_Director, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Feed transition composite"), STAT_DirectorFeedComposite, STATGROUP_Director, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Captures issued"), STAT_DirectorCapturesIssued, STATGROUP_Director, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Occlusion rays issued"), STAT_DirectorOcclusionRays, STATGROUP_Director, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Auto-director rigs scored"), STAT_DirectorAutoRigs, STATGROUP_Director, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rig LOD rigs evaluated"), STAT_DirectorRigLODEvaluated, STATGROUP_Director, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Stabilized rigs"), STAT_DirectorStabilizeRigs, STATGROUP_Director, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Stabilization kernel (ns/rig)"), STAT_DirectorStabilizeNsPerRig, STATGROUP_Director, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last exposure time-to-stable (ms)"), STAT_DirectorLastSettleMs, STATGROUP_Director, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last switch commit (ms)"), STAT_DirectorLastSwitchCommitMs, STATGROUP_Director, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Director rep bytes (est.)"), STAT_DirectorRepBytes, STATGROUP_Director, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Director rep bytes total (est.)"), STAT_DirectorRepBytesTotal, STATGROUP_Director, );
+
+// Stat + Insights scope in one line for director hot paths
+#define DIRECTOR_SCOPE_CYCLE_COUNTER(Stat) \
+    SCOPE_CYCLE_COUNTER(Stat); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, DirectorChannel)
+
@@ -0,0 +1,270 @@
+#include "DirectorSwitchTelemetry.h"
+
+#include "CameraRig.h"
+#include "ThirdPersonCameraMan.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorTelemetry, Log, All);
+
+using ThirdPersonCameraMan::NearestRankPercentile;
+
+const EDirectorSwitchStage UDirectorSwitchTelemetry::SegmentFrom[NumSegments] =
+{
+    EDirectorSwitchStage::Overlap, EDirectorSwitchStage::Commit, EDirectorSwitchStage::Arrival,
+    EDirectorSwitchStage::FirstCapture, EDirectorSwitchStage::Overlap
+};
+const EDirectorSwitchStage UDirectorSwitchTelemetry::SegmentTo[NumSegments] =
+{
+    EDirectorSwitchStage::Commit, EDirectorSwitchStage::Arrival, EDirectorSwitchStage::FirstCapture,
+    EDirectorSwitchStage::FirstPresent, EDirectorSwitchStage::FirstPresent
+};
+const TCHAR* UDirectorSwitchTelemetry::SegmentNames[NumSegments] =
+{
+    TEXT("overlap_to_commit"), TEXT("commit_to_arrival"), TEXT("arrival_to_capture"),
+    TEXT("capture_to_present"), TEXT("overlap_to_present")
+};
+
+// Give up on a cut that never reaches the screen (dedicated server, hidden viewport) after this long
+static constexpr double InFlightTimeoutSeconds = 5.0;
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorSwitchLatencyCommand(
+    TEXT("director.SwitchLatency"),
+    TEXT("Camera cut latency p50/p95/p99 per stage. Args: [reset | csv]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UDirectorSwitchTelemetry* Telemetry = UDirectorSwitchTelemetry::Get(World);
+        if (!Telemetry) return;
+
+        if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+        {
+            Telemetry->Reset();
+        }
+        else if (Args.Num() > 0 && Args[0] == TEXT("csv"))
+        {
+            Telemetry->WriteCsv();
+        }
+        else
+        {
+            Telemetry->PrintSummary();
+        }
+    }));
+
+UDirectorSwitchTelemetry* UDirectorSwitchTelemetry::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UDirectorSwitchTelemetry>() : nullptr;
+}
+
+void UDirectorSwitchTelemetry::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    bWriteCsvOnShutdown = FParse::Param(FCommandLine::Get(), TEXT("DirectorLatencyCsv"));
+}
+
+void UDirectorSwitchTelemetry::Deinitialize()
+{
+    if (UGameViewportClient* Viewport = GetWorld()->GetGameViewport())
+    {
+        Viewport->OnEndDraw().Remove(EndDrawHandle);
+    }
+    EndDrawHandle.Reset();
+
+    if (bWriteCsvOnShutdown && History.Num() > 0)
+    {
+        WriteCsv();
+    }
+    Super::Deinitialize();
+}
+
+TStatId UDirectorSwitchTelemetry::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDirectorSwitchTelemetry, STATGROUP_Tickables);
+}
+
+double UDirectorSwitchTelemetry::ServerNow() const
+{
+    const UWorld* World = GetWorld();
+    if (const AGameStateBase* GS = World ? World->GetGameState() : nullptr)
+    {
+        return GS->GetServerWorldTimeSeconds();
+    }
+    return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UDirectorSwitchTelemetry::Tick(float DeltaTime)
+{
+    // The game viewport shows up after world init; bind lazily
+    if (!EndDrawHandle.IsValid())
+    {
+        if (UGameViewportClient* Viewport = GetWorld()->GetGameViewport())
+        {
+            EndDrawHandle = Viewport->OnEndDraw().AddUObject(this, &UDirectorSwitchTelemetry::HandleViewportEndDraw);
+        }
+    }
+
+    if (!bInFlight) return;
+
+    // Rigs already capturing every frame never call IssueCapture; the engine captures them at the end of this frame
+    if (Current.Has(EDirectorSwitchStage::Arrival) && !Current.Has(EDirectorSwitchStage::FirstCapture))
+    {
+        const ACameraRig* Rig = Current.Rig.Get();
+        if (Rig && Rig->SceneCapture && Rig->SceneCapture->bCaptureEveryFrame)
+        {
+            Stamp(EDirectorSwitchStage::FirstCapture);
+        }
+    }
+
+    if (ServerNow() - Current.Stamps[static_cast<int32>(EDirectorSwitchStage::Arrival)] > InFlightTimeoutSeconds)
+    {
+        Finalize();
+    }
+}
+
+void UDirectorSwitchTelemetry::NoteArrival(const FDirectorTransitionStamp& Transition, const ACameraRig* Rig, double Now)
+{
+    if (Transition.Id <= 0 || !Rig) return;
+    if (bInFlight && Current.Id == Transition.Id) return;
+
+    // A new cut while the previous one is still in flight: keep what we have of it
+    if (bInFlight)
+    {
+        Finalize();
+    }
+
+    Current = FRecord();
+    Current.Id = Transition.Id;
+    Current.Rig = Rig;
+    Current.Set(EDirectorSwitchStage::Overlap, Transition.OverlapServerTime);
+    Current.Set(EDirectorSwitchStage::Commit, Transition.CommitServerTime);
+    Current.Set(EDirectorSwitchStage::Arrival, Now);
+    bInFlight = true;
+}
+
+void UDirectorSwitchTelemetry::NoteCaptureIssued(const ACameraRig* Rig)
+{
+    if (bInFlight && Rig && Current.Rig.Get() == Rig
+        && Current.Has(EDirectorSwitchStage::Arrival) && !Current.Has(EDirectorSwitchStage::FirstCapture))
+    {
+        Stamp(EDirectorSwitchStage::FirstCapture);
+    }
+}
+
+void UDirectorSwitchTelemetry::HandleViewportEndDraw()
+{
+    if (bInFlight && Current.Has(EDirectorSwitchStage::FirstCapture))
+    {
+        Stamp(EDirectorSwitchStage::FirstPresent);
+        Finalize();
+    }
+}
+
+void UDirectorSwitchTelemetry::Stamp(EDirectorSwitchStage Stage)
+{
+    Current.Set(Stage, ServerNow());
+}
+
+void UDirectorSwitchTelemetry::Finalize()
+{
+    for (int32 i = 0; i < NumSegments; ++i)
+    {
+        if (Current.Has(SegmentFrom[i]) && Current.Has(SegmentTo[i]))
+        {
+            const double Ms = (Current.Stamps[static_cast<int32>(SegmentTo[i])] - Current.Stamps[static_cast<int32>(SegmentFrom[i])]) * 1000.0;
+            if (Samples[i].Num() >= MaxSamples)
+            {
+                Samples[i].RemoveAt(0, 1, EAllowShrinking::No);
+            }
+            Samples[i].Add(static_cast<float>(FMath::Max(0.0, Ms)));
+        }
+    }
+
+    if (History.Num() >= MaxRecords)
+    {
+        History.RemoveAt(0, 1, EAllowShrinking::No);
+    }
+    History.Add(Current);
+    bInFlight = false;
+}
+
+void UDirectorSwitchTelemetry::Reset()
+{
+    for (TArray<float>& S : Samples)
+    {
+        S.Reset();
+    }
+    History.Reset();
+    bInFlight = false;
+}
+
+void UDirectorSwitchTelemetry::PrintSummary() const
+{
+    UE_LOG(LogDirectorTelemetry, Display, TEXT("Camera cut latency (%d cuts, ms):"), History.Num());
+    for (int32 i = 0; i < NumSegments; ++i)
+    {
+        TArray<float> Sorted = Samples[i];
+        Sorted.Sort();
+        UE_LOG(LogDirectorTelemetry, Display, TEXT("  %-20s n=%4d p50=%7.1f p95=%7.1f p99=%7.1f max=%7.1f"),
+            SegmentNames[i], Sorted.Num(), NearestRankPercentile(Sorted, 0.50f), NearestRankPercentile(Sorted, 0.95f),
+            NearestRankPercentile(Sorted, 0.99f), Sorted.Num() ? Sorted.Last() : 0.f);
+    }
+}
+
+bool UDirectorSwitchTelemetry::WriteCsv(FString* OutPath) const
+{
+    const UWorld* World = GetWorld();
+    const TCHAR* Machine = (World && World->GetNetMode() == NM_Client) ? TEXT("client") : TEXT("server");
+    const FString Path = FPaths::ProfilingDir() / TEXT("Director") /
+        FString::Printf(TEXT("SwitchLatency-%s-%s.csv"), Machine, *FDateTime::Now().ToString());
+
+    FString Csv = TEXT("id,rig,overlap,commit,arrival,first_capture,first_present");
+    for (int32 i = 0; i < NumSegments; ++i)
+    {
+        Csv += FString::Printf(TEXT(",%s_ms"), SegmentNames[i]);
+    }
+    Csv += LINE_TERMINATOR;
+
+    for (const FRecord& R : History)
+    {
+        const ACameraRig* Rig = R.Rig.Get();
+        Csv += FString::Printf(TEXT("%d,%s"), R.Id, Rig ? *Rig->GetRigDisplayName() : TEXT("?"));
+        for (double S : R.Stamps)
+        {
+            Csv += S >= 0.0 ? FString::Printf(TEXT(",%.4f"), S) : FString(TEXT(","));
+        }
+        for (int32 i = 0; i < NumSegments; ++i)
+        {
+            const bool bHas = R.Has(SegmentFrom[i]) && R.Has(SegmentTo[i]);
+            Csv += bHas ? FString::Printf(TEXT(",%.2f"), (R.Stamps[static_cast<int32>(SegmentTo[i])] - R.Stamps[static_cast<int32>(SegmentFrom[i])]) * 1000.0)
+                        : FString(TEXT(","));
+        }
+        Csv += LINE_TERMINATOR;
+    }
+
+    // Summary block under the raw rows
+    Csv += LINE_TERMINATOR;
+    Csv += TEXT("segment,count,p50_ms,p95_ms,p99_ms,max_ms");
+    Csv += LINE_TERMINATOR;
+    for (int32 i = 0; i < NumSegments; ++i)
+    {
+        TArray<float> Sorted = Samples[i];
+        Sorted.Sort();
+        Csv += FString::Printf(TEXT("%s,%d,%.2f,%.2f,%.2f,%.2f"), SegmentNames[i], Sorted.Num(),
+            NearestRankPercentile(Sorted, 0.50f), NearestRankPercentile(Sorted, 0.95f), NearestRankPercentile(Sorted, 0.99f), Sorted.Num() ? Sorted.Last() : 0.f);
+        Csv += LINE_TERMINATOR;
+    }
+
+    const bool bOk = FFileHelper::SaveStringToFile(Csv, *Path);
+    UE_LOG(LogDirectorTelemetry, Display, TEXT("Switch latency CSV %s: %s"), bOk ? TEXT("written") : TEXT("FAILED"), *Path);
+    if (OutPath)
+    {
+        *OutPath = Path;
+    }
+    return bOk;
+}
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DirectorGameState.h"
+#include "DirectorSwitchTelemetry.generated.h"
+
+class ACameraRig;
+
+// Points along a camera cut, in the order they happen
+enum class EDirectorSwitchStage : uint8
+{
+    Overlap,        // operator bump / pickup overlap (server)
+    Commit,         // ActiveCamera set (server)
+    Arrival,        // ActiveCamera replicated to this machine (OnRep; commit on the server)
+    FirstCapture,   // first capture of the new rig issued on this machine
+    FirstPresent,   // first viewport frame drawn after that capture
+    Count
+};
+
+/**
+ * Input-to-photon telemetry for camera cuts, per machine.
+ * All stamps are in server world time (GetServerWorldTimeSeconds) so server and client stages line up.
+ * `director.SwitchLatency` prints p50/p95/p99 per segment; `director.SwitchLatency csv` writes them out.
+ */
+UCLASS()
+class UDirectorSwitchTelemetry : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorSwitchTelemetry* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Called once per cut on every machine (server from CommitTransition, clients from OnRep)
+    void NoteArrival(const FDirectorTransitionStamp& Stamp, const ACameraRig* Rig, double ServerNow);
+
+    // Called by ACameraRig::IssueCapture
+    void NoteCaptureIssued(const ACameraRig* Rig);
+
+    // Console output and CSV export
+    void PrintSummary() const;
+    bool WriteCsv(FString* OutPath = nullptr) const;
+    void Reset();
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+    {
+        return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+    }
+
+private:
+    struct FRecord
+    {
+        int32 Id = 0;
+        double Stamps[static_cast<int32>(EDirectorSwitchStage::Count)];
+        TWeakObjectPtr<const ACameraRig> Rig;
+
+        FRecord() { for (double& S : Stamps) S = -1.0; }
+        bool Has(EDirectorSwitchStage Stage) const { return Stamps[static_cast<int32>(Stage)] >= 0.0; }
+        void Set(EDirectorSwitchStage Stage, double Time) { Stamps[static_cast<int32>(Stage)] = Time; }
+    };
+
+    // Segments reported in the summary: (from, to)
+    static constexpr int32 NumSegments = 5;
+    static const EDirectorSwitchStage SegmentFrom[NumSegments];
+    static const EDirectorSwitchStage SegmentTo[NumSegments];
+    static const TCHAR* SegmentNames[NumSegments];
+
+    // Sample caps so a long session doesn't grow without bound
+    static constexpr int32 MaxSamples = 2048;
+    static constexpr int32 MaxRecords = 512;
+
+    void Stamp(EDirectorSwitchStage Stage);
+    void Finalize();
+    void HandleViewportEndDraw();
+    double ServerNow() const;
+
+    FRecord Current;
+    bool bInFlight = false;
+
+    TArray<float> Samples[NumSegments];   // ms
+    TArray<FRecord> History;
+
+    FDelegateHandle EndDrawHandle;
+    bool bWriteCsvOnShutdown = false;
+};
@@ -0,0 +1,119 @@
+#include "DirectorViewerProfile.h"
+
+#include "CameraRig.h"
+#include "DirectorMonitorWall.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Widgets/Input/SVirtualJoystick.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDirectorViewerProfile, Log, All);
+
+static FAutoConsoleCommandWithWorldAndArgs GDirectorViewerProfileCommand(
+    TEXT("director.ViewerProfile"),
+    TEXT("Print the viewer profile this process runs with (-DirectorViewerProfile=<Name>)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (const UDirectorViewerProfileSubsystem* Profiles = UDirectorViewerProfileSubsystem::Get(World))
+        {
+            Profiles->PrintProfile();
+        }
+    }));
+
+UDirectorViewerProfileSettings::UDirectorViewerProfileSettings()
+{
+    FDirectorViewerProfile& Desktop = Profiles.AddDefaulted_GetRef();
+    Desktop.Name = TEXT("Desktop");
+
+    // Half-rate, half-size feeds without the expensive screen-space passes; the PiP would only repeat the main view
+    FDirectorViewerProfile& Mobile = Profiles.AddDefaulted_GetRef();
+    Mobile.Name = TEXT("Mobile");
+    Mobile.FeedCaptureHz = 30.f;
+    Mobile.RenderTargetScale = 0.5f;
+    Mobile.LODDistanceFactor = 2.f;
+    Mobile.DisabledShowFlags = { TEXT("AmbientOcclusion"), TEXT("ScreenSpaceReflections"), TEXT("DynamicShadows"),
+        TEXT("VolumetricFog"), TEXT("MotionBlur"), TEXT("DepthOfField"), TEXT("Bloom"), TEXT("LensFlares") };
+    Mobile.bPiPWhenFollowingRig = false;
+}
+
+UDirectorViewerProfileSubsystem* UDirectorViewerProfileSubsystem::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    const UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+    return GI ? GI->GetSubsystem<UDirectorViewerProfileSubsystem>() : nullptr;
+}
+
+void UDirectorViewerProfileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    const UDirectorViewerProfileSettings* Settings = GetDefault<UDirectorViewerProfileSettings>();
+    FString Requested;
+    if (FParse::Value(FCommandLine::Get(), TEXT("DirectorViewerProfile="), Requested))
+    {
+        Source = TEXT("command line");
+    }
+    else if (SVirtualJoystick::ShouldDisplayTouchInterface())
+    {
+        Requested = Settings->TouchProfile.ToString();
+        Source = TEXT("touch device");
+    }
+    else
+    {
+        Requested = Settings->DefaultProfile.ToString();
+        Source = TEXT("default");
+    }
+
+    const FName RequestedName(*Requested);
+    if (const FDirectorViewerProfile* Found = Settings->Profiles.FindByPredicate([RequestedName](const FDirectorViewerProfile& P) { return P.Name == RequestedName; }))
+    {
+        Profile = *Found;
+    }
+    else
+    {
+        UE_LOG(LogDirectorViewerProfile, Warning, TEXT("Viewer profile '%s' not found; feeds run at full cost"), *Requested);
+        Profile = FDirectorViewerProfile();
+        Profile.Name = RequestedName;
+    }
+    PrintProfile();
+}
+
+void UDirectorViewerProfileSubsystem::ApplyToRig(ACameraRig* Rig) const
+{
+    USceneCaptureComponent2D* Capture = Rig ? Rig->SceneCapture : nullptr;
+    if (!Capture) return;
+
+    // Every-frame captures are deferred from the capture component's tick, so its interval is the feed rate
+    Capture->SetComponentTickInterval(Profile.FeedCaptureHz > 0.f ? 1.f / Profile.FeedCaptureHz : 0.f);
+    Capture->LODDistanceFactor = Profile.LODDistanceFactor;
+
+    for (const FString& Flag : Profile.DisabledShowFlags)
+    {
+        const int32 Index = FEngineShowFlags::FindIndexByName(*Flag);
+        if (Index != INDEX_NONE)
+        {
+            Capture->ShowFlags.SetSingleFlag(Index, false);
+        }
+    }
+
+    // Block-compressed formats can't be rendered to; the feed saves bandwidth and memory through its size instead
+    UTextureRenderTarget2D* RT = Rig->RenderTarget;
+    if (RT && Profile.RenderTargetScale < 1.f)
+    {
+        RT->ResizeTarget(DirectorMonitorWall::QuantizeRTSize(RT->SizeX * Profile.RenderTargetScale),
+            DirectorMonitorWall::QuantizeRTSize(RT->SizeY * Profile.RenderTargetScale));
+    }
+}
+
+void UDirectorViewerProfileSubsystem::PrintProfile() const
+{
+    UE_LOG(LogDirectorViewerProfile, Display, TEXT("Viewer profile %s (%s): feed %s, RT x%.2f, LOD x%.2f, %d show flags off, PiP when following %s"),
+        *Profile.Name.ToString(), *Source,
+        Profile.FeedCaptureHz > 0.f ? *FString::Printf(TEXT("%.0f Hz"), Profile.FeedCaptureHz) : TEXT("every frame"),
+        Profile.RenderTargetScale, Profile.LODDistanceFactor, Profile.DisabledShowFlags.Num(),
+        Profile.bPiPWhenFollowingRig ? TEXT("on") : TEXT("off"));
+}
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "DirectorViewerProfile.generated.h"
+
+class ACameraRig;
+
+// What this machine's feeds cost; everything is local, nothing here is replicated
+USTRUCT(BlueprintType)
+struct FDirectorViewerProfile
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category="Profile") FName Name;
+
+    // Every-frame captures run at most this often (scene capture tick interval); 0 = every frame
+    UPROPERTY(EditAnywhere, Category="Profile", meta=(ClampMin=0, ClampMax=120)) float FeedCaptureHz = 0.f;
+
+    // Rig render targets are created at this fraction of their configured size
+    UPROPERTY(EditAnywhere, Category="Profile", meta=(ClampMin=0.125, ClampMax=1)) float RenderTargetScale = 1.f;
+
+    // Capture LOD bias (> 1 picks coarser mesh LODs sooner)
+    UPROPERTY(EditAnywhere, Category="Profile", meta=(ClampMin=0.1)) float LODDistanceFactor = 1.f;
+
+    // Show flags turned off on every rig capture (FEngineShowFlags names, e.g. AmbientOcclusion)
+    UPROPERTY(EditAnywhere, Category="Profile") TArray<FString> DisabledShowFlags;
+
+    // Keep the PiP for players whose view already follows the live rig (viewers; operators forcing the rig view)
+    UPROPERTY(EditAnywhere, Category="Profile") bool bPiPWhenFollowingRig = true;
+};
+
+// Device-class profiles ([/Script/ThirdPersonCameraMan.DirectorViewerProfileSettings] in DefaultGame.ini)
+UCLASS(config=Game, defaultconfig)
+class UDirectorViewerProfileSettings : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UDirectorViewerProfileSettings();
+
+    UPROPERTY(config, EditAnywhere, Category="Viewer") TArray<FDirectorViewerProfile> Profiles;
+
+    // Used when -DirectorViewerProfile= is absent: TouchProfile on touch devices, DefaultProfile otherwise
+    UPROPERTY(config, EditAnywhere, Category="Viewer") FName DefaultProfile = TEXT("Desktop");
+    UPROPERTY(config, EditAnywhere, Category="Viewer") FName TouchProfile = TEXT("Mobile");
+};
+
+/**
+ * The viewer profile this process runs with, resolved once at startup: `-DirectorViewerProfile=<Name>` wins, then the
+ * touch interface check the controller already uses for its mobile controls, then DefaultProfile. Rigs apply it to
+ * their capture and RT in BeginPlay; the controller asks it whether to show the PiP.
+ * `director.ViewerProfile` prints the active profile; the benchmark logs it with its results, so a profile can be
+ * measured headlessly (e.g. `-DirectorViewerProfile=Mobile -RenderOffscreen` on a Linux client).
+ */
+UCLASS()
+class UDirectorViewerProfileSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static UDirectorViewerProfileSubsystem* Get(const UObject* WorldContext);
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    const FDirectorViewerProfile& GetProfile() const { return Profile; }
+
+    // Capture rate, LOD bias, show flags and RT size for one rig (call before its first capture)
+    void ApplyToRig(ACameraRig* Rig) const;
+
+    void PrintProfile() const;
+
+private:
+    FDirectorViewerProfile Profile;
+    FString Source;   // how the profile was picked, for the log
+};
@@ -1,11 +1,17 @@
 #include "DirectorGameState.h"
 #include "Net/UnrealNetwork.h"   // <-- required for DOREPLIFETIME
 #include "CameraRig.h"
+#include "GameFramework/PlayerState.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Components/SceneCaptureComponent2D.h"
+#include "DirectorStats.h"
+#include "DirectorSwitchTelemetry.h"
+#include "ProfilingDebugging/CountersTrace.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogDirectorGS, Log, All);
 
+TRACE_DECLARE_INT_COUNTER(DirectorRepBytes, TEXT("Director/RepBytesTotal (est.)"));
+
 
 ADirectorGameState::ADirectorGameState()
 {
@@ -18,37 +24,146 @@ void ADirectorGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
     DOREPLIFETIME(ADirectorGameState, ActiveCamera);
     DOREPLIFETIME(ADirectorGameState, OperatorPlayerState);
+    DOREPLIFETIME(ADirectorGameState, LastTransition);
+}
+
+void ADirectorGameState::AddPlayerState(APlayerState* PlayerState)
+{
+    Super::AddPlayerState(PlayerState);
+
+    // Players are added as they join and PlayerIds are handed out in the same order, so appending keeps it sorted
+    if (PlayerState && PlayerArray.Contains(PlayerState))
+    {
+        PlayersInJoinOrder.AddUnique(PlayerState);
+    }
+}
+
+void ADirectorGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+    PlayersInJoinOrder.Remove(PlayerState);
+    Super::RemovePlayerState(PlayerState);
+}
+
+int32 ADirectorGameState::BeginTransition()
+{
+    if (!HasAuthority()) return 0;
+    PendingTransitionId = NextTransitionId++;
+    PendingOverlapServerTime = GetServerWorldTimeSeconds();
+    return PendingTransitionId;
+}
+
+void ADirectorGameState::SetPendingTransitionStyle(EDirectorTransitionStyle Style, float Seconds)
+{
+    if (!HasAuthority()) return;
+    PendingStyle = Style;
+    PendingStyleSeconds = Style == EDirectorTransitionStyle::Cut ? 0.f : FMath::Max(0.f, Seconds);
+}
+
+void ADirectorGameState::CommitTransition()
+{
+    if (!HasAuthority()) return;
+
+    // Commits without an overlap (e.g. scripted) get an ID of their own, overlap == commit
+    const double Now = GetServerWorldTimeSeconds();
+    if (PendingTransitionId == 0)
+    {
+        PendingTransitionId = NextTransitionId++;
+        PendingOverlapServerTime = Now;
+    }
+
+    LastTransition.Id = PendingTransitionId;
+    LastTransition.OverlapServerTime = PendingOverlapServerTime;
+    LastTransition.CommitServerTime = Now;
+    LastTransition.Style = PendingStyle;
+    LastTransition.StyleSeconds = PendingStyleSeconds;
+    PendingTransitionId = 0;
+    PendingStyle = EDirectorTransitionStyle::Cut;
+    PendingStyleSeconds = 0.f;
+
+    // The server never gets OnRep; its own arrival is the commit
+    if (UDirectorSwitchTelemetry* Telemetry = UDirectorSwitchTelemetry::Get(this))
+    {
+        Telemetry->NoteArrival(LastTransition, ActiveCamera, Now);
+    }
+}
+
+void ADirectorGameState::ClearTransition()
+{
+    if (!HasAuthority()) return;
+    LastTransition = FDirectorTransitionStamp();
+    PendingTransitionId = 0;
+}
+
+void ADirectorGameState::AbandonTransition()
+{
+    if (!HasAuthority()) return;
+    PendingTransitionId = 0;
+    PendingStyle = EDirectorTransitionStyle::Cut;
+    PendingStyleSeconds = 0.f;
+}
+
+void ADirectorGameState::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+    Super::PreReplication(ChangedPropertyTracker);
+
+    // Rough per-change cost: property handle + packed NetGUID. Exact numbers come from Networking Insights (-NetTrace=1)
+    static constexpr uint32 EstimatedObjectRefBytes = 4;
+
+    uint32 Bytes = 0;
+    if (LastRepActiveCamera != ActiveCamera)
+    {
+        LastRepActiveCamera = ActiveCamera;
+        Bytes += EstimatedObjectRefBytes;
+    }
+    if (LastRepOperator != OperatorPlayerState)
+    {
+        LastRepOperator = OperatorPlayerState;
+        Bytes += EstimatedObjectRefBytes;
+    }
+
+    if (Bytes > 0)
+    {
+        EstimatedRepBytesTotal += Bytes;
+        INC_DWORD_STAT_BY(STAT_DirectorRepBytes, Bytes);
+        INC_DWORD_STAT_BY(STAT_DirectorRepBytesTotal, Bytes);
+        TRACE_COUNTER_ADD(DirectorRepBytes, Bytes);
+    }
 }
 
 
 // Replication handler: arm capture on clients; show switched/none toast
 void ADirectorGameState::OnRep_ActiveCamera()
 {
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorOnRepActiveCamera);
+
+    // Stamp arrival before arming capture so the capture stage is measured from here
+    if (UDirectorSwitchTelemetry* Telemetry = UDirectorSwitchTelemetry::Get(this))
+    {
+        Telemetry->NoteArrival(LastTransition, ActiveCamera, GetServerWorldTimeSeconds());
+    }
+
     // Ensure late-joining clients start capturing from the active camera
     if (ActiveCamera && ActiveCamera->SceneCapture)
     {
         if (ActiveCamera->RenderTarget)
         {
-            ActiveCamera->SceneCapture->TextureTarget = ActiveCamera->RenderTarget;
-            ActiveCamera->SceneCapture->bCaptureEveryFrame = true;
-            ActiveCamera->SceneCapture->CaptureScene();
-            UE_LOG(LogDirectorGS, Log, TEXT("[GS] OnRep ActiveCamera=%s (RT=%s)"), *ActiveCamera->GetName(), *GetNameSafe(ActiveCamera->RenderTarget));
+            ActiveCamera->SetCaptureEnabled(true);
+            UE_LOG(LogDirectorGS, Verbose, TEXT("[GS] OnRep ActiveCamera=%s (RT=%s)"), *ActiveCamera->GetName(), *GetNameSafe(ActiveCamera->RenderTarget));
 
             // Friendly on-screen cue so it's clear which camera is now active
             if (GEngine)
             {
-                const FString RigName = ActiveCamera->GetRigDisplayName();
-                const FString Msg = FString::Printf(TEXT("Switched to :  %s"), *RigName);
-                GEngine->AddOnScreenDebugMessage(770778, 2.5f, FColor::Cyan, Msg);
+                GEngine->AddOnScreenDebugMessage(770778, 2.5f, FColor::Cyan, ActiveCamera->GetSwitchedToast());
             }
         }
     }
     else
     {
-        UE_LOG(LogDirectorGS, Log, TEXT("[GS] OnRep ActiveCamera=None"));
+        UE_LOG(LogDirectorGS, Verbose, TEXT("[GS] OnRep ActiveCamera=None"));
         if (GEngine)
         {
-            GEngine->AddOnScreenDebugMessage(770778, 2.0f, FColor::Silver, TEXT("Active camera: none"));
+            static const FString NoneToast(TEXT("Active camera: none"));
+            GEngine->AddOnScreenDebugMessage(770778, 2.0f, FColor::Silver, NoneToast);
         }
     }
     OnActiveCameraChanged.Broadcast(ActiveCamera);
@@ -0,0 +1,211 @@
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "CombatActorPool.h"
+#include "CombatAIController.h"
+#include "CombatDamageableBox.h"
+#include "CombatEnemy.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "DirectorTestWorld.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // The combat classes are abstract (the game spawns their Blueprints); lets a test spawn the native class
+    struct FScopedSpawnableClass
+    {
+        UClass* Class;
+        bool bWasAbstract;
+
+        explicit FScopedSpawnableClass(UClass* InClass)
+            : Class(InClass)
+            , bWasAbstract(InClass->HasAnyClassFlags(CLASS_Abstract))
+        {
+            Class->ClassFlags &= ~CLASS_Abstract;
+        }
+
+        ~FScopedSpawnableClass()
+        {
+            if (bWasAbstract)
+            {
+                Class->ClassFlags |= CLASS_Abstract;
+            }
+        }
+    };
+
+    // Pooling on with a per-class cap, whatever the project config says, for the scope
+    struct FScopedPoolSettings
+    {
+        UCombatActorPoolSettings* Settings;
+        bool bWasEnabled;
+        int32 OldMaxPooled;
+
+        explicit FScopedPoolSettings(int32 MaxPooledPerClass)
+            : Settings(GetMutableDefault<UCombatActorPoolSettings>())
+            , bWasEnabled(Settings->bEnabled)
+            , OldMaxPooled(Settings->MaxPooledPerClass)
+        {
+            Settings->bEnabled = true;
+            Settings->MaxPooledPerClass = MaxPooledPerClass;
+        }
+
+        ~FScopedPoolSettings()
+        {
+            Settings->bEnabled = bWasEnabled;
+            Settings->MaxPooledPerClass = OldMaxPooled;
+        }
+    };
+}
+
+// A damageable box killed, parked and reused comes back as it spawned: same instance, visible, colliding,
+// alive object type, full HP, at the new transform; releasing it again while parked is a no-op, and releases past
+// MaxPooledPerClass destroy instead of parking
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatActorPoolResetTest, "ThirdPersonCameraMan.Combat.PoolReset",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatActorPoolResetTest::RunTest(const FString& Parameters)
+{
+    FDirectorTestWorld TestWorld(true);
+    UWorld* World = TestWorld.World;
+
+    UCombatActorPool* Pool = UCombatActorPool::Get(World);
+    if (!TestNotNull(TEXT("Pool"), Pool)) return false;
+
+    // An engine cube gives the box a body to simulate, as the game's Blueprint does
+    UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    const FScopedSpawnableClass SpawnableBox(ACombatDamageableBox::StaticClass());
+    auto SpawnBox = [World, Cube]()
+    {
+        ACombatDamageableBox* Box = World->SpawnActorDeferred<ACombatDamageableBox>(ACombatDamageableBox::StaticClass(), FTransform::Identity);
+        Box->FindComponentByClass<UStaticMeshComponent>()->SetStaticMesh(Cube);
+        Box->FinishSpawning(FTransform::Identity);
+        return Box;
+    };
+
+    const FScopedPoolSettings PoolSettings(1);
+
+    ACombatDamageableBox* Box = SpawnBox();
+    UStaticMeshComponent* Mesh = Box ? Box->FindComponentByClass<UStaticMeshComponent>() : nullptr;
+    if (!TestNotNull(TEXT("Box"), Box) || !TestNotNull(TEXT("Box mesh"), Mesh)) return false;
+    const ECollisionChannel AliveType = Mesh->GetCollisionObjectType();
+
+    // Kill it (3 HP) and park it
+    Box->ApplyDamage(3.f, nullptr, Box->GetActorLocation(), FVector::ZeroVector);
+    TestEqual(TEXT("Dead box ignores most traces"), Mesh->GetCollisionObjectType(), ECC_Visibility);
+    TestTrue(TEXT("Release parks it"), Pool->Release(Box));
+    TestTrue(TEXT("Parked box hidden"), Box->IsHidden());
+    TestFalse(TEXT("Parked box without collision"), Box->GetActorEnableCollision());
+    TestFalse(TEXT("Parked box not simulating"), Mesh->IsSimulatingPhysics());
+    TestTrue(TEXT("Second release of a parked box is a no-op"), Pool->Release(Box));
+    TestTrue(TEXT("Box still parked after the second release"), IsValid(Box) && !Box->IsActorBeingDestroyed());
+
+    // Reuse
+    const FTransform SpawnAt(FRotator(0.f, 90.f, 0.f), FVector(500.f, 0.f, 100.f));
+    ACombatDamageableBox* Reused = Pool->Acquire<ACombatDamageableBox>(ACombatDamageableBox::StaticClass(), SpawnAt);
+    TestTrue(TEXT("Acquire reuses the parked instance"), Reused == Box);
+    TestFalse(TEXT("Reused box visible"), Box->IsHidden());
+    TestTrue(TEXT("Reused box collides"), Box->GetActorEnableCollision());
+    TestTrue(TEXT("Reused box simulates"), Mesh->IsSimulatingPhysics());
+    TestEqual(TEXT("Reused box alive object type"), Mesh->GetCollisionObjectType(), AliveType);
+    TestTrue(TEXT("Reused box at the spawn transform"), Box->GetActorLocation().Equals(SpawnAt.GetLocation(), 1.f));
+    ACombatDamageableBox* Other = Pool->Acquire<ACombatDamageableBox>(ACombatDamageableBox::StaticClass(), SpawnAt);
+    TestTrue(TEXT("A double release doesn't hand the box out twice"), Other && Other != Box);
+    if (Other)
+    {
+        Other->Destroy();
+    }
+
+    // Full HP again: two hits leave it alive, the third kills it
+    Box->ApplyDamage(2.f, nullptr, Box->GetActorLocation(), FVector::ZeroVector);
+    TestEqual(TEXT("HP restored on reuse"), Mesh->GetCollisionObjectType(), AliveType);
+    Box->ApplyDamage(1.f, nullptr, Box->GetActorLocation(), FVector::ZeroVector);
+    TestEqual(TEXT("Reused box dies at its starting HP"), Mesh->GetCollisionObjectType(), ECC_Visibility);
+
+    // The class's only pool slot is taken: the second release destroys
+    ACombatDamageableBox* Extra = SpawnBox();
+    TestTrue(TEXT("First release parks"), Pool->Release(Box));
+    TestFalse(TEXT("Release past MaxPooledPerClass destroys"), Pool->Release(Extra));
+    TestTrue(TEXT("Extra box destroyed"), !IsValid(Extra) || Extra->IsActorBeingDestroyed());
+
+    // An empty pool spawns
+    Pool->Empty();
+    ACombatDamageableBox* Fresh = Pool->Acquire<ACombatDamageableBox>(ACombatDamageableBox::StaticClass(), SpawnAt);
+    TestTrue(TEXT("Empty pool spawns a new box"), Fresh && Fresh != Box);
+
+    return true;
+}
+
+// An enemy killed mid ragdoll, parked and reused comes back as it spawned: StateTree stopped while parked and the
+// same controller and brain take it back (the tree asset itself lives in the game's Blueprint), ragdoll off with the
+// mesh back on the capsule at its starting transform, capsule collision from the class defaults, full HP, at the
+// new transform. A second release while parked is a no-op, so the enemy is never handed out twice
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatEnemyPoolResetTest, "ThirdPersonCameraMan.Combat.EnemyPoolReset",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatEnemyPoolResetTest::RunTest(const FString& Parameters)
+{
+    FDirectorTestWorld TestWorld(true);
+    UWorld* World = TestWorld.World;
+
+    UCombatActorPool* Pool = UCombatActorPool::Get(World);
+    if (!TestNotNull(TEXT("Pool"), Pool)) return false;
+
+    const FScopedPoolSettings PoolSettings(4);
+    const FScopedSpawnableClass SpawnableEnemy(ACombatEnemy::StaticClass());
+    const FScopedSpawnableClass SpawnableController(ACombatAIController::StaticClass());
+
+    ACombatEnemy* Enemy = Pool->Acquire<ACombatEnemy>(ACombatEnemy::StaticClass(), FTransform(FVector(0.f, 0.f, 100.f)));
+    if (!TestNotNull(TEXT("Enemy"), Enemy)) return false;
+    AAIController* AIController = Cast<AAIController>(Enemy->GetController());
+    UBrainComponent* Brain = AIController ? AIController->GetBrainComponent() : nullptr;
+    if (!TestNotNull(TEXT("Enemy possessed by its AI controller"), AIController) || !TestNotNull(TEXT("StateTree brain"), Brain)) return false;
+
+    UCapsuleComponent* Capsule = Enemy->GetCapsuleComponent();
+    USkeletalMeshComponent* Mesh = Enemy->GetMesh();
+    const ACombatEnemy* Defaults = GetDefault<ACombatEnemy>();
+    const FTransform MeshStart = Mesh->GetRelativeTransform();
+    const float StartHP = Enemy->CurrentHP;
+
+    // Kill it; the ragdolled mesh comes off the capsule and falls away
+    Enemy->ApplyDamage(StartHP, nullptr, Enemy->GetActorLocation(), FVector::ZeroVector);
+    TestTrue(TEXT("Enemy dead"), Enemy->CurrentHP <= 0.f);
+    TestEqual(TEXT("Dead capsule without collision"), Capsule->GetCollisionEnabled(), ECollisionEnabled::NoCollision);
+    Mesh->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+    Mesh->SetWorldLocation(Enemy->GetActorLocation() + FVector(150.f, 0.f, -80.f));
+
+    TestTrue(TEXT("Release parks it"), Pool->Release(Enemy));
+    TestTrue(TEXT("Parked enemy hidden"), Enemy->IsHidden());
+    TestFalse(TEXT("Parked enemy without collision"), Enemy->GetActorEnableCollision());
+    TestFalse(TEXT("StateTree stopped while parked"), Brain->IsRunning());
+    TestFalse(TEXT("Parked ragdoll not simulating"), Mesh->IsSimulatingPhysics());
+    TestTrue(TEXT("Parked mesh back on the capsule"), Mesh->GetAttachParent() == Capsule);
+    TestTrue(TEXT("Parked mesh at its starting transform"), Mesh->GetRelativeTransform().Equals(MeshStart, 0.1f));
+    TestTrue(TEXT("Second release of a parked enemy is a no-op"), Pool->Release(Enemy));
+
+    // Reuse
+    const FTransform SpawnAt(FRotator(0.f, 90.f, 0.f), FVector(800.f, 0.f, 100.f));
+    ACombatEnemy* Reused = Pool->Acquire<ACombatEnemy>(ACombatEnemy::StaticClass(), SpawnAt);
+    TestTrue(TEXT("Acquire reuses the parked enemy"), Reused == Enemy);
+    TestFalse(TEXT("Reused enemy visible"), Enemy->IsHidden());
+    TestTrue(TEXT("Reused enemy collides"), Enemy->GetActorEnableCollision());
+    TestEqual(TEXT("Capsule collision from the class defaults"), Capsule->GetCollisionEnabled(), Defaults->GetCapsuleComponent()->GetCollisionEnabled());
+    TestEqual(TEXT("HP restored on reuse"), Enemy->CurrentHP, StartHP);
+    TestTrue(TEXT("Reused enemy at the spawn transform"), Enemy->GetActorLocation().Equals(SpawnAt.GetLocation(), 1.f));
+    TestTrue(TEXT("Reused enemy moves again"), Enemy->GetCharacterMovement()->MovementMode != MOVE_None);
+    TestTrue(TEXT("Same controller takes it back"), Enemy->GetController() == AIController && AIController->GetBrainComponent() == Brain);
+    TestTrue(TEXT("Reused mesh on the capsule at its starting transform"),
+        Mesh->GetAttachParent() == Capsule && Mesh->GetRelativeTransform().Equals(MeshStart, 0.1f));
+
+    // The double release parked it once: the next acquire spawns
+    ACombatEnemy* Fresh = Pool->Acquire<ACombatEnemy>(ACombatEnemy::StaticClass(), FTransform(FVector(-800.f, 0.f, 100.f)));
+    TestTrue(TEXT("A double release doesn't hand the enemy out twice"), Fresh && Fresh != Enemy);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "CombatRagdollManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// The ragdoll budget on its own: nearest first, age pushes old ragdolls back, a ragdoll that doesn't fit doesn't
+// stop a smaller one behind it from fitting, and a zero budget keeps nothing
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatRagdollBudgetTest, "ThirdPersonCameraMan.Combat.RagdollBudget",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatRagdollBudgetTest::RunTest(const FString& Parameters)
+{
+    using FCandidate = UCombatRagdollManager::FBudgetCandidate;
+
+    auto Candidate = [](float Distance, float Age, int32 Bodies)
+    {
+        FCandidate Result;
+        Result.Distance = Distance;
+        Result.Age = Age;
+        Result.Bodies = Bodies;
+        return Result;
+    };
+
+    TArray<int32> OverBudget;
+
+    // Everything fits
+    const TArray<FCandidate> Few = { Candidate(100.f, 0.f, 20), Candidate(200.f, 0.f, 20) };
+    TestEqual(TEXT("All kept"), UCombatRagdollManager::SelectOverBudget(Few, 100, 500.f, OverBudget), 40);
+    TestEqual(TEXT("None over budget"), OverBudget.Num(), 0);
+
+    // Room for two of three: the farthest goes
+    const TArray<FCandidate> Three = { Candidate(3000.f, 0.f, 20), Candidate(100.f, 0.f, 20), Candidate(1000.f, 0.f, 20) };
+    TestEqual(TEXT("Nearest two kept"), UCombatRagdollManager::SelectOverBudget(Three, 40, 500.f, OverBudget), 40);
+    TestTrue(TEXT("Farthest over budget"), OverBudget == TArray<int32>{ 0 });
+
+    // At the same range, the one that has simulated longest goes
+    const TArray<FCandidate> Aged = { Candidate(500.f, 3.f, 20), Candidate(500.f, 0.5f, 20) };
+    UCombatRagdollManager::SelectOverBudget(Aged, 20, 500.f, OverBudget);
+    TestTrue(TEXT("Oldest over budget"), OverBudget == TArray<int32>{ 0 });
+
+    // Age counts as distance: 2 s at 500 cm/s puts a ragdoll at 100 cm behind a new one at 1000 cm
+    const TArray<FCandidate> AgeVsRange = { Candidate(100.f, 2.f, 20), Candidate(1000.f, 0.f, 20) };
+    UCombatRagdollManager::SelectOverBudget(AgeVsRange, 20, 500.f, OverBudget);
+    TestTrue(TEXT("Old near ragdoll ranks behind a new far one"), OverBudget == TArray<int32>{ 0 });
+    UCombatRagdollManager::SelectOverBudget(AgeVsRange, 20, 0.f, OverBudget);
+    TestTrue(TEXT("Without ageing, range alone decides"), OverBudget == TArray<int32>{ 1 });
+
+    // A big ragdoll that doesn't fit doesn't block a smaller one ranked after it
+    const TArray<FCandidate> Mixed = { Candidate(100.f, 0.f, 30), Candidate(200.f, 0.f, 30), Candidate(300.f, 0.f, 10) };
+    TestEqual(TEXT("Smaller one fills the gap"), UCombatRagdollManager::SelectOverBudget(Mixed, 45, 500.f, OverBudget), 40);
+    TestTrue(TEXT("Only the big one over budget"), OverBudget == TArray<int32>{ 1 });
+
+    // No budget
+    TestEqual(TEXT("Zero budget keeps nothing"), UCombatRagdollManager::SelectOverBudget(Three, 0, 500.f, OverBudget), 0);
+    TestEqual(TEXT("Zero budget puts everything over"), OverBudget.Num(), 3);
+
+    // Nothing simulating
+    TestEqual(TEXT("No candidates"), UCombatRagdollManager::SelectOverBudget({}, 100, 500.f, OverBudget), 0);
+    TestEqual(TEXT("No candidates over budget"), OverBudget.Num(), 0);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,70 @@
+#include "CombatSignificanceSubsystem.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Significance rating on its own: the distance bands, hysteresis on the way up, hidden views counting farther,
+// and the nearest view deciding when there are several
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatSignificanceRateTest, "ThirdPersonCameraMan.Combat.SignificanceRating",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatSignificanceRateTest::RunTest(const FString& Parameters)
+{
+    using FView = UCombatSignificanceSubsystem::FView;
+    constexpr ECombatSignificance High = ECombatSignificance::High;
+    constexpr ECombatSignificance Medium = ECombatSignificance::Medium;
+    constexpr ECombatSignificance Low = ECombatSignificance::Low;
+
+    // Fixed tuning, whatever DefaultGame.ini says
+    UCombatSignificanceSettings* Settings = NewObject<UCombatSignificanceSettings>();
+    Settings->FullDetailDistance = 1500.f;
+    Settings->ReducedDetailDistance = 4000.f;
+    Settings->HiddenDistanceScale = 2.f;
+    Settings->Hysteresis = 200.f;
+
+    // Looking down +X with a 90 degree cone
+    FView Forward;
+    Forward.Location = FVector::ZeroVector;
+    Forward.Direction = FVector::ForwardVector;
+    Forward.CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(45.f));
+    const TArray<FView> Views = { Forward };
+
+    auto Rate = [&Views, Settings](float X, ECombatSignificance Current, bool bRendered = true)
+    {
+        return UCombatSignificanceSubsystem::Rate(FVector(X, 0.f, 0.f), Current, Views, bRendered, *Settings);
+    };
+
+    // Bands, staying where they are
+    TestEqual(TEXT("Near is High"), Rate(1000.f, High), High);
+    TestEqual(TEXT("High holds up to the threshold"), Rate(1500.f, High), High);
+    TestEqual(TEXT("Past full detail is Medium"), Rate(1600.f, High), Medium);
+    TestEqual(TEXT("Medium holds up to the threshold"), Rate(4000.f, Medium), Medium);
+    TestEqual(TEXT("Past reduced detail is Low"), Rate(4100.f, Medium), Low);
+
+    // Moving up takes coming Hysteresis closer than the threshold
+    TestEqual(TEXT("Medium stays Medium just inside full detail"), Rate(1400.f, Medium), Medium);
+    TestEqual(TEXT("Medium goes High past the margin"), Rate(1250.f, Medium), High);
+    TestEqual(TEXT("Low stays Low just inside reduced detail"), Rate(3900.f, Low), Low);
+    TestEqual(TEXT("Low goes Medium past the margin"), Rate(3750.f, Low), Medium);
+    TestEqual(TEXT("Low can jump straight to High"), Rate(1000.f, Low), High);
+
+    // Unseen: behind the view or not rendered counts HiddenDistanceScale farther
+    TestEqual(TEXT("Behind the view counts farther"), UCombatSignificanceSubsystem::Rate(FVector(-1000.f, 0.f, 0.f), High, Views, true, *Settings), Medium);
+    TestEqual(TEXT("Occluded counts farther"), Rate(1000.f, High, false), Medium);
+    TestEqual(TEXT("Occluded and far is Low"), Rate(2500.f, High, false), Low);
+
+    // The nearest view decides: a second view behind the actor that is close enough keeps it High
+    FView Behind;
+    Behind.Location = FVector(-2000.f, 0.f, 0.f);
+    Behind.Direction = FVector::ForwardVector;
+    Behind.CosHalfAngle = Forward.CosHalfAngle;
+    const TArray<FView> TwoViews = { Forward, Behind };
+    TestEqual(TEXT("Nearest view wins"), UCombatSignificanceSubsystem::Rate(FVector(-1000.f, 0.f, 0.f), Low, TwoViews, true, *Settings), High);
+
+    // A view sitting on the actor sees it
+    TestEqual(TEXT("Actor at the view"), Rate(0.f, Low), High);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,65 @@
+#include "CameraRig.h"
+#include "DirectorGameState.h"
+#include "DirectorTestWorld.h"
+#include "Misc/AutomationTest.h"
+#include "ThirdPersonCameraManGameMode.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Carry a rig, let the auto-director cut to a fixed one, then pick up a third: the operator ends up carrying only
+// the new rig, and the one they had is put down where it was instead of riding along with its capture off
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirectorCarriedRigHandOffTest, "ThirdPersonCameraMan.Director.CarriedRigHandOff",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDirectorCarriedRigHandOffTest::RunTest(const FString& Parameters)
+{
+    FDirectorTestWorld TestWorld(true, AThirdPersonCameraManGameMode::StaticClass());
+    UWorld* World = TestWorld.World;
+
+    ADirectorGameState* GS = World->GetGameState<ADirectorGameState>();
+    if (!TestNotNull(TEXT("GameState"), GS)) return false;
+
+    ACameraRig* First = World->SpawnActor<ACameraRig>(FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator);
+    ACameraRig* Fixed = World->SpawnActor<ACameraRig>(FVector(2000.f, 0.f, 300.f), FRotator::ZeroRotator);
+    ACameraRig* Second = World->SpawnActor<ACameraRig>(FVector(-2000.f, 0.f, 100.f), FRotator::ZeroRotator);
+    APawn* Operator = TestWorld.SpawnOperator(FVector(0.f, 3000.f, 100.f));
+    if (!TestTrue(TEXT("Rigs"), First && Fixed && Second) || !TestNotNull(TEXT("Operator"), Operator)) return false;
+
+    auto CountCarried = [Operator]()
+    {
+        int32 Count = 0;
+        Operator->ForEachAttachedActors([&Count](AActor* Attached)
+        {
+            Count += Attached->IsA<ACameraRig>() ? 1 : 0;
+            return true;
+        });
+        return Count;
+    };
+
+    // Past the switch lock between commits
+    const int32 LockFrames = FMath::CeilToInt(0.2f * 60.f);
+
+    First->RequestPickup(Operator);
+    TestTrue(TEXT("Picked-up rig live"), GS->ActiveCamera == First);
+    TestTrue(TEXT("Picked-up rig carried"), First->GetAttachParentActor() == Operator);
+    TestWorld.Tick(LockFrames);
+
+    // The cut the auto-director takes: the fixed rig goes live where it stands
+    Fixed->RequestGoLive();
+    TestTrue(TEXT("Auto cut live"), GS->ActiveCamera == Fixed);
+    TestFalse(TEXT("Carried rig no longer live"), First->IsActiveOnServer());
+    TestWorld.Tick(LockFrames);
+
+    const FVector PutDownAt = First->GetActorLocation();
+    Second->RequestPickup(Operator);
+    TestTrue(TEXT("Second pickup live"), GS->ActiveCamera == Second);
+    TestTrue(TEXT("Second rig carried"), Second->GetAttachParentActor() == Operator);
+    TestNull(TEXT("First rig put down"), First->GetAttachParentActor());
+    TestTrue(TEXT("First rig left where it was"), First->GetActorLocation().Equals(PutDownAt, 1.f));
+    TestNull(TEXT("Fixed rig untouched"), Fixed->GetAttachParentActor());
+    TestEqual(TEXT("Operator carries one rig"), CountCarried(), 1);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "CameraRig.h"
+#include "DirectorBenchmark.h"
+#include "DirectorGameState.h"
+#include "DirectorTestWorld.h"
+#include "GameFramework/PlayerState.h"
+#include "Misc/AutomationTest.h"
+#include "ThirdPersonCameraManGameMode.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    struct FCutAllocations
+    {
+        // Game-thread allocations of two batches of warm switches, each through RequestSwitchTo -> Server_SwitchTo
+        // -> Server_AttachToPawn
+        int64 FirstBatch = 0;
+        int64 SecondBatch = 0;
+        // The director's own lookups for the same cut ("player N", the interned toasts)
+        int64 DirectorLookups = 0;
+        bool bAllCutsLive = false;
+    };
+
+    // Switches the operator back and forth between two rigs in a world where they joined after OtherPlayers others
+    FCutAllocations MeasureCuts(int32 OtherPlayers, int32 CutsPerBatch)
+    {
+        FCutAllocations Result;
+        FDirectorTestWorld TestWorld(true, AThirdPersonCameraManGameMode::StaticClass());
+        UWorld* World = TestWorld.World;
+        ADirectorGameState* GS = World->GetGameState<ADirectorGameState>();
+        if (!GS) return Result;
+
+        for (int32 i = 0; i < OtherPlayers; ++i)
+        {
+            GS->AddPlayerState(World->SpawnActor<APlayerState>());
+        }
+        APawn* Operator = TestWorld.SpawnOperator(FVector(0.f, 3000.f, 100.f));
+        ACameraRig* A = World->SpawnActor<ACameraRig>(FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator);
+        ACameraRig* B = World->SpawnActor<ACameraRig>(FVector(0.f, 600.f, 100.f), FRotator::ZeroRotator);
+        if (!Operator || !A || !B) return Result;
+
+        const int32 LockFrames = FMath::CeilToInt(0.2f * 60.f);
+        A->RequestPickup(Operator);
+        TestWorld.Tick(LockFrames);
+
+        // Only the cut itself is counted, not the frames ticked past the switch lock
+        auto RunBatch = [&](int64& OutAllocs)
+        {
+            OutAllocs = 0;
+            for (int32 Cut = 0; Cut < CutsPerBatch; ++Cut)
+            {
+                ACameraRig* From = GS->ActiveCamera;
+                ACameraRig* To = From == A ? B : A;
+                const uint64 Before = DirectorAllocCounter::GetThreadCount();
+                From->RequestSwitchTo(To);
+                OutAllocs += static_cast<int64>(DirectorAllocCounter::GetThreadCount() - Before);
+                if (GS->ActiveCamera != To) return false;
+                TestWorld.Tick(LockFrames);
+            }
+            return true;
+        };
+
+        // Warm: first use formats this player's toast and grows the attach and on-screen message arrays
+        int64 WarmUp = 0;
+        Result.bAllCutsLive = RunBatch(WarmUp) && RunBatch(Result.FirstBatch) && RunBatch(Result.SecondBatch);
+
+        const uint64 Before = DirectorAllocCounter::GetThreadCount();
+        const int32 PlayerNum = GS->GetPlayerNumber(Operator->GetPlayerState());
+        const int32 Checksum = A->GetPickupToast(PlayerNum).Len() + A->GetSwitchedToast().Len() + A->GetDroppedToast().Len();
+        Result.DirectorLookups = static_cast<int64>(DirectorAllocCounter::GetThreadCount() - Before);
+        Result.bAllCutsLive &= PlayerNum == OtherPlayers + 1 && Checksum > 0;
+        return Result;
+    }
+}
+
+// Real cuts through a game world: once warm, a cut allocates no more later in a session than earlier, no more
+// with sixteen players than with one, and the director's own lookups on it allocate nothing. Engine work on the
+// path (RPCs, attach, the on-screen message list) is counted but only has to stay flat; director.Bench reports it
+// as allocs_per_cut. Counting needs -DirectorBenchAllocs; without it the test is skipped
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirectorCutAllocationTest, "ThirdPersonCameraMan.Director.CutPathAllocations",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDirectorCutAllocationTest::RunTest(const FString& Parameters)
+{
+    if (!DirectorAllocCounter::IsInstalled())
+    {
+        AddWarning(TEXT("Skipped: allocation counter not installed; run the tests with -DirectorBenchAllocs"));
+        return true;
+    }
+
+    constexpr int32 CutsPerBatch = 20;
+    const FCutAllocations Solo = MeasureCuts(0, CutsPerBatch);
+    const FCutAllocations Crowd = MeasureCuts(15, CutsPerBatch);
+    if (!TestTrue(TEXT("Every solo cut went live"), Solo.bAllCutsLive) || !TestTrue(TEXT("Every crowd cut went live"), Crowd.bAllCutsLive)) return false;
+
+    AddInfo(FString::Printf(TEXT("Allocations per cut: %.1f solo, %.1f with 16 players"),
+        static_cast<double>(Solo.SecondBatch) / CutsPerBatch, static_cast<double>(Crowd.SecondBatch) / CutsPerBatch));
+
+    TestTrue(TEXT("Solo cuts don't allocate more as the session goes on"), Solo.SecondBatch <= Solo.FirstBatch);
+    TestTrue(TEXT("Crowd cuts don't allocate more as the session goes on"), Crowd.SecondBatch <= Crowd.FirstBatch);
+    TestTrue(TEXT("Cuts don't allocate more with more players"), Crowd.SecondBatch <= Solo.SecondBatch);
+    TestEqual(TEXT("Director lookups allocate nothing (solo)"), Solo.DirectorLookups, int64(0));
+    TestEqual(TEXT("Director lookups allocate nothing (16 players)"), Crowd.DirectorLookups, int64(0));
+
+    return true;
+}
+
+#endif
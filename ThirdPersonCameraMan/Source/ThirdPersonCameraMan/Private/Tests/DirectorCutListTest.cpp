@@ -0,0 +1,135 @@
+#include "CameraRig.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "DirectorCutList.h"
+#include "DirectorGameState.h"
+#include "DirectorTestWorld.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "ThirdPersonCameraManGameMode.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Plays a two-cut list over the operator's carried rig: each cut commits once with its own transition id,
+// the capture profile is applied ahead of its cut, and at the end every rig has its own capture settings back
+// and the operator's rig is live again. Runs under a fixed 1/60 step, so each cut must commit on its own frame;
+// a replay through a hitch lands off frame and fails the report. The list is built here, so the test needs no content
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirectorCutListPlaybackTest, "ThirdPersonCameraMan.Director.CutListPlayback",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDirectorCutListPlaybackTest::RunTest(const FString& Parameters)
+{
+    // The step the test world is ticked with, as -benchmark -fps=60 would set it
+    const bool bWasFixedStep = FApp::UseFixedTimeStep();
+    const double OldFixedDt = FApp::GetFixedDeltaTime();
+    FApp::SetUseFixedTimeStep(true);
+    FApp::SetFixedDeltaTime(1.0 / 60.0);
+    ON_SCOPE_EXIT
+    {
+        FApp::SetUseFixedTimeStep(bWasFixedStep);
+        FApp::SetFixedDeltaTime(OldFixedDt);
+    };
+
+    FDirectorTestWorld TestWorld(true, AThirdPersonCameraManGameMode::StaticClass());
+    UWorld* World = TestWorld.World;
+
+    ADirectorGameState* GS = World->GetGameState<ADirectorGameState>();
+    UDirectorCutListPlayer* Player = UDirectorCutListPlayer::Get(World);
+    if (!TestNotNull(TEXT("GameState"), GS) || !TestNotNull(TEXT("Cut list player"), Player)) return false;
+
+    auto SpawnRig = [World](const TCHAR* Label)
+    {
+        ACameraRig* Rig = World->SpawnActor<ACameraRig>();
+        Rig->RigLabel = Label;
+        return Rig;
+    };
+    ACameraRig* Carried = SpawnRig(TEXT("Carried"));
+    ACameraRig* Wide = SpawnRig(TEXT("Wide"));
+    ACameraRig* Close = SpawnRig(TEXT("Close"));
+    APawn* Operator = TestWorld.SpawnOperator(FVector(0.f, 3000.f, 100.f));
+    if (!TestTrue(TEXT("Rigs"), Carried && Wide && Close) || !TestNotNull(TEXT("Scene capture"), Wide->SceneCapture) || !TestNotNull(TEXT("Operator"), Operator)) return false;
+
+    // The operator is filming with a rig on their pawn
+    Carried->RequestPickup(Operator);
+    if (!TestTrue(TEXT("Carried rig live before playback"), GS->ActiveCamera == Carried)) return false;
+
+    const float WideFOV = Wide->SceneCapture->FOVAngle;
+    const float WideDistance = Wide->SceneCapture->MaxViewDistanceOverride;
+
+    UDirectorCutList* CutList = NewObject<UDirectorCutList>();
+    CutList->PrewarmLeadSeconds = 0.1f;
+
+    FDirectorCutEntry& First = CutList->Cuts.AddDefaulted_GetRef();
+    First.Time = 0.25f;
+    First.Rig = TEXT("Wide");
+    First.CaptureProfile.FOVAngle = 30.f;
+    First.CaptureProfile.MaxViewDistance = 5000.f;
+
+    FDirectorCutEntry& Missing = CutList->Cuts.AddDefaulted_GetRef();
+    Missing.Time = 0.4f;
+    Missing.Rig = TEXT("Nobody");
+
+    FDirectorCutEntry& Second = CutList->Cuts.AddDefaulted_GetRef();
+    Second.Time = 0.5f;
+    Second.Rig = TEXT("Close");
+
+    if (!TestTrue(TEXT("Play"), Player->Play(CutList))) return false;
+
+    // Just past the first pre-warm: profile applied, cut not taken yet
+    TestWorld.Tick(10);
+    TestEqual(TEXT("Profile FOV applied ahead of the cut"), Wide->SceneCapture->FOVAngle, 30.f);
+    TestEqual(TEXT("Profile view distance applied ahead of the cut"), Wide->SceneCapture->MaxViewDistanceOverride, 5000.f);
+    TestTrue(TEXT("Carried rig still live during pre-warm"), GS->ActiveCamera == Carried);
+
+    // First cut
+    const int32 CarriedTransition = GS->LastTransition.Id;
+    TestWorld.Tick(6);
+    TestTrue(TEXT("First cut live"), GS->ActiveCamera == Wide);
+    TestEqual(TEXT("First cut is one transition"), GS->LastTransition.Id, CarriedTransition + 1);
+
+    // Second cut, then the end of playback hands back to the operator
+    const int32 FirstTransition = GS->LastTransition.Id;
+    TestWorld.Tick(16);
+    TestFalse(TEXT("Playback finished"), Player->IsPlaying());
+    TestTrue(TEXT("Every scheduled cut on time"), Player->PrintReport());
+    // 0.25 s and 0.5 s at 60 Hz
+    const int32 DueFrames[] = { 15, 30 };
+    if (TestEqual(TEXT("Missing rig not scheduled"), Player->GetNumScheduledCuts(), 2))
+    {
+        for (int32 i = 0; i < 2; ++i)
+        {
+            int32 ExpectedFrame = INDEX_NONE;
+            int32 CommitFrame = INDEX_NONE;
+            TestTrue(FString::Printf(TEXT("Cut %d committed"), i), Player->GetCutFrames(i, ExpectedFrame, CommitFrame));
+            TestEqual(FString::Printf(TEXT("Cut %d expected frame"), i), ExpectedFrame, DueFrames[i]);
+            TestEqual(FString::Printf(TEXT("Cut %d on its frame"), i), CommitFrame, ExpectedFrame);
+        }
+    }
+    TestEqual(TEXT("Second cut and hand-back are one transition each"), GS->LastTransition.Id, FirstTransition + 2);
+
+    TestTrue(TEXT("Operator's rig live again"), GS->ActiveCamera == Carried);
+    TestTrue(TEXT("Operator still carries it"), Carried->GetAttachParentActor() == Operator);
+    TestEqual(TEXT("FOV restored"), Wide->SceneCapture->FOVAngle, WideFOV);
+    TestEqual(TEXT("View distance restored"), Wide->SceneCapture->MaxViewDistanceOverride, WideDistance);
+
+    // Replay the first cut through a hitch: ten frames, then one frame of ten steps crossing 0.25 s.
+    // The cut is taken on frame 11, after its time, instead of on frame 15, and the report fails
+    CutList->Cuts.SetNum(1);
+    if (!TestTrue(TEXT("Replay"), Player->Play(CutList))) return false;
+    TestWorld.Tick(10);
+    TestTrue(TEXT("Not due before the hitch"), GS->ActiveCamera == Carried);
+    TestWorld.Tick(1, 10.f / 60.f);
+    TestFalse(TEXT("Replay finished"), Player->IsPlaying());
+
+    int32 ExpectedFrame = INDEX_NONE;
+    int32 CommitFrame = INDEX_NONE;
+    TestTrue(TEXT("Late cut still committed"), Player->GetCutFrames(0, ExpectedFrame, CommitFrame));
+    TestEqual(TEXT("Late cut expected frame"), ExpectedFrame, 15);
+    TestEqual(TEXT("Late cut frame"), CommitFrame, 11);
+    TestFalse(TEXT("Late cut fails the report"), Player->PrintReport());
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "DirectorFeedCompositor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// The CPU reference composite (the maths director.FeedCompositeCheck holds the GPU path to) on small solid frames:
+// endpoints of every style, the crossfade and dip midpoints, the wipe edge, and short inputs
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirectorFeedCompositorTest, "ThirdPersonCameraMan.Director.FeedCompositeCPU",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDirectorFeedCompositorTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 Width = 8;
+    constexpr int32 Height = 2;
+    const FColor FromColor(200, 100, 0, 255);
+    const FColor ToColor(0, 50, 250, 255);
+
+    TArray<FColor> From, To, Out;
+    From.Init(FromColor, Width * Height);
+    To.Init(ToColor, Width * Height);
+
+    auto AllEqual = [&Out](const FColor& Expected)
+    {
+        return Out.Num() > 0 && !Out.ContainsByPredicate([&Expected](const FColor& Pixel) { return Pixel != Expected; });
+    };
+
+    static const EDirectorTransitionStyle Styles[] = { EDirectorTransitionStyle::Crossfade, EDirectorTransitionStyle::DipToBlack, EDirectorTransitionStyle::Wipe };
+    for (const EDirectorTransitionStyle Style : Styles)
+    {
+        const FString Name = UEnum::GetDisplayValueAsText(Style).ToString();
+
+        FDirectorFeedCompositor::CompositeCPU(From, To, Width, Height, Style, 0.f, Out);
+        TestTrue(*FString::Printf(TEXT("%s at 0 shows From"), *Name), AllEqual(FromColor));
+
+        FDirectorFeedCompositor::CompositeCPU(From, To, Width, Height, Style, 1.f, Out);
+        TestTrue(*FString::Printf(TEXT("%s at 1 shows To"), *Name), AllEqual(ToColor));
+    }
+
+    FDirectorFeedCompositor::CompositeCPU(From, To, Width, Height, EDirectorTransitionStyle::Crossfade, 0.5f, Out);
+    TestTrue(TEXT("Crossfade midpoint"), AllEqual(FColor(100, 75, 125, 255)));
+
+    FDirectorFeedCompositor::CompositeCPU(From, To, Width, Height, EDirectorTransitionStyle::DipToBlack, 0.5f, Out);
+    TestTrue(TEXT("Dip midpoint is black"), AllEqual(FColor(0, 0, 0, 255)));
+
+    FDirectorFeedCompositor::CompositeCPU(From, To, Width, Height, EDirectorTransitionStyle::DipToBlack, 0.25f, Out);
+    TestTrue(TEXT("Dip first half fades From"), AllEqual(FColor(100, 50, 0, 255)));
+
+    FDirectorFeedCompositor::CompositeCPU(From, To, Width, Height, EDirectorTransitionStyle::Wipe, 0.25f, Out);
+    const int32 Split = FDirectorFeedCompositor::WipeSplit(Width, 0.25f);
+    TestEqual(TEXT("Wipe split in whole pixels"), Split, 2);
+    bool bWipeEdge = Out.Num() == Width * Height;
+    for (int32 y = 0; y < Height && bWipeEdge; ++y)
+    {
+        for (int32 x = 0; x < Width; ++x)
+        {
+            bWipeEdge &= Out[y * Width + x] == (x < Split ? ToColor : FromColor);
+        }
+    }
+    TestTrue(TEXT("Wipe shows To left of the edge and From right of it"), bWipeEdge);
+
+    // Plain cuts have nothing to blend: the output is the outgoing frame until the switch
+    FDirectorFeedCompositor::CompositeCPU(From, To, Width, Height, EDirectorTransitionStyle::Cut, 0.5f, Out);
+    TestTrue(TEXT("Cut passes From through"), AllEqual(FromColor));
+
+    // Inputs smaller than the frame: no output rather than a frame of uninitialized pixels
+    const TArray<FColor> Short = { FromColor };
+    FDirectorFeedCompositor::CompositeCPU(Short, To, Width, Height, EDirectorTransitionStyle::Crossfade, 0.5f, Out);
+    TestEqual(TEXT("Short From leaves Out empty"), Out.Num(), 0);
+    FDirectorFeedCompositor::CompositeCPU(From, To, Width, Height, EDirectorTransitionStyle::Crossfade, 0.5f, Out);
+    FDirectorFeedCompositor::CompositeCPU(From, Short, Width, Height, EDirectorTransitionStyle::Wipe, 0.5f, Out);
+    TestEqual(TEXT("Short To clears a previous frame"), Out.Num(), 0);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include "DirectorRigStabilizer.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// The SIMD spring pass against a scalar version of the same closed form, over a rig count that isn't a multiple
+// of four; a parked lane (decay 0) lands on its target; a spring released from rest never overshoots
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirectorRigStabilizerKernelTest, "ThirdPersonCameraMan.Director.StabilizerKernel",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDirectorRigStabilizerKernelTest::RunTest(const FString& Parameters)
+{
+    using FLanes = UDirectorRigStabilizer::FSpringLanes;
+    constexpr int32 NumChannels = UDirectorRigStabilizer::NumChannels;
+    constexpr int32 NumRigs = 7;
+    constexpr float Dt = 1.f / 60.f;
+
+    FLanes Lanes;
+    Lanes.SetNum(NumRigs);
+    TestEqual(TEXT("Lanes padded to a multiple of four"), Lanes.NumLanes, 8);
+
+    for (int32 i = 0; i < Lanes.NumLanes; ++i)
+    {
+        for (int32 c = 0; c < NumChannels; ++c)
+        {
+            Lanes.Value[c][i] = static_cast<float>(i * 10 + c);
+            Lanes.Velocity[c][i] = static_cast<float>(c - i);
+            Lanes.Target[c][i] = static_cast<float>((i * 37 + c * 11) % 50) - 25.f;
+        }
+        Lanes.Omega[i] = 2.f / (0.05f + 0.05f * i);
+        Lanes.Decay[i] = FMath::Exp(-Lanes.Omega[i] * Dt);
+    }
+    Lanes.Decay[2] = 0.f;   // parked
+
+    // Scalar reference of the documented step
+    FLanes Expected = Lanes;
+    for (int32 i = 0; i < Expected.NumLanes; ++i)
+    {
+        const float W = Expected.Omega[i];
+        const float E = Expected.Decay[i];
+        for (int32 c = 0; c < NumChannels; ++c)
+        {
+            const float T = Expected.Target[c][i];
+            const float D = Expected.Value[c][i] - T;
+            const float V = Expected.Velocity[c][i];
+            const float K = (V + W * D) * Dt;
+            Expected.Velocity[c][i] = (V - W * K) * E;
+            Expected.Value[c][i] = T + (D + K) * E;
+        }
+    }
+
+    UDirectorRigStabilizer::StepSprings(Lanes, Dt);
+
+    for (int32 i = 0; i < Lanes.NumLanes; ++i)
+    {
+        for (int32 c = 0; c < NumChannels; ++c)
+        {
+            TestEqual(*FString::Printf(TEXT("Lane %d channel %d value"), i, c), Lanes.Value[c][i], Expected.Value[c][i], 1e-3f);
+            TestEqual(*FString::Printf(TEXT("Lane %d channel %d velocity"), i, c), Lanes.Velocity[c][i], Expected.Velocity[c][i], 1e-2f);
+        }
+    }
+    for (int32 c = 0; c < NumChannels; ++c)
+    {
+        TestEqual(TEXT("Parked lane sits on its target"), Lanes.Value[c][2], Lanes.Target[c][2]);
+        TestEqual(TEXT("Parked lane at rest"), Lanes.Velocity[c][2], 0.f);
+    }
+
+    // From rest, critically damped: approaches the target monotonically and gets there
+    FLanes Step;
+    Step.SetNum(1);
+    Step.Target[0][0] = 100.f;
+    Step.Omega[0] = 2.f / 0.12f;
+    Step.Decay[0] = FMath::Exp(-Step.Omega[0] * Dt);
+
+    float Previous = 0.f;
+    bool bMonotonic = true;
+    for (int32 Frame = 0; Frame < 120; ++Frame)
+    {
+        UDirectorRigStabilizer::StepSprings(Step, Dt);
+        bMonotonic &= Step.Value[0][0] >= Previous && Step.Value[0][0] <= 100.f + KINDA_SMALL_NUMBER;
+        Previous = Step.Value[0][0];
+    }
+    TestTrue(TEXT("No overshoot"), bMonotonic);
+    TestEqual(TEXT("Settled on the target after two seconds"), Step.Value[0][0], 100.f, 0.01f);
+
+    return true;
+}
+
+#endif
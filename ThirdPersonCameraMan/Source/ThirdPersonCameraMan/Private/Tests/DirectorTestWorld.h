@@ -0,0 +1,99 @@
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CoreMinimal.h"
+#include "DirectorGameState.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/DefaultPawn.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/WorldSettings.h"
+#include "ThirdPersonCameraManGameMode.h"
+
+// Throwaway game world for automation tests that spawn actors; torn down when it goes out of scope.
+// Without a GameMode tests call the server paths directly; with one (and its GameState) the world runs the
+// same commit paths as a listen server with nobody logged in. bBeginPlay dispatches BeginPlay to the actors
+struct FDirectorTestWorld
+{
+    UWorld* World = nullptr;
+    UGameInstance* GameInstance = nullptr;
+
+    explicit FDirectorTestWorld(bool bBeginPlay = false, TSubclassOf<AGameModeBase> GameMode = nullptr)
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false);
+        FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+        Context.SetCurrentWorld(World);
+
+        FURL URL;
+        if (GameMode)
+        {
+            // The game instance only has to create the GameMode named by the URL
+            GameInstance = NewObject<UGameInstance>(GEngine);
+            GameInstance->AddToRoot();
+            Context.OwningGameInstance = GameInstance;
+            World->SetGameInstance(GameInstance);
+
+            URL.AddOption(*FString::Printf(TEXT("game=%s"), *GameMode->GetPathName()));
+            World->SetGameMode(URL);
+        }
+
+        World->InitializeActorsForPlay(URL);
+        if (bBeginPlay)
+        {
+            if (GameMode)
+            {
+                World->BeginPlay();
+            }
+            else
+            {
+                World->GetWorldSettings()->NotifyBeginPlay();
+            }
+        }
+    }
+
+    ~FDirectorTestWorld()
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        if (GameInstance)
+        {
+            GameInstance->RemoveFromRoot();
+        }
+    }
+
+    // Advances the world (and its tickable subsystems) by whole frames
+    void Tick(int32 Frames = 1, float DeltaSeconds = 1.f / 60.f)
+    {
+        for (int32 i = 0; i < Frames; ++i)
+        {
+            World->Tick(LEVELTICK_All, DeltaSeconds);
+        }
+    }
+
+    // A pawn with a player controller, made the operator the way the first login is. Needs the director GameMode
+    APawn* SpawnOperator(const FVector& Location = FVector::ZeroVector)
+    {
+        AThirdPersonCameraManGameMode* GM = World->GetAuthGameMode<AThirdPersonCameraManGameMode>();
+        ADirectorGameState* GS = World->GetGameState<ADirectorGameState>();
+        APlayerController* PC = World->SpawnActor<APlayerController>();
+        APawn* Pawn = World->SpawnActor<ADefaultPawn>(Location, FRotator::ZeroRotator);
+        if (!GM || !GS || !PC || !Pawn)
+        {
+            return nullptr;
+        }
+
+        PC->Possess(Pawn);
+        GM->OperatorPC = PC;
+        GS->OperatorPlayerState = PC->PlayerState;
+        return Pawn;
+    }
+
+    FDirectorTestWorld(const FDirectorTestWorld&) = delete;
+    FDirectorTestWorld& operator=(const FDirectorTestWorld&) = delete;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#include "ThirdPersonCameraMan.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNearestRankPercentileTest, "ThirdPersonCameraMan.Stats.NearestRankPercentile",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FNearestRankPercentileTest::RunTest(const FString& Parameters)
+{
+    using ThirdPersonCameraMan::NearestRankPercentile;
+
+    TestEqual(TEXT("Empty"), NearestRankPercentile({}, 0.95f), 0.f);
+    TestEqual(TEXT("Single p0"), NearestRankPercentile({ 7.f }, 0.f), 7.f);
+    TestEqual(TEXT("Single p100"), NearestRankPercentile({ 7.f }, 1.f), 7.f);
+
+    // 1..100: nearest rank of P is ceil(P * N), so p50 = 50, p95 = 95, p99 = 99, p100 = 100
+    TArray<float> Hundred;
+    for (int32 i = 1; i <= 100; ++i) Hundred.Add(static_cast<float>(i));
+    TestEqual(TEXT("p50 of 1..100"), NearestRankPercentile(Hundred, 0.50f), 50.f);
+    TestEqual(TEXT("p95 of 1..100"), NearestRankPercentile(Hundred, 0.95f), 95.f);
+    TestEqual(TEXT("p99 of 1..100"), NearestRankPercentile(Hundred, 0.99f), 99.f);
+    TestEqual(TEXT("p100 of 1..100"), NearestRankPercentile(Hundred, 1.f), 100.f);
+
+    // Small sets round up to the next sample rather than interpolating
+    const TArray<float> Five = { 1.f, 2.f, 3.f, 4.f, 5.f };
+    TestEqual(TEXT("p50 of 5"), NearestRankPercentile(Five, 0.50f), 3.f);
+    TestEqual(TEXT("p95 of 5"), NearestRankPercentile(Five, 0.95f), 5.f);
+    TestEqual(TEXT("p0 clamps to the first sample"), NearestRankPercentile(Five, 0.f), 1.f);
+    TestEqual(TEXT("P above 1 clamps to the last sample"), NearestRankPercentile(Five, 1.5f), 5.f);
+
+    return true;
+}
+
+#endif
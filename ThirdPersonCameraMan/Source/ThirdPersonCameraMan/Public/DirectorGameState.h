@@ -13,6 +13,37 @@ class UTextureRenderTarget2D;
 class APlayerState;
 
 class ACameraRig;
+
+// How viewers present a cut on the feed (the view target itself always cuts; see FDirectorFeedCompositor)
+UENUM(BlueprintType)
+enum class EDirectorTransitionStyle : uint8
+{
+    Cut,
+    Crossfade,
+    DipToBlack,
+    Wipe
+};
+
+// Server-side stamps for the latest camera cut, replicated so every viewer can measure the full path
+USTRUCT(BlueprintType)
+struct FDirectorTransitionStamp
+{
+    GENERATED_BODY()
+
+    // Monotonic per server session; 0 = no transition (e.g. a drop)
+    UPROPERTY(BlueprintReadOnly, Category="Cameras") int32 Id = 0;
+
+    // Server world time of the operator overlap that requested the cut
+    UPROPERTY(BlueprintReadOnly, Category="Cameras") double OverlapServerTime = 0.0;
+
+    // Server world time at which ActiveCamera was committed
+    UPROPERTY(BlueprintReadOnly, Category="Cameras") double CommitServerTime = 0.0;
+
+    // Requested feed transition (scripted cuts); plain cut otherwise
+    UPROPERTY(BlueprintReadOnly, Category="Cameras") EDirectorTransitionStyle Style = EDirectorTransitionStyle::Cut;
+    UPROPERTY(BlueprintReadOnly, Category="Cameras") float StyleSeconds = 0.f;
+};
+
 UCLASS()
 class THIRDPERSONCAMERAMAN_API ADirectorGameState : public AGameStateBase
 {
@@ -47,8 +78,37 @@ public:
     DECLARE_MULTICAST_DELEGATE_OneParam(FOnOperatorChanged, APlayerState*);
     FOnOperatorChanged OnOperatorChanged;
 
+    // Stamps of the cut that produced the current ActiveCamera (replicated alongside it)
+    UPROPERTY(Replicated, BlueprintReadOnly, Category="Cameras")
+    FDirectorTransitionStamp LastTransition;
+
+    // Server: stamp an operator overlap that may lead to a cut; returns the new transition ID
+    int32 BeginTransition();
+    // Server: feed transition for the pending cut (reset to a plain cut after each commit)
+    void SetPendingTransitionStyle(EDirectorTransitionStyle Style, float Seconds);
+    // Server: the pending transition has committed ActiveCamera (call after setting it)
+    void CommitTransition();
+    // Server: ActiveCamera was cleared without a cut
+    void ClearTransition();
+    // Server: the pending cut was rejected (switch lock, already live); a later commit must not inherit its overlap time
+    void AbandonTransition();
+
+    // 1-based join-order number of a player ("player N"), 0 if unknown. Kept up to date on join/leave
+    int32 GetPlayerNumber(const APlayerState* PlayerState) const
+    {
+        const int32 Index = PlayersInJoinOrder.IndexOfByKey(PlayerState);
+        return Index == INDEX_NONE ? 0 : Index + 1;
+    }
+
+    virtual void AddPlayerState(APlayerState* PlayerState) override;
+    virtual void RemovePlayerState(APlayerState* PlayerState) override;
+
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+    // Feeds the estimated director replication bytes into `stat Director` (server)
+    virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+    uint64 GetEstimatedRepBytesTotal() const { return EstimatedRepBytesTotal; }
+
 
     // --- Global switch lock to avoid race/ping-pong on quick overlaps ---
 public:
@@ -63,6 +123,21 @@ public:
     void StampSwitch() { LastSwitchStamp = GetWorld() ? GetWorld()->TimeSeconds : LastSwitchStamp; }
 
 protected:
+    // PlayerArray in join order (== PlayerId order); appended/removed incrementally, never re-sorted
+    UPROPERTY(Transient) TArray<APlayerState*> PlayersInJoinOrder;
+
+    // Transition requested by the latest overlap, not committed yet (server)
+    int32 PendingTransitionId = 0;
+    double PendingOverlapServerTime = 0.0;
+    EDirectorTransitionStyle PendingStyle = EDirectorTransitionStyle::Cut;
+    float PendingStyleSeconds = 0.f;
+    int32 NextTransitionId = 1;
+
+    // Last values seen by PreReplication, only compared (never dereferenced)
+    const UObject* LastRepActiveCamera = nullptr;
+    const UObject* LastRepOperator = nullptr;
+    uint64 EstimatedRepBytesTotal = 0;
+
     // Timestamp of last successful attach/switch on the server
     float LastSwitchStamp = -FLT_MAX;
     // Small lockout to prevent rapid double-switching
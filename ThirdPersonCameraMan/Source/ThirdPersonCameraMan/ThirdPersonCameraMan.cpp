@@ -1,8 +1,29 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ThirdPersonCameraMan.h"
+#include "DirectorBenchmark.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ThirdPersonCameraMan, "ThirdPersonCameraMan" );
+class FThirdPersonCameraManModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		// Installed once at module startup and never swapped afterwards
+		DirectorAllocCounter::InstallIfRequested();
+	}
+};
 
-DEFINE_LOG_CATEGORY(LogThirdPersonCameraMan)
\ No newline at end of file
+IMPLEMENT_PRIMARY_GAME_MODULE( FThirdPersonCameraManModule, ThirdPersonCameraMan, "ThirdPersonCameraMan" );
+
+DEFINE_LOG_CATEGORY(LogThirdPersonCameraMan)
+
+float ThirdPersonCameraMan::NearestRankPercentile(const TArray<float>& Sorted, float P)
+{
+	if (Sorted.Num() == 0)
+	{
+		return 0.0f;
+	}
+	const int32 Rank = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+	return Sorted[Rank];
+}
@@ -6,4 +6,10 @@
 
 
 /** Main log category used across the project */
-DECLARE_LOG_CATEGORY_EXTERN(LogThirdPersonCameraMan, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogThirdPersonCameraMan, Log, All);
+
+namespace ThirdPersonCameraMan
+{
+	/** Nearest-rank percentile (P in 0..1) over an already sorted array, 0 when empty. Used by the profiling commands */
+	float NearestRankPercentile(const TArray<float>& Sorted, float P);
+}
\ No newline at end of file
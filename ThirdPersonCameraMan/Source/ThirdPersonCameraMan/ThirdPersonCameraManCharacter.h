@@ -54,40 +54,6 @@ public:
     /** Constructor */
     AThirdPersonCameraManCharacter(); 
 
-public:
-    // When a CameraRig attaches to this character, it can pull these settings
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig Attach")
-    FName AttachCameraRigSocket = TEXT("head");
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig Attach")
-    FVector AttachCameraRigRelativeLocation = FVector(0.f, 0.f, 100.f);
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig Attach")
-    FRotator AttachCameraRigRelativeRotation = FRotator(0.f, 0.f, 0.f);
-
-    // Per-character desired camera offsets on the rig's camera component
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig View")
-    FVector RigCameraRelativeLocation = FVector(30.f, 15.f, 10.f);
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig View")
-    FRotator RigCameraRelativeRotation = FRotator(-10.f, 0.f, 0.f);
-
-    // Alignment behavior for the rig when attached to this character
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig Align")
-    bool bRigAlignWithPawnForwardOnAttach = true;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig Align")
-    bool bRigZeroRollOnAttach = true;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig Align", meta=(ClampMin=-180, ClampMax=180))
-    float RigAlignYawOffsetDeg = 0.f;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig Align", meta=(ClampMin=-89, ClampMax=89))
-    float RigAlignPitchOffsetDeg = 0.f;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="CameraRig Align", meta=(ClampMin=-180, ClampMax=180))
-    float RigAlignRollOffsetDeg = 0.f;
-
 protected:
 
 	/** Initialize input action bindings */
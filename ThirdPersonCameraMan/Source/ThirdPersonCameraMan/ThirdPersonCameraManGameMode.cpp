@@ -4,6 +4,9 @@
 #include "ThirdPersonCameraManCharacter.h"          // your pawn class
 #include "ThirdPersonCameraManPlayerController.h" 
 #include "DirectorGameState.h"
+#include "CameraRig.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
 
 AThirdPersonCameraManGameMode::AThirdPersonCameraManGameMode()
 {
@@ -37,6 +40,26 @@ void AThirdPersonCameraManGameMode::ClearActiveCamera()
     if (auto* GS = Cast<ADirectorGameState>(GameState)) GS->ActiveCamera = nullptr;
 }
 
+void AThirdPersonCameraManGameMode::DropActiveCamera()
+{
+    if (!HasAuthority()) return;
+    ADirectorGameState* GS = GetGameState<ADirectorGameState>();
+    if (!GS) return;
+    ACameraRig* Rig = GS->ActiveCamera;
+    if (!Rig) return;
+
+    Rig->SetCaptureEnabled(false);
+    Rig->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+    SetActiveCamera(nullptr);
+    GS->ClearTransition();
+
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(770779, 2.0f, FColor::Yellow, Rig->GetDroppedToast());
+    }
+}
+
 void AThirdPersonCameraManGameMode::HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer)
 {
     // Let base do its normal init and spawn; we'll clean up viewers after
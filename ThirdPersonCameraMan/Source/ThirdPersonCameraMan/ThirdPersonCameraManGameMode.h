@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "DirectorAutoDirector.h"
 #include "ThirdPersonCameraManGameMode.generated.h"
 
 class ACameraRig;
@@ -22,7 +23,13 @@ public:
 
     UFUNCTION(BlueprintCallable) void SetActiveCamera(ACameraRig* NewActive);
     UFUNCTION(BlueprintCallable) void ClearActiveCamera();
+    // Server: stop capture, detach the active rig and clear ActiveCamera (operator Q, scripted drops)
+    UFUNCTION(BlueprintCallable) void DropActiveCamera();
     UFUNCTION(BlueprintPure) APlayerController* GetOperatorPC() const { return OperatorPC; }
+
+    // Auto-director: cut between rigs by shot score instead of waiting for bumps (toggle at runtime with `director.Auto`)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector") bool bAutoDirector = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="AutoDirector") FDirectorAutoDirectorSettings AutoDirectorSettings;
     
 };
 
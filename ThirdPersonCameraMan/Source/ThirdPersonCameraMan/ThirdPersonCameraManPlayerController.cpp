@@ -18,6 +18,11 @@ DEFINE_LOG_CATEGORY_STATIC(LogDirectorPC, Log, All);
 #include "EngineUtils.h"
 #include "Blueprint/WidgetLayoutLibrary.h"
 #include "GameFramework/PlayerState.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Camera/PlayerCameraManager.h"
+#include "DirectorStats.h"
+#include "DirectorCutList.h"
+#include "DirectorViewerProfile.h"
 
 void AThirdPersonCameraManPlayerController::BeginPlay()
 {
@@ -73,17 +78,52 @@ void AThirdPersonCameraManPlayerController::BeginPlay()
 // Viewer camera: set view target to active rig; return to pawn when cleared
 void AThirdPersonCameraManPlayerController::HandleActiveCameraChanged(ACameraRig* NewCam)
 {
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorViewerCameraChanged);
+
+    const ADirectorGameState* GS = GetWorld() ? GetWorld()->GetGameState<ADirectorGameState>() : nullptr;
+    const EDirectorTransitionStyle Style = GS ? GS->LastTransition.Style : EDirectorTransitionStyle::Cut;
+    const float StyleSeconds = GS ? GS->LastTransition.StyleSeconds : 0.f;
+    const bool bStyledCut = Style != EDirectorTransitionStyle::Cut && StyleSeconds > 0.f;
+    ACameraRig* PreviousCam = FeedCamera.Get();
+    FeedCamera = NewCam;
+
     // If using UI feed, keep it in sync (allow local override)
     UTextureRenderTarget2D* RT = FeedOverrideRT ? FeedOverrideRT : (NewCam ? NewCam->RenderTarget : nullptr);
+
+    // Styled cut: the PiP shows the compositor output until PlayerTick finishes the transition and rebinds the live RT
+    if (!FeedOverrideRT && bStyledCut && PreviousCam && NewCam
+        && FeedCompositor.Begin(this, PreviousCam->RenderTarget, RT, Style, StyleSeconds))
+    {
+        RT = FeedCompositor.GetOutput();
+    }
     CallWidgetSetFeedRT(RT);
 
+    // Program rig changed: its tile now shows the live RT, the previous one goes back to scheduled captures
+    if (bMonitorWallActive)
+    {
+        RefreshMonitorWallBindings();
+    }
+
     // If we're a viewer (non-operator), drive the actual camera view instead of a widget
     if (IsLocalController() && (!bIsOperator || bForceViewFromActiveRig))
     {
         if (NewCam)
         {
             UE_LOG(LogDirectorPC, Log, TEXT("[PC %s] Viewer switching to ActiveCamera=%s"), *GetName(), *NewCam->GetName());
-            SetViewTargetWithBlend(NewCam, 0.25f);
+            if (bStyledCut || ViewerCutBlendSeconds <= 0.f)
+            {
+                SetViewTarget(NewCam);
+            }
+            else
+            {
+                SetViewTargetWithBlend(NewCam, ViewerCutBlendSeconds);
+            }
+
+            // The view itself has already cut; a dip still comes up out of black
+            if (Style == EDirectorTransitionStyle::DipToBlack && bStyledCut && PlayerCameraManager)
+            {
+                PlayerCameraManager->StartCameraFade(1.f, 0.f, StyleSeconds * 0.5f, FLinearColor::Black);
+            }
         }
         else
         {
@@ -101,6 +141,7 @@ void AThirdPersonCameraManPlayerController::RigForceView(bool bEnable)
 {
     if (!IsLocalController()) return;
     bForceViewFromActiveRig = bEnable;
+    EnsureCameraFeedWidget();   // the viewer profile may hide the PiP while following the rig
 
     const ADirectorGameState* GS = GetWorld() ? GetWorld()->GetGameState<ADirectorGameState>() : nullptr;
     if (!GS) return;
@@ -117,6 +158,12 @@ void AThirdPersonCameraManPlayerController::RigForceView(bool bEnable)
 
 void AThirdPersonCameraManPlayerController::CallWidgetSetFeedRT(UTextureRenderTarget2D* RT)
 {
+    // Any other binding (override, toggle, retry) ends a running transition
+    if (RT != FeedCompositor.GetOutput())
+    {
+        FeedCompositor.Stop();
+    }
+
     if (!CameraFeed) return;
     if (!RT)
     {
@@ -130,19 +177,27 @@ void AThirdPersonCameraManPlayerController::CallWidgetSetFeedRT(UTextureRenderTa
         return;
     }
 
-    static const FName FnName(TEXT("SetFeedRT")); // must exist in your BP widget
-    if (UFunction* Fn = CameraFeed->FindFunction(FnName))
-    {
-        struct { UTextureRenderTarget2D* RenderTarget; } Params{ RT };
-        CameraFeed->ProcessEvent(Fn, &Params);
-    }
-    else
+    if (!SetWidgetFeedRT(CameraFeed, RT))
     {
         UE_LOG(LogDirectorPC, Warning, TEXT("[PC %s] CameraFeed widget '%s' missing SetFeedRT(UTextureRenderTarget2D*)"),
             *GetName(), *CameraFeed->GetName());
     }
 }
 
+bool AThirdPersonCameraManPlayerController::SetWidgetFeedRT(UUserWidget* Widget, UTextureRenderTarget2D* RT)
+{
+    if (!Widget) return false;
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorFeedBind);
+    static const FName FnName(TEXT("SetFeedRT")); // must exist in your BP widget
+    if (UFunction* Fn = Widget->FindFunction(FnName))
+    {
+        struct { UTextureRenderTarget2D* RenderTarget; } Params{ RT };
+        Widget->ProcessEvent(Fn, &Params);
+        return true;
+    }
+    return false;
+}
+
 void AThirdPersonCameraManPlayerController::RetryApplyFeedRT()
 {
     const ADirectorGameState* GS = GetWorld() ? GetWorld()->GetGameState<ADirectorGameState>() : nullptr;
@@ -212,7 +267,14 @@ void AThirdPersonCameraManPlayerController::EnsureCameraFeedWidget()
 {
     if (!IsLocalPlayerController()) return;
 
-    const bool bWantsOverlay = bIsOperator ? bOverlayForOperator : bOverlayForViewer;
+    bool bWantsOverlay = bIsOperator ? bOverlayForOperator : bOverlayForViewer;
+
+    // Low-end profiles drop the PiP when the main view already shows the live rig
+    const UDirectorViewerProfileSubsystem* ViewerProfile = UDirectorViewerProfileSubsystem::Get(this);
+    if (ViewerProfile && !ViewerProfile->GetProfile().bPiPWhenFollowingRig && (!bIsOperator || bForceViewFromActiveRig))
+    {
+        bWantsOverlay = false;
+    }
 
     if (!bWantsOverlay)
     {
@@ -326,11 +388,14 @@ void AThirdPersonCameraManPlayerController::RigPrint()
     ADirectorGameState* GS = GetWorld() ? GetWorld()->GetGameState<ADirectorGameState>() : nullptr;
     if (!GS || !GS->ActiveCamera) return;
     const ACameraRig* R = GS->ActiveCamera;
-    const FString Msg = FString::Printf(TEXT("Axis=%d Yaw=%.1f Pitch=%.1f Roll=%.1f ZeroRoll=%d CamRel=(%s)"),
+
+    // Formatted into a reused buffer; same layout as FRotator::ToString for CamRel
+    RigPrintBuffer.Reset();
+    RigPrintBuffer.Appendf(TEXT("Axis=%d Yaw=%.1f Pitch=%.1f Roll=%.1f ZeroRoll=%d CamRel=(P=%f Y=%f R=%f)"),
         (int32)R->AssetForwardAxis, R->AlignYawOffsetDeg, R->AlignPitchOffsetDeg, R->AlignRollOffsetDeg,
         R->bZeroRollOnAttach ? 1 : 0,
-        *R->CameraRelativeRotation.ToString());
-    GEngine->AddOnScreenDebugMessage(770099, 5.f, FColor::Yellow, Msg);
+        R->CameraRelativeRotation.Pitch, R->CameraRelativeRotation.Yaw, R->CameraRelativeRotation.Roll);
+    GEngine->AddOnScreenDebugMessage(770099, 5.f, FColor::Yellow, RigPrintBuffer);
 }
 
 // --- Secondary feed helpers (toggle/cycle from code) ---
@@ -421,46 +486,15 @@ void AThirdPersonCameraManPlayerController::DropActiveCamera()
     Server_DropActiveCamera();
 }
 
-// Server drop: stop capture, detach, clear ActiveCamera; viewer will return to pawn
+// Server drop: operator only; the GameMode stops capture, detaches and clears ActiveCamera
 void AThirdPersonCameraManPlayerController::Server_DropActiveCamera_Implementation()
 {
     if (!HasAuthority()) return;
-    ADirectorGameState* GS = GetWorld() ? GetWorld()->GetGameState<ADirectorGameState>() : nullptr;
-    if (!GS) return;
-    ACameraRig* Rig = GS->ActiveCamera;
-    if (!Rig) return;
 
-    // Only operator PC may drop
     if (AThirdPersonCameraManGameMode* GM = Cast<AThirdPersonCameraManGameMode>(GetWorld()->GetAuthGameMode()))
     {
-        if (GM->GetOperatorPC() != this) return;
-    }
-
-    if (Rig->SceneCapture)
-    {
-        Rig->SceneCapture->bCaptureEveryFrame = false;
-    }
-    Rig->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
-
-    if (AThirdPersonCameraManGameMode* GM2 = Cast<AThirdPersonCameraManGameMode>(GetWorld()->GetAuthGameMode()))
-    {
-        GM2->SetActiveCamera(nullptr);
-    }
-    else
-    {
-        GS->ActiveCamera = nullptr;
-    }
-
-    if (GEngine)
-    {
-        FString RigName;
-#if WITH_EDITOR
-        RigName = Rig->GetActorLabel();
-#else
-        RigName = Rig->GetName();
-#endif
-        const FString Msg = FString::Printf(TEXT("player dropped :  %s"), *RigName);
-        GEngine->AddOnScreenDebugMessage(770779, 2.0f, FColor::Yellow, Msg);
+        if (GM->GetOperatorPC() != this || UDirectorCutListPlayer::IsPlaying(this)) return;
+        GM->DropActiveCamera();
     }
 }
 
@@ -520,17 +554,238 @@ void AThirdPersonCameraManPlayerController::ShowRoleLabel() const
         : (NetMode == NM_Standalone) ? TEXT("Standalone")
         : TEXT("Other");
 
-    const FString MyName = PlayerState ? PlayerState->GetPlayerName() : TEXT("None");
     const ADirectorGameState* GS = World ? World->GetGameState<ADirectorGameState>() : nullptr;
-    const FString OpName = (GS && GS->OperatorPlayerState) ? GS->OperatorPlayerState->GetPlayerName() : TEXT("None");
+    const APlayerState* OperatorPS = GS ? GS->OperatorPlayerState : nullptr;
 
-    const FString Text = FString::Printf(TEXT("[%s] %s | Me=%s | Operator=%s"),
-        NetModeStr,
-        bIsOperator ? TEXT("Operator") : TEXT("Viewer"),
-        *MyName,
-        *OpName);
+    // Only reformat when something shown in the label changed; names are compared too, since a PlayerName can
+    // replicate after the PlayerState it belongs to
+    const FString MyName = PlayerState ? PlayerState->GetPlayerName() : TEXT("None");
+    const FString OpName = OperatorPS ? OperatorPS->GetPlayerName() : TEXT("None");
+    const bool bChanged = RoleLabelText.IsEmpty() || bRoleLabelIsOperator != bIsOperator || RoleLabelNetMode != NetMode
+        || RoleLabelMe != PlayerState.Get() || RoleLabelOperator != OperatorPS
+        || RoleLabelMeName != MyName || RoleLabelOperatorName != OpName;
+    if (bChanged)
+    {
+        bRoleLabelIsOperator = bIsOperator;
+        RoleLabelNetMode = NetMode;
+        RoleLabelMe = PlayerState.Get();
+        RoleLabelOperator = OperatorPS;
+        RoleLabelMeName = MyName;
+        RoleLabelOperatorName = OpName;
+
+        RoleLabelText = FString::Printf(TEXT("[%s] %s | Me=%s | Operator=%s"),
+            NetModeStr,
+            bIsOperator ? TEXT("Operator") : TEXT("Viewer"),
+            *MyName,
+            *OpName);
+    }
 
-    // Long duration so it stays visible during testing; reuses same key to update
-    GEngine->AddOnScreenDebugMessage(RoleMessageKey, 10000.f, Color, Text);
+    // Long duration so it stays visible during testing; reuses same key to update.
+    // The engine copies the text into its message list, so an unchanged label that is still up isn't re-sent
+    if (bChanged || !GEngine->OnScreenDebugMessageExists(RoleMessageKey))
+    {
+        GEngine->AddOnScreenDebugMessage(RoleMessageKey, 10000.f, Color, RoleLabelText);
+    }
 }
 
+
+// --- Monitor wall (viewer-side grid of every rig feed) ---
+void AThirdPersonCameraManPlayerController::MonitorWall(bool bEnable)
+{
+    if (!IsLocalPlayerController()) return;
+    if (bEnable)
+    {
+        BuildMonitorWall();
+    }
+    else
+    {
+        TearDownMonitorWall();
+    }
+}
+
+void AThirdPersonCameraManPlayerController::MonitorWallFocus(int32 Index)
+{
+    if (!IsLocalPlayerController()) return;
+    MonitorFocusIndex = MonitorTiles.IsValidIndex(Index) ? Index : INDEX_NONE;
+    RefreshMonitorWallBindings();
+}
+
+void AThirdPersonCameraManPlayerController::PlayerTick(float DeltaTime)
+{
+    Super::PlayerTick(DeltaTime);
+
+    if (FeedCompositor.IsActive() && !FeedCompositor.Tick(this, DeltaTime))
+    {
+        const ADirectorGameState* GS = GetWorld()->GetGameState<ADirectorGameState>();
+        CallWidgetSetFeedRT(FeedOverrideRT ? FeedOverrideRT : (GS ? GS->GetActiveCameraRenderTarget() : nullptr));
+    }
+
+    if (bMonitorWallActive)
+    {
+        TickMonitorWall(DeltaTime);
+    }
+
+    // Pick up late-replicated player names on a label that is already showing
+    RoleLabelRefreshTimer -= DeltaTime;
+    if (RoleLabelRefreshTimer <= 0.f)
+    {
+        RoleLabelRefreshTimer = RoleLabelRefreshSeconds;
+        if (!RoleLabelText.IsEmpty() && GEngine && GEngine->OnScreenDebugMessageExists(RoleMessageKey))
+        {
+            ShowRoleLabel();
+        }
+    }
+}
+
+void AThirdPersonCameraManPlayerController::BuildMonitorWall()
+{
+    TearDownMonitorWall();
+
+    UWorld* World = GetWorld();
+    const TSubclassOf<UUserWidget> TileClass = MonitorTileClass ? MonitorTileClass : CameraFeedClass;
+    if (!World || !TileClass)
+    {
+        UE_LOG(LogDirectorPC, Warning, TEXT("[PC %s] MonitorWall needs MonitorTileClass or CameraFeedClass"), *GetName());
+        return;
+    }
+
+    for (TActorIterator<ACameraRig> It(World); It && MonitorTiles.Num() < MonitorWallMaxTiles; ++It)
+    {
+        FMonitorWallTile& Tile = MonitorTiles.AddDefaulted_GetRef();
+        Tile.Rig = *It;
+        Tile.Widget = CreateWidget<UUserWidget>(this, TileClass);
+        if (Tile.Widget)
+        {
+            Tile.Widget->AddToViewport(MonitorWallZOrder);
+            Tile.Widget->SetVisibility(ESlateVisibility::HitTestInvisible);
+        }
+    }
+
+    // Stagger phases so tiles sharing a rate don't all capture on the same frame
+    for (int32 i = 0; i < MonitorTiles.Num(); ++i)
+    {
+        MonitorTiles[i].Accumulator = static_cast<float>(i) / MonitorTiles.Num();
+    }
+
+    bMonitorWallActive = MonitorTiles.Num() > 0;
+    LayoutMonitorWall();
+
+    UE_LOG(LogDirectorPC, Log, TEXT("[PC %s] MonitorWall ON Tiles=%d Budget=%.1f Mpix/s"),
+        *GetName(), MonitorTiles.Num(), MonitorWallPixelBudget / 1.0e6f);
+}
+
+void AThirdPersonCameraManPlayerController::TearDownMonitorWall()
+{
+    for (FMonitorWallTile& Tile : MonitorTiles)
+    {
+        if (Tile.Widget)
+        {
+            Tile.Widget->RemoveFromParent();
+        }
+        MonitorRTPool.Release(Tile.RenderTarget);
+    }
+    MonitorTiles.Reset();
+    bMonitorWallActive = false;
+}
+
+void AThirdPersonCameraManPlayerController::LayoutMonitorWall()
+{
+    if (MonitorTiles.Num() == 0) return;
+
+    // Lay out in slate units, size each RT in real pixels so it matches what the tile displays
+    const FVector2D ViewPixels = UWidgetLayoutLibrary::GetViewportSize(this);
+    const float Scale = FMath::Max(UWidgetLayoutLibrary::GetViewportScale(this), KINDA_SMALL_NUMBER);
+    MonitorWallViewSize = ViewPixels;
+
+    const FIntPoint Grid = DirectorMonitorWall::ComputeGrid(MonitorTiles.Num());
+    const FVector2D Avail = ViewPixels / Scale - 2.f * MonitorWallMargin;
+    const FVector2D TileSize(
+        FMath::Max(1.f, (Avail.X - MonitorWallTileSpacing * (Grid.X - 1)) / Grid.X),
+        FMath::Max(1.f, (Avail.Y - MonitorWallTileSpacing * (Grid.Y - 1)) / Grid.Y));
+
+    const int32 RTWidth  = DirectorMonitorWall::QuantizeRTSize(TileSize.X * Scale);
+    const int32 RTHeight = DirectorMonitorWall::QuantizeRTSize(TileSize.Y * Scale);
+
+    for (int32 i = 0; i < MonitorTiles.Num(); ++i)
+    {
+        FMonitorWallTile& Tile = MonitorTiles[i];
+        const FVector2D Pos(
+            MonitorWallMargin.X + (i % Grid.X) * (TileSize.X + MonitorWallTileSpacing),
+            MonitorWallMargin.Y + (i / Grid.X) * (TileSize.Y + MonitorWallTileSpacing));
+
+        if (Tile.Widget)
+        {
+            Tile.Widget->SetAlignmentInViewport(FVector2D(0.f, 0.f));
+            Tile.Widget->SetDesiredSizeInViewport(TileSize);
+            Tile.Widget->SetPositionInViewport(Pos, false);
+        }
+
+        if (!Tile.RenderTarget || Tile.RenderTarget->SizeX != RTWidth || Tile.RenderTarget->SizeY != RTHeight)
+        {
+            MonitorRTPool.Release(Tile.RenderTarget);
+            Tile.RenderTarget = MonitorRTPool.Acquire(this, RTWidth, RTHeight);
+        }
+    }
+
+    RefreshMonitorWallBindings();
+}
+
+void AThirdPersonCameraManPlayerController::RefreshMonitorWallBindings()
+{
+    if (!bMonitorWallActive) return;
+
+    const ADirectorGameState* GS = GetWorld() ? GetWorld()->GetGameState<ADirectorGameState>() : nullptr;
+    const ACameraRig* Active = GS ? GS->ActiveCamera : nullptr;
+
+    int32 FocusIndex = MonitorFocusIndex;
+    for (int32 i = 0; i < MonitorTiles.Num(); ++i)
+    {
+        FMonitorWallTile& Tile = MonitorTiles[i];
+        ACameraRig* Rig = Tile.Rig.Get();
+
+        // The program rig already captures every frame into its own RT; show that instead of paying twice
+        Tile.bShowsLiveFeed = Rig && Rig == Active && Rig->RenderTarget;
+        SetWidgetFeedRT(Tile.Widget, Tile.bShowsLiveFeed ? Rig->RenderTarget : Tile.RenderTarget);
+
+        if (MonitorFocusIndex == INDEX_NONE && Rig && Rig == Active)
+        {
+            FocusIndex = i;
+        }
+    }
+
+    DirectorMonitorWall::ScheduleRates(MonitorTiles, FocusIndex, MonitorWallPixelBudget, MonitorWallFocusedHz, MonitorWallMaxTileHz);
+}
+
+void AThirdPersonCameraManPlayerController::TickMonitorWall(float DeltaTime)
+{
+    DIRECTOR_SCOPE_CYCLE_COUNTER(STAT_DirectorMonitorWall);
+
+    // Viewport resized: re-layout (and resize RTs) before capturing into stale sizes
+    if (!UWidgetLayoutLibrary::GetViewportSize(this).Equals(MonitorWallViewSize, 1.f))
+    {
+        LayoutMonitorWall();
+    }
+
+    for (const FMonitorWallTile& Tile : MonitorTiles)
+    {
+        if (!Tile.Rig.IsValid())
+        {
+            // A rig went away; rebuild with what is left
+            BuildMonitorWall();
+            return;
+        }
+    }
+
+    for (FMonitorWallTile& Tile : MonitorTiles)
+    {
+        if (Tile.bShowsLiveFeed || Tile.RateHz <= 0.f || !Tile.RenderTarget) continue;
+
+        Tile.Accumulator += Tile.RateHz * DeltaTime;
+        if (Tile.Accumulator >= 1.f)
+        {
+            // At most one capture per tile per frame; drop the backlog after a hitch
+            Tile.Accumulator = FMath::Fmod(Tile.Accumulator, 1.f);
+            Tile.Rig->CaptureInto(Tile.RenderTarget);
+        }
+    }
+}
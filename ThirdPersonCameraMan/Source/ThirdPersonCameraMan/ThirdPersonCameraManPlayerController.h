@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "DirectorMonitorWall.h"
+#include "DirectorFeedCompositor.h"
 #include "ThirdPersonCameraManPlayerController.generated.h"
 
 class UInputMappingContext;
@@ -78,6 +80,22 @@ protected:
     void ShowRoleLabel() const;
     static constexpr int32 RoleMessageKey = 770031; // stable key to update message
 
+    // Last role label and the inputs it was formatted from (rebuilt only when one changes)
+    mutable FString RoleLabelText;
+    mutable bool bRoleLabelIsOperator = false;
+    mutable ENetMode RoleLabelNetMode = NM_Standalone;
+    mutable TWeakObjectPtr<const APlayerState> RoleLabelMe;
+    mutable TWeakObjectPtr<const APlayerState> RoleLabelOperator;
+    mutable FString RoleLabelMeName;
+    mutable FString RoleLabelOperatorName;
+
+    // While the label is up it is re-checked this often, so player names that replicate after it was shown appear
+    static constexpr float RoleLabelRefreshSeconds = 1.f;
+    float RoleLabelRefreshTimer = 0.f;
+
+    // Reused by RigPrint so repeated calibration prints don't reallocate
+    FString RigPrintBuffer;
+
     bool bIsOperator = false;
     bool bRoleResolved = false; // true once GameState knows OperatorPlayerState
 
@@ -92,6 +110,40 @@ protected:
     void EnsureCameraFeedWidget();
     void UpdateFeedOverlayLayout();
 
+    // Calls the BP widget's SetFeedRT(UTextureRenderTarget2D*) on any feed widget (PiP or wall tile)
+    static bool SetWidgetFeedRT(UUserWidget* Widget, UTextureRenderTarget2D* RT);
+
+    // --- Feed transitions: styled cuts (GS LastTransition) composite the PiP from the old rig's last frame to the new feed ---
+    UPROPERTY(Transient) FDirectorFeedCompositor FeedCompositor;
+    TWeakObjectPtr<ACameraRig> FeedCamera;   // rig the PiP last followed
+    // Viewer pose blend on plain cuts (0 = hard cut); styled transitions always cut the view target so it never flies through geometry
+    UPROPERTY(EditAnywhere, Category="CameraFeed|Transitions", meta=(ClampMin=0)) float ViewerCutBlendSeconds = 0.25f;
+
+    // --- Monitor wall: every rig feed tiled in a grid, captures scheduled under a pixel budget ---
+    // Tile widget class (needs SetFeedRT); falls back to CameraFeedClass when unset
+    UPROPERTY(EditAnywhere, Category="CameraFeed|MonitorWall") TSubclassOf<UUserWidget> MonitorTileClass;
+    UPROPERTY(EditAnywhere, Category="CameraFeed|MonitorWall", meta=(ClampMin=1, ClampMax=25)) int32 MonitorWallMaxTiles = 9;
+    UPROPERTY(EditAnywhere, Category="CameraFeed|MonitorWall") int32 MonitorWallZOrder = 40;
+    UPROPERTY(EditAnywhere, Category="CameraFeed|MonitorWall") FVector2D MonitorWallMargin = FVector2D(16.f, 16.f);
+    UPROPERTY(EditAnywhere, Category="CameraFeed|MonitorWall") float MonitorWallTileSpacing = 4.f;
+    // Total capture cost allowed for all tiles, in pixels per second (default: one 720p feed at 60 Hz)
+    UPROPERTY(EditAnywhere, Category="CameraFeed|MonitorWall", meta=(ClampMin=0)) float MonitorWallPixelBudget = 1280.f * 720.f * 60.f;
+    // Rate the focused tile is promoted to, and the cap for every other tile
+    UPROPERTY(EditAnywhere, Category="CameraFeed|MonitorWall", meta=(ClampMin=1, ClampMax=120)) float MonitorWallFocusedHz = 30.f;
+    UPROPERTY(EditAnywhere, Category="CameraFeed|MonitorWall", meta=(ClampMin=1, ClampMax=120)) float MonitorWallMaxTileHz = 10.f;
+
+    UPROPERTY(Transient) TArray<FMonitorWallTile> MonitorTiles;
+    UPROPERTY(Transient) FDirectorRenderTargetPool MonitorRTPool;
+    int32 MonitorFocusIndex = INDEX_NONE;   // INDEX_NONE = follow the active camera
+    FVector2D MonitorWallViewSize = FVector2D::ZeroVector;
+    bool bMonitorWallActive = false;
+
+    void BuildMonitorWall();
+    void TearDownMonitorWall();
+    void LayoutMonitorWall();
+    void RefreshMonitorWallBindings();
+    void TickMonitorWall(float DeltaTime);
+
 public:
     // Force using the active rig as the view target (useful for Simulate/PIE testing)
     UPROPERTY(EditAnywhere, Category="CameraFeed|Debug") bool bForceViewFromActiveRig = false;
@@ -104,6 +156,12 @@ public:
     UFUNCTION(Exec) void FeedToggle();
     void FeedSetRigOther();
 
+    // Monitor wall: tile all rigs (viewer-side); focus promotes one tile to a higher capture rate (-1 = follow active)
+    UFUNCTION(Exec) void MonitorWall(bool bEnable = true);
+    UFUNCTION(Exec) void MonitorWallFocus(int32 Index = -1);
+
+    virtual void PlayerTick(float DeltaTime) override;
+
     // Drop current active camera (server authoritative). Bound to Q.
     UFUNCTION(BlueprintCallable, Category="Camera") void DropActiveCamera();
     UFUNCTION(Server, Reliable) void Server_DropActiveCamera();
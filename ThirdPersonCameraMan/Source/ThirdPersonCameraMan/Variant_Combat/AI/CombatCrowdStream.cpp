@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatCrowdStream.h"
+#include "CombatCrowdSubsystem.h"
+#include "Net/UnrealNetwork.h"
+
+ACombatCrowdStream::ACombatCrowdStream()
+{
+	// every client draws the whole crowd
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+}
+
+void ACombatCrowdStream::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ACombatCrowdStream, EnemyClasses);
+	DOREPLIFETIME(ACombatCrowdStream, Entities);
+}
+
+void ACombatCrowdStream::OnRep_Entities()
+{
+	if (UCombatCrowdSubsystem* Crowd = UCombatCrowdSubsystem::Get(this))
+	{
+		Crowd->ReceiveStreamedEntities(EnemyClasses, Entities);
+	}
+}
@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Engine/NetSerialization.h"
+#include "CombatCrowdStream.generated.h"
+
+class ACombatEnemy;
+
+/** One crowd entity as clients see it */
+USTRUCT()
+struct FCombatCrowdNetEntity
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	/** Ground velocity, so clients can carry the entity forward between snapshots */
+	UPROPERTY()
+	FVector_NetQuantize Velocity = FVector::ZeroVector;
+
+	/** Compressed yaw, see FRotator::CompressAxisToShort */
+	UPROPERTY()
+	uint16 Yaw = 0;
+
+	/** Index into the stream's EnemyClasses */
+	UPROPERTY()
+	uint8 ClassIndex = 0;
+};
+
+/**
+ *  Always relevant actor spawned by the crowd on listen and dedicated servers.
+ *  Replicates a snapshot of the crowd entities, StreamRate times a second and at most MaxStreamedEntities of them,
+ *  nearest to a player first. Clients draw the entities from it with their own instanced proxies and move them
+ *  along their velocity between snapshots; promotion, demotion and everything else stays on the server.
+ */
+UCLASS(NotPlaceable, Transient)
+class ACombatCrowdStream : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Constructor */
+	ACombatCrowdStream();
+
+	/** Enemy classes referenced by the entities */
+	UPROPERTY(Replicated)
+	TArray<TSubclassOf<ACombatEnemy>> EnemyClasses;
+
+	/** Latest snapshot */
+	UPROPERTY(ReplicatedUsing=OnRep_Entities)
+	TArray<FCombatCrowdNetEntity> Entities;
+
+	/** Registers the replicated properties */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+
+	/** Hands a new snapshot to the client's crowd */
+	UFUNCTION()
+	void OnRep_Entities();
+};
@@ -0,0 +1,785 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatCrowdSubsystem.h"
+#include "CombatCrowdStream.h"
+#include "CombatEnemy.h"
+#include "CombatActorPool.h"
+#include "CameraRig.h"
+#include "DirectorGameState.h"
+#include "Algo/Sort.h"
+#include "Camera/CameraComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Async/ParallelFor.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatCrowd, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Combat crowd tick"), STAT_CombatCrowd, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat crowd entities"), STAT_CombatCrowdEntities, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatCrowdCommand(
+	TEXT("combat.Crowd"),
+	TEXT("Print crowd figures. Args: [spawn=N] (DefaultEnemyClass around the first player) | clear"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatCrowdSubsystem* Crowd = UCombatCrowdSubsystem::Get(World);
+		if (!Crowd)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("clear"))
+		{
+			Crowd->Clear();
+		}
+
+		int32 SpawnCount = 0;
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("spawn="), SpawnCount);
+		}
+
+		if (SpawnCount > 0)
+		{
+			const APlayerController* PC = World->GetFirstPlayerController();
+			const APawn* Centre = PC ? PC->GetPawn() : nullptr;
+			const TSubclassOf<ACombatEnemy> EnemyClass = GetDefault<UCombatCrowdSettings>()->DefaultEnemyClass.LoadSynchronous();
+			if (!Centre || !EnemyClass)
+			{
+				UE_LOG(LogCombatCrowd, Error, TEXT("combat.Crowd spawn needs a player pawn and a DefaultEnemyClass"));
+				return;
+			}
+
+			// scatter them on a ring outside the promote radius so they walk in
+			const float PromoteRadius = GetDefault<UCombatCrowdSettings>()->PromoteRadius;
+			FRandomStream Random(SpawnCount);
+			for (int32 Index = 0; Index < SpawnCount; ++Index)
+			{
+				const float Angle = Random.FRandRange(0.0f, UE_TWO_PI);
+				const float Distance = Random.FRandRange(PromoteRadius * 1.5f, PromoteRadius * 3.0f);
+				const FVector Location = Centre->GetActorLocation() + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Distance;
+				Crowd->AddEnemy(EnemyClass, FTransform(FRotator(0.0f, FMath::RadiansToDegrees(Angle) + 180.0f, 0.0f), Location));
+			}
+		}
+
+		Crowd->PrintStats();
+	}));
+
+namespace CombatCrowd
+{
+	/** Entities per ParallelFor task */
+	constexpr int32 BatchSize = 256;
+
+	/** Entities stop this many separation radii short of the player they seek, leaving the rest to the promoted actor */
+	constexpr float StopDistanceScale = 2.0f;
+
+	/** Per-instance custom data: walk cycle phase (0-1) and speed relative to MaxSpeed */
+	constexpr int32 NumCustomDataFloats = 2;
+
+	/** A promoted actor drawn within this many seconds counts as seen */
+	constexpr float RecentlyRenderedTolerance = 0.2f;
+
+	/** Most entities a snapshot can hold; the replicated array may not exceed net.MaxRepArrayMemory (64 KB by default) */
+	constexpr int32 MaxStreamedEntitiesLimit = static_cast<int32>(65535 / sizeof(FCombatCrowdNetEntity));
+	static_assert(MaxStreamedEntitiesLimit >= 1024, "MaxStreamedEntities is clamped to 1024 in the settings; keep FCombatCrowdNetEntity small enough");
+
+	FIntPoint CellOf(const FVector& Location, float CellSize)
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+	}
+
+	float MinDistSquared(const FVector& Location, TConstArrayView<FVector> Points)
+	{
+		float Best = UE_BIG_NUMBER;
+		for (const FVector& Point : Points)
+		{
+			Best = FMath::Min(Best, static_cast<float>(FVector::DistSquared(Location, Point)));
+		}
+		return Best;
+	}
+
+	/** Advances the walk cycle phase by the distance covered */
+	float StepAnimPhase(float Phase, float Speed, float DeltaTime, float StrideLength)
+	{
+		return FMath::Fmod(Phase + Speed * DeltaTime / StrideLength, 1.0f);
+	}
+}
+
+UCombatCrowdSubsystem* UCombatCrowdSubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UCombatCrowdSubsystem>() : nullptr;
+}
+
+TStatId UCombatCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatCrowdSubsystem, STATGROUP_Tickables);
+}
+
+int32 UCombatCrowdSubsystem::FindOrAddClass(TSubclassOf<ACombatEnemy> EnemyClass)
+{
+	const int32 Existing = Classes.IndexOfByPredicate([EnemyClass](const FCrowdClass& Class) { return Class.EnemyClass == EnemyClass; });
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+
+	FCrowdClass& Class = Classes.AddDefaulted_GetRef();
+	Class.EnemyClass = EnemyClass;
+	return Classes.Num() - 1;
+}
+
+void UCombatCrowdSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// only a server with clients has anyone to stream to
+	if (InWorld.GetNetMode() == NM_DedicatedServer || InWorld.GetNetMode() == NM_ListenServer)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		Stream = InWorld.SpawnActor<ACombatCrowdStream>(SpawnParams);
+		if (ACombatCrowdStream* NewStream = Stream.Get())
+		{
+			NewStream->SetNetUpdateFrequency(GetDefault<UCombatCrowdSettings>()->StreamRate);
+		}
+	}
+}
+
+void UCombatCrowdSubsystem::AddEnemy(TSubclassOf<ACombatEnemy> EnemyClass, const FTransform& Transform, FOnCrowdEnemyPromoted OnPromoted, FSimpleDelegate OnCleared)
+{
+	if (!EnemyClass)
+	{
+		return;
+	}
+
+	Positions.Add(Transform.GetLocation());
+	Velocities.Add(FVector::ZeroVector);
+	Yaws.Add(Transform.Rotator().Yaw);
+	HPs.Add(EnemyClass->GetDefaultObject<ACombatEnemy>()->GetMaxHP());
+	AnimPhases.Add(0.0f);
+	ClassIndices.Add(FindOrAddClass(EnemyClass));
+	OnPromotedDelegates.Add(MoveTemp(OnPromoted));
+	OnClearedDelegates.Add(MoveTemp(OnCleared));
+}
+
+void UCombatCrowdSubsystem::RemoveEntityAtSwap(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Yaws.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	HPs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	AnimPhases.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ClassIndices.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	OnPromotedDelegates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	OnClearedDelegates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UCombatCrowdSubsystem::Clear()
+{
+	// tell the owners once the crowd is empty, in case they add to it again
+	TArray<FSimpleDelegate> Cleared = MoveTemp(OnClearedDelegates);
+	OnClearedDelegates.Reset();
+
+	Positions.Reset();
+	Velocities.Reset();
+	Yaws.Reset();
+	HPs.Reset();
+	AnimPhases.Reset();
+	ClassIndices.Reset();
+	OnPromotedDelegates.Reset();
+	Promoted.Reset();
+	UpdateInstances();
+
+	for (const FSimpleDelegate& OnCleared : Cleared)
+	{
+		OnCleared.ExecuteIfBound();
+	}
+}
+
+void UCombatCrowdSubsystem::ReceiveStreamedEntities(TConstArrayView<TSubclassOf<ACombatEnemy>> EnemyClasses, TConstArrayView<FCombatCrowdNetEntity> Entities)
+{
+	// the stream's class indices to ours
+	TArray<int32, TInlineAllocator<8>> ClassMap;
+	for (const TSubclassOf<ACombatEnemy>& EnemyClass : EnemyClasses)
+	{
+		ClassMap.Add(EnemyClass ? FindOrAddClass(EnemyClass) : INDEX_NONE);
+	}
+
+	// walk phases stay with their slot, not their entity: snapshots are sorted nearest first, so indices reshuffle
+	// every snapshot and an entity may pick up another's phase. It only offsets the walk cycle of a distant proxy
+	const int32 NumEntities = Entities.Num();
+	Positions.SetNumUninitialized(NumEntities, EAllowShrinking::No);
+	Velocities.SetNumUninitialized(NumEntities, EAllowShrinking::No);
+	Yaws.SetNumUninitialized(NumEntities, EAllowShrinking::No);
+	HPs.SetNumZeroed(NumEntities, EAllowShrinking::No);
+	AnimPhases.SetNumZeroed(NumEntities, EAllowShrinking::No);
+	ClassIndices.SetNumUninitialized(NumEntities, EAllowShrinking::No);
+	OnPromotedDelegates.SetNum(NumEntities, EAllowShrinking::No);
+	OnClearedDelegates.SetNum(NumEntities, EAllowShrinking::No);
+
+	int32 Count = 0;
+	for (const FCombatCrowdNetEntity& Entity : Entities)
+	{
+		// a class that didn't resolve on this client can't be drawn
+		if (!ClassMap.IsValidIndex(Entity.ClassIndex) || ClassMap[Entity.ClassIndex] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		Positions[Count] = Entity.Location;
+		Velocities[Count] = Entity.Velocity;
+		Yaws[Count] = FRotator::DecompressAxisFromShort(Entity.Yaw);
+		ClassIndices[Count] = ClassMap[Entity.ClassIndex];
+		++Count;
+	}
+
+	Positions.SetNum(Count, EAllowShrinking::No);
+	Velocities.SetNum(Count, EAllowShrinking::No);
+	Yaws.SetNum(Count, EAllowShrinking::No);
+	HPs.SetNum(Count, EAllowShrinking::No);
+	AnimPhases.SetNum(Count, EAllowShrinking::No);
+	ClassIndices.SetNum(Count, EAllowShrinking::No);
+	OnPromotedDelegates.SetNum(Count, EAllowShrinking::No);
+	OnClearedDelegates.SetNum(Count, EAllowShrinking::No);
+
+	UpdateInstances();
+}
+
+void UCombatCrowdSubsystem::GatherInterest(TArray<FVector>& OutPlayers, TArray<FInterest>& OutInterest) const
+{
+	UWorld* World = GetWorld();
+	const float Margin = GetDefault<UCombatCrowdSettings>()->ViewConeMargin;
+
+	auto AddInterest = [&OutInterest, Margin](const FVector& Location, const FVector& ViewLocation, const FRotator& ViewRotation, float FOV)
+	{
+		FInterest& Point = OutInterest.AddDefaulted_GetRef();
+		Point.Location = Location;
+		Point.ViewLocation = ViewLocation;
+		Point.ViewDirection = ViewRotation.Vector();
+		Point.CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Min(FOV * 0.5f + Margin, 180.0f)));
+	};
+
+	// every player's pawn, seen through that player's view; on a server that includes the remote players
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (const APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+		{
+			OutPlayers.Add(Pawn->GetActorLocation());
+
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			AddInterest(Pawn->GetActorLocation(), ViewLocation, ViewRotation, PC->PlayerCameraManager ? PC->PlayerCameraManager->GetFOVAngle() : 90.0f);
+		}
+	}
+
+	// whatever the live camera films should be full actors too
+	if (const ADirectorGameState* GS = World->GetGameState<ADirectorGameState>())
+	{
+		if (GS->ActiveCamera && GS->ActiveCamera->CameraComponent)
+		{
+			const UCameraComponent* Camera = GS->ActiveCamera->CameraComponent;
+			AddInterest(Camera->GetComponentLocation(), Camera->GetComponentLocation(), Camera->GetComponentRotation(), Camera->FieldOfView);
+		}
+	}
+}
+
+float UCombatCrowdSubsystem::InterestDistance(const FVector& Location, TConstArrayView<FInterest> Interest, bool bSeen) const
+{
+	const float OffCameraScale = GetDefault<UCombatCrowdSettings>()->OffCameraDistanceScale;
+
+	float Best = UE_BIG_NUMBER;
+	for (const FInterest& Point : Interest)
+	{
+		const bool bInView = bSeen || FVector::DotProduct((Location - Point.ViewLocation).GetSafeNormal(), Point.ViewDirection) >= Point.CosHalfAngle;
+		Best = FMath::Min(Best, static_cast<float>(FVector::Dist(Location, Point.Location)) * (bInView ? 1.0f : OffCameraScale));
+	}
+	return Best;
+}
+
+void UCombatCrowdSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatCrowd);
+	SET_DWORD_STAT(STAT_CombatCrowdEntities, Num());
+
+	// clients draw what the server streams
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		if (Num() > 0)
+		{
+			Extrapolate(DeltaTime);
+			UpdateInstances();
+		}
+		return;
+	}
+
+	// nothing to step, and clients already have the empty snapshot
+	const ACombatCrowdStream* CurrentStream = Stream.Get();
+	if (Num() == 0 && Promoted.Num() == 0 && (!CurrentStream || CurrentStream->Entities.Num() == 0))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FVector> Players;
+	TArray<FInterest> Interest;
+	GatherInterest(Players, Interest);
+
+	Simulate(DeltaTime, Players);
+	LastSimulateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	SnapToGround();
+	Demote(Interest);
+	Promote(Interest);
+	StreamEntities(Players);
+	UpdateInstances();
+
+	LastTickMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+void UCombatCrowdSubsystem::Simulate(float DeltaTime, TConstArrayView<FVector> Players)
+{
+	const int32 NumEntities = Num();
+	if (NumEntities == 0 || DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	const UCombatCrowdSettings* Settings = GetDefault<UCombatCrowdSettings>();
+	const float SeparationRadius = FMath::Max(Settings->SeparationRadius, 1.0f);
+	const float SeekRadiusSquared = FMath::Square(Settings->SeekRadius);
+	const float StopDistanceSquared = FMath::Square(SeparationRadius * CombatCrowd::StopDistanceScale);
+
+	// rebuild the spatial hash, keeping the cell arrays around unless the crowd has wandered over far more cells than it fills
+	if (Cells.Num() > NumEntities * 4 + 64)
+	{
+		Cells.Reset();
+	}
+	for (TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+	{
+		Cell.Value.Reset();
+	}
+	for (int32 Index = 0; Index < NumEntities; ++Index)
+	{
+		Cells.FindOrAdd(CombatCrowd::CellOf(Positions[Index], SeparationRadius)).Add(Index);
+	}
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumEntities, CombatCrowd::BatchSize);
+	const EParallelForFlags Flags = NumBatches < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+	// steering reads every position, so velocities are written to a scratch array first
+	TArray<FVector> NewVelocities;
+	NewVelocities.SetNumUninitialized(NumEntities);
+
+	ParallelFor(NumBatches, [&](int32 Batch)
+	{
+		const int32 Begin = Batch * CombatCrowd::BatchSize;
+		const int32 End = FMath::Min(Begin + CombatCrowd::BatchSize, NumEntities);
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FVector& Location = Positions[Index];
+
+			// seek the nearest player in range
+			FVector Desired = FVector::ZeroVector;
+			float BestDistSquared = SeekRadiusSquared;
+			for (const FVector& Player : Players)
+			{
+				const float DistSquared = static_cast<float>(FVector::DistSquared2D(Location, Player));
+				if (DistSquared < BestDistSquared)
+				{
+					BestDistSquared = DistSquared;
+					Desired = DistSquared > StopDistanceSquared ? (Player - Location).GetSafeNormal2D() * Settings->MaxSpeed : FVector::ZeroVector;
+				}
+			}
+
+			// push away from neighbours in the surrounding cells
+			const FIntPoint Cell = CombatCrowd::CellOf(Location, SeparationRadius);
+			for (int32 Y = -1; Y <= 1; ++Y)
+			{
+				for (int32 X = -1; X <= 1; ++X)
+				{
+					const TArray<int32>* Neighbours = Cells.Find(Cell + FIntPoint(X, Y));
+					if (!Neighbours)
+					{
+						continue;
+					}
+
+					for (const int32 Other : *Neighbours)
+					{
+						const FVector Away = (Location - Positions[Other]) * FVector(1.0f, 1.0f, 0.0f);
+						const float Dist = static_cast<float>(Away.Size());
+						if (Other != Index && Dist < SeparationRadius)
+						{
+							const FVector Direction = Dist > UE_KINDA_SMALL_NUMBER ? Away / Dist : FVector(FMath::Cos(static_cast<float>(Index)), FMath::Sin(static_cast<float>(Index)), 0.0f);
+							Desired += Direction * (1.0f - Dist / SeparationRadius) * Settings->MaxSpeed;
+						}
+					}
+				}
+			}
+
+			NewVelocities[Index] = FMath::VInterpConstantTo(Velocities[Index], Desired.GetClampedToMaxSize2D(Settings->MaxSpeed), DeltaTime, Settings->Acceleration);
+		}
+	}, Flags);
+
+	// integrate
+	ParallelFor(NumBatches, [&](int32 Batch)
+	{
+		const int32 Begin = Batch * CombatCrowd::BatchSize;
+		const int32 End = FMath::Min(Begin + CombatCrowd::BatchSize, NumEntities);
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FVector& Velocity = NewVelocities[Index];
+			const float Speed = static_cast<float>(Velocity.Size2D());
+
+			Velocities[Index] = Velocity;
+			Positions[Index] += Velocity * DeltaTime;
+			AnimPhases[Index] = CombatCrowd::StepAnimPhase(AnimPhases[Index], Speed, DeltaTime, Settings->StrideLength);
+
+			if (Speed > 1.0f)
+			{
+				Yaws[Index] = FMath::RadiansToDegrees(FMath::Atan2(Velocity.Y, Velocity.X));
+			}
+		}
+	}, Flags);
+}
+
+void UCombatCrowdSubsystem::SnapToGround()
+{
+	const int32 NumEntities = Num();
+	const int32 NumTraces = FMath::Min(GetDefault<UCombatCrowdSettings>()->GroundTracesPerFrame, NumEntities);
+	UWorld* World = GetWorld();
+
+	// only the level geometry, never pawns
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatCrowdGround), false);
+	for (int32 Trace = 0; Trace < NumTraces; ++Trace)
+	{
+		GroundCursor = (GroundCursor + 1) % NumEntities;
+		FVector& Location = Positions[GroundCursor];
+
+		const ACombatEnemy* EnemyCDO = Classes[ClassIndices[GroundCursor]].EnemyClass->GetDefaultObject<ACombatEnemy>();
+		const float HalfHeight = EnemyCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+		FHitResult Hit;
+		if (World->LineTraceSingleByObjectType(Hit, Location + FVector(0.0f, 0.0f, HalfHeight), Location - FVector(0.0f, 0.0f, HalfHeight * 4.0f), ObjectParams, QueryParams))
+		{
+			Location.Z = Hit.ImpactPoint.Z + HalfHeight;
+		}
+	}
+}
+
+void UCombatCrowdSubsystem::Promote(TConstArrayView<FInterest> Interest)
+{
+	const UCombatCrowdSettings* Settings = GetDefault<UCombatCrowdSettings>();
+
+	// closest entities in range first, off-camera ones counting as farther
+	TArray<TPair<float, int32>> Candidates;
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		const float Distance = InterestDistance(Positions[Index], Interest, false);
+		if (Distance < Settings->PromoteRadius)
+		{
+			Candidates.Emplace(Distance, Index);
+		}
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		return;
+	}
+
+	Algo::Sort(Candidates, [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	Candidates.SetNum(FMath::Min(Candidates.Num(), Settings->MaxPromotionsPerFrame));
+
+	// remove from the back so the remaining indices stay valid
+	Algo::Sort(Candidates, [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Value > B.Value; });
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	UCombatActorPool* Pool = UCombatActorPool::Get(this);
+
+	for (const TPair<float, int32>& Candidate : Candidates)
+	{
+		const int32 Index = Candidate.Value;
+		const int32 ClassIndex = ClassIndices[Index];
+		const FTransform Transform(FRotator(0.0f, Yaws[Index], 0.0f), Positions[Index]);
+
+		// demoted actors wait in the pool, so promoting near a fight is usually a reuse rather than a spawn
+		ACombatEnemy* Enemy = Pool
+			? Pool->Acquire<ACombatEnemy>(Classes[ClassIndex].EnemyClass, Transform)
+			: GetWorld()->SpawnActor<ACombatEnemy>(Classes[ClassIndex].EnemyClass, Transform, SpawnParams);
+		if (!Enemy)
+		{
+			continue;
+		}
+
+		// carry the entity's state over
+		Enemy->SetCurrentHP(HPs[Index]);
+		OnPromotedDelegates[Index].ExecuteIfBound(Enemy);
+
+		FPromotedEnemy& Entry = Promoted.AddDefaulted_GetRef();
+		Entry.Enemy = Enemy;
+		Entry.ClassIndex = ClassIndex;
+		Entry.OnPromoted = MoveTemp(OnPromotedDelegates[Index]);
+		Entry.OnCleared = MoveTemp(OnClearedDelegates[Index]);
+
+		RemoveEntityAtSwap(Index);
+	}
+}
+
+void UCombatCrowdSubsystem::Demote(TConstArrayView<FInterest> Interest)
+{
+	const UCombatCrowdSettings* Settings = GetDefault<UCombatCrowdSettings>();
+	const double Now = GetWorld()->GetTimeSeconds();
+	const bool bCanRender = GetWorld()->GetNetMode() != NM_DedicatedServer;
+	int32 Demotions = 0;
+
+	for (int32 Index = Promoted.Num() - 1; Index >= 0; --Index)
+	{
+		FPromotedEnemy& Entry = Promoted[Index];
+		ACombatEnemy* Enemy = Entry.Enemy.Get();
+
+		// dead enemies finish their own death and removal
+		if (!Enemy || Enemy->CurrentHP <= 0.0f)
+		{
+			Promoted.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// an actor on screen counts as seen by every view, the renderer knows better than the cone
+		const bool bRendered = bCanRender && Enemy->WasRecentlyRendered(CombatCrowd::RecentlyRenderedTolerance);
+		if (InterestDistance(Enemy->GetActorLocation(), Interest, bRendered) < Settings->DemoteRadius)
+		{
+			Entry.OutOfRangeSince = -1.0;
+			continue;
+		}
+
+		if (Entry.OutOfRangeSince < 0.0)
+		{
+			Entry.OutOfRangeSince = Now;
+		}
+
+		// leave ragdolling enemies alone until they've landed
+		if (Demotions >= Settings->MaxDemotionsPerFrame || Now - Entry.OutOfRangeSince < Settings->DemoteDelay || Enemy->GetMesh()->IsSimulatingPhysics())
+		{
+			continue;
+		}
+
+		Positions.Add(Enemy->GetActorLocation());
+		Velocities.Add(Enemy->GetVelocity() * FVector(1.0f, 1.0f, 0.0f));
+		Yaws.Add(Enemy->GetActorRotation().Yaw);
+		HPs.Add(Enemy->CurrentHP);
+		AnimPhases.Add(0.0f);
+		ClassIndices.Add(Entry.ClassIndex);
+		OnPromotedDelegates.Add(MoveTemp(Entry.OnPromoted));
+		OnClearedDelegates.Add(MoveTemp(Entry.OnCleared));
+
+		// park the actor with its controller, or destroy both without a pool
+		if (UCombatActorPool* Pool = UCombatActorPool::Get(this))
+		{
+			Pool->Release(Enemy);
+		}
+		else
+		{
+			if (AController* Controller = Enemy->GetController())
+			{
+				Controller->Destroy();
+			}
+			Enemy->Destroy();
+		}
+
+		Promoted.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		++Demotions;
+	}
+}
+
+void UCombatCrowdSubsystem::StreamEntities(TConstArrayView<FVector> Players)
+{
+	ACombatCrowdStream* CurrentStream = Stream.Get();
+	const UCombatCrowdSettings* Settings = GetDefault<UCombatCrowdSettings>();
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (!CurrentStream || (LastStreamTime >= 0.0 && Now - LastStreamTime < 1.0 / Settings->StreamRate))
+	{
+		return;
+	}
+
+	LastStreamTime = Now;
+
+	CurrentStream->EnemyClasses.Reset();
+	for (const FCrowdClass& Class : Classes)
+	{
+		CurrentStream->EnemyClasses.Add(Class.EnemyClass);
+	}
+
+	// over budget: the entities nearest to a player make the snapshot
+	TArray<int32> Streamed;
+	Streamed.Reserve(Num());
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		Streamed.Add(Index);
+	}
+
+	// config files aren't held to ClampMax, so the memory limit is applied here too
+	const int32 MaxStreamed = FMath::Min(Settings->MaxStreamedEntities, CombatCrowd::MaxStreamedEntitiesLimit);
+	if (Streamed.Num() > MaxStreamed)
+	{
+		TArray<float> DistSquared;
+		DistSquared.SetNumUninitialized(Num());
+		for (int32 Index = 0; Index < Num(); ++Index)
+		{
+			DistSquared[Index] = CombatCrowd::MinDistSquared(Positions[Index], Players);
+		}
+
+		Algo::Sort(Streamed, [&DistSquared](int32 A, int32 B) { return DistSquared[A] < DistSquared[B]; });
+		Streamed.SetNum(MaxStreamed);
+	}
+
+	TArray<FCombatCrowdNetEntity>& Entities = CurrentStream->Entities;
+	Entities.SetNum(Streamed.Num());
+	for (int32 Slot = 0; Slot < Streamed.Num(); ++Slot)
+	{
+		const int32 Index = Streamed[Slot];
+		Entities[Slot].Location = Positions[Index];
+		Entities[Slot].Velocity = Velocities[Index];
+		Entities[Slot].Yaw = FRotator::CompressAxisToShort(Yaws[Index]);
+		Entities[Slot].ClassIndex = static_cast<uint8>(ClassIndices[Index]);
+	}
+}
+
+void UCombatCrowdSubsystem::Extrapolate(float DeltaTime)
+{
+	const UCombatCrowdSettings* Settings = GetDefault<UCombatCrowdSettings>();
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		Positions[Index] += Velocities[Index] * DeltaTime;
+		AnimPhases[Index] = CombatCrowd::StepAnimPhase(AnimPhases[Index], static_cast<float>(Velocities[Index].Size2D()), DeltaTime, Settings->StrideLength);
+	}
+}
+
+void UCombatCrowdSubsystem::UpdateInstances()
+{
+	UWorld* World = GetWorld();
+	const UCombatCrowdSettings* Settings = GetDefault<UCombatCrowdSettings>();
+
+	// nobody to draw for
+	if (World->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	for (FCrowdClass& Class : Classes)
+	{
+		Class.Entities.Reset();
+	}
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		Classes[ClassIndices[Index]].Entities.Add(Index);
+	}
+
+	for (FCrowdClass& Class : Classes)
+	{
+		UInstancedStaticMeshComponent* Instances = Class.Instances.Get();
+		if (!Instances && Class.Entities.Num() > 0)
+		{
+			// first entity of this class: create its instanced proxy
+			const TSoftObjectPtr<UStaticMesh>* ClassMesh = Settings->ProxyMeshes.Find(TSoftClassPtr<ACombatEnemy>(Class.EnemyClass.Get()));
+			UStaticMesh* ProxyMesh = (ClassMesh ? *ClassMesh : Settings->DefaultProxyMesh).LoadSynchronous();
+			if (!ProxyMesh)
+			{
+				continue;
+			}
+
+			AActor* Owner = ProxyOwner.Get();
+			if (!Owner)
+			{
+				FActorSpawnParameters SpawnParams;
+				SpawnParams.ObjectFlags |= RF_Transient;
+				Owner = World->SpawnActor<AActor>(SpawnParams);
+				ProxyOwner = Owner;
+			}
+
+			Instances = NewObject<UInstancedStaticMeshComponent>(Owner);
+			Instances->SetStaticMesh(ProxyMesh);
+			Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			Instances->SetCanEverAffectNavigation(false);
+			Instances->NumCustomDataFloats = CombatCrowd::NumCustomDataFloats;
+			if (!Owner->GetRootComponent())
+			{
+				Owner->SetRootComponent(Instances);
+			}
+			Instances->RegisterComponent();
+			Class.Instances = Instances;
+		}
+
+		if (!Instances)
+		{
+			continue;
+		}
+
+		// match the instance count to the entity count, trimming or growing at the end
+		const int32 Want = Class.Entities.Num();
+		const int32 Have = Instances->GetInstanceCount();
+		if (Want < Have)
+		{
+			TArray<int32> Tail;
+			for (int32 Index = Want; Index < Have; ++Index)
+			{
+				Tail.Add(Index);
+			}
+			Instances->RemoveInstances(Tail);
+		}
+		else if (Want > Have)
+		{
+			TArray<FTransform> Added;
+			Added.Init(FTransform::Identity, Want - Have);
+			Instances->AddInstances(Added, false, true, false);
+		}
+
+		if (Want == 0)
+		{
+			continue;
+		}
+
+		// the proxy's origin is at the feet, the entity's at the capsule centre
+		const float HalfHeight = Class.EnemyClass->GetDefaultObject<ACombatEnemy>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+		TArray<FTransform> Transforms;
+		Transforms.SetNumUninitialized(Want);
+		for (int32 Instance = 0; Instance < Want; ++Instance)
+		{
+			const int32 Entity = Class.Entities[Instance];
+			Transforms[Instance] = FTransform(FRotator(0.0f, Yaws[Entity], 0.0f), Positions[Entity] - FVector(0.0f, 0.0f, HalfHeight));
+
+			const float CustomData[CombatCrowd::NumCustomDataFloats] = { AnimPhases[Entity], static_cast<float>(Velocities[Entity].Size2D()) / FMath::Max(Settings->MaxSpeed, 1.0f) };
+			Instances->SetCustomData(Instance, MakeArrayView(CustomData), false);
+		}
+
+		Instances->BatchUpdateInstancesTransforms(0, Transforms, true, false, true);
+		Instances->MarkRenderStateDirty();
+	}
+}
+
+void UCombatCrowdSubsystem::PrintStats() const
+{
+	int32 NumPromoted = 0;
+	for (const FPromotedEnemy& Entry : Promoted)
+	{
+		NumPromoted += Entry.Enemy.IsValid() ? 1 : 0;
+	}
+
+	UE_LOG(LogCombatCrowd, Display, TEXT("Crowd: %d entities in %d classes, %d promoted actors; simulate %.3f ms, tick %.3f ms"),
+		Num(), Classes.Num(), NumPromoted, LastSimulateMs, LastTickMs);
+}
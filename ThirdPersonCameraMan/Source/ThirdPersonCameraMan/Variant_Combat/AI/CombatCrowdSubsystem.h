@@ -0,0 +1,250 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatCrowdSubsystem.generated.h"
+
+class ACombatEnemy;
+class ACombatCrowdStream;
+struct FCombatCrowdNetEntity;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/** Called when a crowd entity is promoted to a full enemy actor, so its owner can subscribe to it */
+DECLARE_DELEGATE_OneParam(FOnCrowdEnemyPromoted, ACombatEnemy*);
+
+/**
+ *  Crowd tuning ([/Script/ThirdPersonCameraMan.CombatCrowdSettings] in DefaultGame.ini)
+ */
+UCLASS(config=Game, defaultconfig)
+class UCombatCrowdSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Entities closer than this to a player pawn or the live camera rig become full enemy actors */
+	UPROPERTY(config, EditAnywhere, Category="Promotion", meta = (ClampMin = 100, Units = "cm"))
+	float PromoteRadius = 2500.0f;
+
+	/** Crowd-spawned actors farther than this from every player pawn and the live camera rig go back to the crowd */
+	UPROPERTY(config, EditAnywhere, Category="Promotion", meta = (ClampMin = 100, Units = "cm"))
+	float DemoteRadius = 3500.0f;
+
+	/** Distances to a player or the live rig whose view can't see the entity (outside the view cone, or a promoted actor that isn't rendered) count this many times farther, so off-camera enemies stay in the crowd until they're close */
+	UPROPERTY(config, EditAnywhere, Category="Promotion", meta = (ClampMin = 1))
+	float OffCameraDistanceScale = 3.0f;
+
+	/** Added to half the view's field of view when testing the view cone, so entities at the screen edge count as seen */
+	UPROPERTY(config, EditAnywhere, Category="Promotion", meta = (ClampMin = 0, ClampMax = 90, Units = "deg"))
+	float ViewConeMargin = 15.0f;
+
+	/** A promoted actor must stay beyond the demote radius this long before it's demoted */
+	UPROPERTY(config, EditAnywhere, Category="Promotion", meta = (ClampMin = 0, Units = "s"))
+	float DemoteDelay = 2.0f;
+
+	/** Actor spawns / destroys per frame, closest first, so a wave walking into range doesn't hitch */
+	UPROPERTY(config, EditAnywhere, Category="Promotion", meta = (ClampMin = 1))
+	int32 MaxPromotionsPerFrame = 2;
+	UPROPERTY(config, EditAnywhere, Category="Promotion", meta = (ClampMin = 1))
+	int32 MaxDemotionsPerFrame = 2;
+
+	/** Entities walk towards the nearest player pawn within this distance and idle otherwise */
+	UPROPERTY(config, EditAnywhere, Category="Movement", meta = (ClampMin = 0, Units = "cm"))
+	float SeekRadius = 6000.0f;
+
+	/** Walking speed and acceleration */
+	UPROPERTY(config, EditAnywhere, Category="Movement", meta = (ClampMin = 0, Units = "cm/s"))
+	float MaxSpeed = 300.0f;
+	UPROPERTY(config, EditAnywhere, Category="Movement", meta = (ClampMin = 0))
+	float Acceleration = 600.0f;
+
+	/** Entities keep at least this far apart */
+	UPROPERTY(config, EditAnywhere, Category="Movement", meta = (ClampMin = 0, Units = "cm"))
+	float SeparationRadius = 90.0f;
+
+	/** Entities are snapped to the ground with this many line traces per frame, round robin */
+	UPROPERTY(config, EditAnywhere, Category="Movement", meta = (ClampMin = 0))
+	int32 GroundTracesPerFrame = 32;
+
+	/** Distance covered by one loop of the baked walk cycle, for the animation phase passed to the proxy material */
+	UPROPERTY(config, EditAnywhere, Category="Rendering", meta = (ClampMin = 1, Units = "cm"))
+	float StrideLength = 150.0f;
+
+	/** Instanced proxy mesh per enemy class; classes without one use DefaultProxyMesh */
+	UPROPERTY(config, EditAnywhere, Category="Rendering")
+	TMap<TSoftClassPtr<ACombatEnemy>, TSoftObjectPtr<UStaticMesh>> ProxyMeshes;
+	UPROPERTY(config, EditAnywhere, Category="Rendering")
+	TSoftObjectPtr<UStaticMesh> DefaultProxyMesh;
+
+	/** Crowd snapshots sent to clients per second */
+	UPROPERTY(config, EditAnywhere, Category="Replication", meta = (ClampMin = 1, ClampMax = 30, Units = "Hz"))
+	float StreamRate = 5.0f;
+
+	/** Most entities per snapshot, nearest to a player first. Capped so the snapshot stays under net.MaxRepArrayMemory (64 KB):
+	 *  each entry is 56 bytes in memory (FVector_NetQuantize holds doubles), so about 1170 fit; larger snapshots are dropped */
+	UPROPERTY(config, EditAnywhere, Category="Replication", meta = (ClampMin = 0, ClampMax = 1024))
+	int32 MaxStreamedEntities = 1024;
+
+	/** Enemy class used by combat.Crowd spawn */
+	UPROPERTY(config, EditAnywhere, Category="Debug")
+	TSoftClassPtr<ACombatEnemy> DefaultEnemyClass;
+};
+
+/**
+ *  Runs distant enemies as lightweight crowd entities instead of full ACombatEnemy actors.
+ *  Entities are kept as structure-of-arrays and stepped in parallel: seek the nearest player, keep apart through
+ *  a spatial hash, snap to the ground with a few traces per frame. They are drawn as one instanced proxy mesh per
+ *  enemy class, with the walk cycle phase and speed in per-instance custom data for animation-baked materials.
+ *  Entities near a player pawn or the live camera rig are promoted to full actors, a few per frame, closest first,
+ *  with distances to views that can't see them scaled up so off-camera enemies stay entities until they're close;
+ *  crowd-spawned actors that end up far from all of them are demoted again. The simulation runs on the server,
+ *  which streams a snapshot to clients through ACombatCrowdStream; clients draw it with their own proxies.
+ */
+UCLASS()
+class UCombatCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the subsystem for the provided world context */
+	static UCombatCrowdSubsystem* Get(const UObject* WorldContext);
+
+	/** Adds an entity. OnPromoted fires every time it becomes an actor, OnCleared if Clear removes it while it's an entity */
+	void AddEnemy(TSubclassOf<ACombatEnemy> EnemyClass, const FTransform& Transform, FOnCrowdEnemyPromoted OnPromoted = FOnCrowdEnemyPromoted(), FSimpleDelegate OnCleared = FSimpleDelegate());
+
+	/** Removes every entity, telling whoever added them, and forgets the promoted actors */
+	void Clear();
+
+	/** Replaces a client's entities with a snapshot from the server */
+	void ReceiveStreamedEntities(TConstArrayView<TSubclassOf<ACombatEnemy>> EnemyClasses, TConstArrayView<FCombatCrowdNetEntity> Entities);
+
+	/** Number of entities */
+	int32 Num() const { return Positions.Num(); }
+
+	/** Logs entity, promoted actor and timing figures */
+	void PrintStats() const;
+
+	/** Steps the crowd, promotes, demotes and updates the instances; clients only move and draw the streamed entities */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Only game worlds run a crowd */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+	}
+
+	/** Spawns the stream on servers with clients */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+private:
+
+	/** An enemy class the crowd has seen and its instanced proxy */
+	struct FCrowdClass
+	{
+		TSubclassOf<ACombatEnemy> EnemyClass;
+		TWeakObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+		/** Entity indices drawn by this class's instances this frame */
+		TArray<int32> Entities;
+	};
+
+	/** A crowd-spawned actor and what it needs to go back to the crowd */
+	struct FPromotedEnemy
+	{
+		TWeakObjectPtr<ACombatEnemy> Enemy;
+		int32 ClassIndex = INDEX_NONE;
+		FOnCrowdEnemyPromoted OnPromoted;
+		FSimpleDelegate OnCleared;
+
+		/** World time since which the actor has been out of range, negative while in range */
+		double OutOfRangeSince = -1.0;
+	};
+
+	/** Finds or registers an enemy class */
+	int32 FindOrAddClass(TSubclassOf<ACombatEnemy> EnemyClass);
+
+	/** Removes an entity by swapping the last one into its place */
+	void RemoveEntityAtSwap(int32 Index);
+
+	/** A player pawn or the live rig, and the view that decides whether it can see an entity */
+	struct FInterest
+	{
+		FVector Location;
+		FVector ViewLocation;
+		FVector ViewDirection;
+		float CosHalfAngle;
+	};
+
+	/** Gathers player pawn locations and every player pawn and live camera rig with its view */
+	void GatherInterest(TArray<FVector>& OutPlayers, TArray<FInterest>& OutInterest) const;
+
+	/** Distance to the nearest point of interest, scaled for views that can't see the location unless bSeen */
+	float InterestDistance(const FVector& Location, TConstArrayView<FInterest> Interest, bool bSeen) const;
+
+	/** Parallel seek / separation / integration step */
+	void Simulate(float DeltaTime, TConstArrayView<FVector> Players);
+
+	/** Round-robin ground snapping */
+	void SnapToGround();
+
+	/** Turns the closest entities in range into actors */
+	void Promote(TConstArrayView<FInterest> Interest);
+
+	/** Turns crowd-spawned actors out of range back into entities */
+	void Demote(TConstArrayView<FInterest> Interest);
+
+	/** Writes a snapshot to the stream when it's due */
+	void StreamEntities(TConstArrayView<FVector> Players);
+
+	/** Moves streamed entities along their velocity between snapshots */
+	void Extrapolate(float DeltaTime);
+
+	/** Writes instance transforms and custom data; nothing on a dedicated server */
+	void UpdateInstances();
+
+	/** Entity state, one element per entity in every array */
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> Yaws;
+	TArray<float> HPs;
+	TArray<float> AnimPhases;
+	TArray<int32> ClassIndices;
+
+	/** Cold entity data, only touched on promotion */
+	TArray<FOnCrowdEnemyPromoted> OnPromotedDelegates;
+	TArray<FSimpleDelegate> OnClearedDelegates;
+
+	/** Spatial hash of entity indices, rebuilt each step */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** Enemy classes and their instanced proxies */
+	TArray<FCrowdClass> Classes;
+
+	/** Crowd-spawned actors */
+	TArray<FPromotedEnemy> Promoted;
+
+	/** Transient actor owning the instanced proxies */
+	TWeakObjectPtr<AActor> ProxyOwner;
+
+	/** Replicates the entities to clients, servers with clients only */
+	TWeakObjectPtr<ACombatCrowdStream> Stream;
+
+	/** World time of the last snapshot */
+	double LastStreamTime = -1.0;
+
+	/** Next entity to ground snap */
+	int32 GroundCursor = 0;
+
+	/** Last step timings */
+	double LastSimulateMs = 0.0;
+	double LastTickMs = 0.0;
+};
@@ -5,17 +5,24 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "CombatAIController.h"
-#include "Components/WidgetComponent.h"
 #include "Engine/DamageEvents.h"
-#include "CombatLifeBar.h"
+#include "CombatHealthBarSubsystem.h"
+#include "CombatRagdollManager.h"
+#include "CombatSignificanceSubsystem.h"
 #include "TimerManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
+#include "CombatMeleeQuerySubsystem.h"
+#include "CombatActorPool.h"
+#include "BrainComponent.h"
 
 ACombatEnemy::ACombatEnemy()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	// let the significance pass throttle animation through update rate optimizations
+	GetMesh()->bEnableUpdateRateOptimizations = true;
+
 	// bind the attack montage ended delegate
 	OnAttackMontageEnded.BindUObject(this, &ACombatEnemy::AttackMontageEnded);
 
@@ -28,10 +35,6 @@ ACombatEnemy::ACombatEnemy()
 	// ignore the controller's yaw rotation
 	bUseControllerRotationYaw = false;
 
-	// create the life bar
-	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
-	LifeBar->SetupAttachment(RootComponent);
-
 	// set the collision capsule size
 	GetCapsuleComponent()->SetCapsuleSize(35.0f, 90.0f);
 
@@ -59,6 +62,9 @@ void ACombatEnemy::DoAIComboAttack()
 	// reset the attack counter
 	CurrentComboAttack = 0;
 
+	// start a new swing for the weapon trail
+	WeaponTrail.BeginSwing(WeaponTrailSweepBudget);
+
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
@@ -90,6 +96,9 @@ void ACombatEnemy::DoAIChargedAttack()
 	// reset the charge loop counter
 	CurrentChargeLoop = 0;
 
+	// start a new swing for the weapon trail
+	WeaponTrail.BeginSwing(WeaponTrailSweepBudget);
+
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
@@ -113,48 +122,54 @@ void ACombatEnemy::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 	OnAttackCompleted.ExecuteIfBound();
 }
 
+void ACombatEnemy::SetCurrentHP(float HP)
+{
+	CurrentHP = FMath::Clamp(HP, 0.0f, MaxHP);
+
+	// update the life bar
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->SetPercent(this, CurrentHP / MaxHP);
+	}
+}
+
 void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
 {
 	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	FCombatMeleeQuery Query;
+	Query.Attacker = this;
 
 	// start at the provided socket location, sweep forward
-	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
-	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
+	Query.Start = GetMesh()->GetSocketLocation(DamageSourceBone);
+	Query.End = Query.Start + (GetActorForwardVector() * MeleeTraceDistance);
+
+	// use a sphere shape for the sweep
+	Query.Radius = MeleeTraceRadius;
 
 	// enemies only affect Pawn collision objects; they don't knock back boxes
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	Query.ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
 
-	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(MeleeTraceRadius);
+	// only damage the player
+	Query.RequiredTargetTag = FName("Player");
 
-	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	Query.Damage = MeleeDamage;
+	Query.KnockbackImpulse = MeleeKnockbackImpulse;
+	Query.LaunchImpulse = MeleeLaunchImpulse;
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	// hand the sweep to the melee query subsystem; hits are dispatched once it resolves
+	if (UCombatMeleeQuerySubsystem* MeleeQueries = UCombatMeleeQuerySubsystem::Get(this))
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		if (MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail)
+		{
+			// follow the configured trail bone, or this notify's bone if there's none
+			TrailBoneName = WeaponTrailBone.IsNone() ? DamageSourceBone : WeaponTrailBone;
+
+			// sweep the path the bone took since the last trace instead
+			WeaponTrail.QueueSweeps(MeleeQueries, Query, GetMesh()->GetSocketLocation(TrailBoneName), GetWorld()->GetTimeSeconds(), WeaponTrailWindow, WeaponTrailMinStep);
+		}
+		else
 		{
-			/** does the actor have the player tag? */
-			if (CurrentHit.GetActor()->ActorHasTag(FName("Player")))
-			{
-				// check if the actor is damageable
-				ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
-
-				if (Damageable)
-				{
-					// knock upwards and away from the impact normal
-					const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
-
-					// pass the damage event to the actor
-					Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
-
-				}
-			}
+			MeleeQueries->QueueAttack(Query);
 		}
 	}
 }
@@ -172,6 +187,9 @@ void ACombatEnemy::CheckCombo()
 		{
 			AnimInstance->Montage_JumpToSection(ComboSectionNames[CurrentComboAttack], ComboAttackMontage);
 		}
+
+		// each attack in the string is a swing of its own
+		WeaponTrail.BeginSwing(WeaponTrailSweepBudget);
 	}
 }
 
@@ -185,6 +203,9 @@ void ACombatEnemy::CheckChargedAttack()
 	{
 		AnimInstance->Montage_JumpToSection(CurrentChargeLoop >= TargetChargeLoops ? ChargeAttackSection : ChargeLoopSection, ChargedAttackMontage);
 	}
+
+	// the loop or the release is a new swing
+	WeaponTrail.BeginSwing(WeaponTrailSweepBudget);
 }
 
 void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
@@ -222,7 +243,10 @@ void ACombatEnemy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector
 void ACombatEnemy::HandleDeath()
 {
 	// hide the life bar
-	LifeBar->SetHiddenInGame(true);
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->SetShown(this, false);
+	}
 
 	// disable the collision capsule to avoid being hit again while dead
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -233,6 +257,12 @@ void ACombatEnemy::HandleDeath()
 	// enable full ragdoll physics
 	GetMesh()->SetSimulatePhysics(true);
 
+	// count the ragdoll against the physics budget
+	if (UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this))
+	{
+		Ragdolls->AddRagdoll(GetMesh(), ECombatRagdollKind::Death);
+	}
+
 	// call the died delegate to notify any subscribers
 	OnEnemyDied.Broadcast();
 
@@ -247,8 +277,108 @@ void ACombatEnemy::ApplyHealing(float Healing, AActor* Healer)
 
 void ACombatEnemy::RemoveFromLevel()
 {
-	// destroy this actor
-	Destroy();
+	// park this actor for reuse if there's a pool, destroy it otherwise
+	if (UCombatActorPool* Pool = UCombatActorPool::Get(this))
+	{
+		Pool->Release(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void ACombatEnemy::OnAcquiredFromPool(const FTransform& SpawnTransform)
+{
+	// move to the spawn point without carrying over any velocity
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// bring the character back into play
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	GetMesh()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+
+	// restore the capsule collision disabled on death
+	const ACombatEnemy* Defaults = GetClass()->GetDefaultObject<ACombatEnemy>();
+	GetCapsuleComponent()->SetCollisionEnabled(Defaults->GetCapsuleComponent()->GetCollisionEnabled());
+
+	// walk again
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	// reset the attack state
+	bIsAttacking = false;
+	TargetComboCount = CurrentComboAttack = 0;
+	TargetChargeLoops = CurrentChargeLoop = 0;
+	TrailBoneName = NAME_None;
+
+	// top up the HP and refill the life bar before StateTree runs again, as in BeginPlay
+	SetCurrentHP(MaxHP);
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->SetShown(this, true);
+	}
+
+	// restart StateTree, or get a new controller if the old one went away
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->RestartLogic();
+		}
+	}
+	else
+	{
+		SpawnDefaultController();
+	}
+}
+
+void ACombatEnemy::OnReturnedToPool()
+{
+	// stop StateTree first so it doesn't react to the montages stopping
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->StopLogic(TEXT("Returned to pool"));
+		}
+	}
+
+	// stop any attack in progress
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->StopAllMontages(0.0f);
+	}
+
+	// clear the death timer and anything else pending
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	// thaw a frozen ragdoll and stop counting it
+	if (UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this))
+	{
+		Ragdolls->RemoveRagdoll(GetMesh());
+	}
+
+	// end the ragdoll and put the mesh back where it started on the capsule
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	GetMesh()->SetRelativeTransform(MeshStartingTransform);
+
+	// stand still
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+
+	// take the character out of play
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	GetMesh()->SetComponentTickEnabled(false);
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	// the next owner subscribes again
+	OnEnemyDied.Clear();
 }
 
 float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -271,11 +401,18 @@ float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEv
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+		{
+			HealthBars->SetPercent(this, CurrentHP / MaxHP);
+		}
 
-		// enable partial ragdoll physics, but keep the pelvis vertical
-		GetMesh()->SetPhysicsBlendWeight(0.5f);
-		GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
+		// enable partial ragdoll physics, but keep the pelvis vertical, if the physics budget allows it
+		UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this);
+		if (!Ragdolls || Ragdolls->AddRagdoll(GetMesh(), ECombatRagdollKind::HitReaction))
+		{
+			GetMesh()->SetPhysicsBlendWeight(0.5f);
+			GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
+		}
 	}
 
 	// return the received damage amount
@@ -291,6 +428,11 @@ void ACombatEnemy::Landed(const FHitResult& Hit)
 	{
 		// disable ragdoll physics
 		GetMesh()->SetPhysicsBlendWeight(0.0f);
+
+		if (UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this))
+		{
+			Ragdolls->RemoveRagdoll(GetMesh());
+		}
 	}
 
 	// call the landed Delegate for StateTree
@@ -305,18 +447,55 @@ void ACombatEnemy::BeginPlay()
 	// we top the HP before BeginPlay so StateTree picks it up at the right value
 	Super::BeginPlay();
 
-	// get the life bar widget from the widget comp
-	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-	check(LifeBarWidget);
+	// save the mesh placement so a pooled ragdoll can be put back together
+	MeshStartingTransform = GetMesh()->GetRelativeTransform();
+
+	// add a full life bar to the batched health bar renderer
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->AddBar(this, LifeBarHeight, LifeBarColor);
+	}
 
-	// fill the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	// let the significance pass throttle us when nobody is looking
+	if (UCombatSignificanceSubsystem* Significance = UCombatSignificanceSubsystem::Get(this))
+	{
+		Significance->Register(this);
+	}
+}
+
+void ACombatEnemy::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// follow the damage bone while attacking so the next attack trace can sweep its path
+	if (bIsAttacking && MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail && !TrailBoneName.IsNone())
+	{
+		WeaponTrail.AddSample(GetMesh()->GetSocketLocation(TrailBoneName), GetWorld()->GetTimeSeconds(), WeaponTrailWindow);
+	}
 }
 
 void ACombatEnemy::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	// stop rating our significance
+	if (UCombatSignificanceSubsystem* Significance = UCombatSignificanceSubsystem::Get(this))
+	{
+		Significance->Unregister(this);
+	}
+
+	// stop counting the ragdoll
+	if (UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this))
+	{
+		Ragdolls->RemoveRagdoll(GetMesh());
+	}
+
 	// clear the death timer
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	// remove the life bar
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->RemoveBar(this);
+	}
 }
@@ -6,12 +6,12 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "CombatPoolable.h"
+#include "CombatWeaponTrail.h"
 #include "Animation/AnimMontage.h"
 #include "Engine/TimerHandle.h"
 #include "CombatEnemy.generated.h"
 
-class UWidgetComponent;
-class UCombatLifeBar;
 class UAnimMontage;
 
 /** Completed attack animation delegate for StateTree */
@@ -28,14 +28,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyDied);
  *  Its bundled AI Controller runs logic through StateTree
  */
 UCLASS(abstract)
-class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDamageable
+class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDamageable, public ICombatPoolable
 {
 	GENERATED_BODY()
 
-	/** Life bar widget component */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
-	UWidgetComponent* LifeBar;
-
 public:
 	
 	/** Constructor */
@@ -59,9 +55,13 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
 
-	/** Pointer to the life bar widget */
+	/** Height of the life bar above the character's origin */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
+	float LifeBarHeight = 120.0f;
+
+	/** Life bar fill color */
 	UPROPERTY(EditAnywhere, Category="Damage")
-	UCombatLifeBar* LifeBarWidget;
+	FLinearColor LifeBarColor = FLinearColor(0.8f, 0.05f, 0.05f);
 
 	/** If true, the character is currently playing an attack animation */
 	bool bIsAttacking = false;
@@ -74,6 +74,32 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
 	float MeleeTraceRadius = 50.0f;
 
+	/** Shape of the melee attack collision check */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace")
+	ECombatMeleeTraceMode MeleeTraceMode = ECombatMeleeTraceMode::Forward;
+
+	/** Bone the weapon trail follows. If none, the bone of the last attack trace notify is followed */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (EditCondition = "MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail"))
+	FName WeaponTrailBone;
+
+	/** Only this much of the bone's path before an attack trace is swept, so the attack windup isn't */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 1, Units = "s", EditCondition = "MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail"))
+	float WeaponTrailWindow = 0.2f;
+
+	/** Steps along the bone's path shorter than this are merged into one sweep */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 100, Units = "cm", EditCondition = "MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail"))
+	float WeaponTrailMinStep = 10.0f;
+
+	/** Maximum number of sweeps a single swing may run, however many attack traces it has */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 1, ClampMax = 32, EditCondition = "MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail"))
+	int32 WeaponTrailSweepBudget = 8;
+
+	/** Records the damage bone's path and the actors hit during the current swing */
+	FCombatWeaponTrail WeaponTrail;
+
+	/** Bone the weapon trail is currently following */
+	FName TrailBoneName;
+
 	/** Amount of damage a melee attack will deal */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 100))
 	float MeleeDamage = 1.0f;
@@ -133,6 +159,9 @@ protected:
 	/** Enemy death timer */
 	FTimerHandle DeathTimer;
 
+	/** Mesh transform relative to the capsule at spawn, restored when the ragdolled mesh is reused from the pool */
+	FTransform MeshStartingTransform;
+
 	/** Attack montage ended delegate */
 	FOnMontageEnded OnAttackMontageEnded;
 
@@ -158,6 +187,12 @@ public:
 	/** Called from a delegate when the attack montage ends */
 	void AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
+	/** Returns the HP the character spawns with */
+	float GetMaxHP() const { return MaxHP; }
+
+	/** Sets the current HP and updates the life bar, e.g. when taking over a crowd entity's state */
+	void SetCurrentHP(float HP);
+
 public:
 
 	// ~begin ICombatAttacker interface
@@ -188,9 +223,19 @@ public:
 
 	// ~end ICombatDamageable interface
 
+	// ~begin ICombatPoolable interface
+
+	/** Resets HP, ragdoll, life bar and StateTree, as if freshly spawned at the provided transform */
+	virtual void OnAcquiredFromPool(const FTransform& SpawnTransform) override;
+
+	/** Takes the character out of play while it waits in the pool */
+	virtual void OnReturnedToPool() override;
+
+	// ~end ICombatPoolable interface
+
 protected:
 
-	/** Removes this character from the level after it dies */
+	/** Removes this character from the level after it dies, returning it to the actor pool if there is one */
 	void RemoveFromLevel();
 
 public:
@@ -212,6 +257,9 @@ protected:
 	/** Gameplay initialization */
 	virtual void BeginPlay() override;
 
+	/** Follows the damage bone for weapon trail traces */
+	virtual void Tick(float DeltaSeconds) override;
+
 	/** EndPlay cleanup */
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 };
@@ -7,6 +7,9 @@
 #include "Components/ArrowComponent.h"
 #include "TimerManager.h"
 #include "CombatEnemy.h"
+#include "CombatCrowdSubsystem.h"
+#include "CombatActorPool.h"
+#include "CombatSpawnDirector.h"
 
 ACombatEnemySpawner::ACombatEnemySpawner()
 {
@@ -35,7 +38,7 @@ void ACombatEnemySpawner::BeginPlay()
 	if (bShouldSpawnEnemiesImmediately)
 	{
 		// schedule the first enemy spawn
-		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, InitialSpawnDelay);
+		ScheduleSpawn(InitialSpawnDelay);
 	}
 
 }
@@ -46,6 +49,32 @@ void ACombatEnemySpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 
 	// clear the spawn timer
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+
+	// drop any queued spawn
+	if (UCombatSpawnDirector* SpawnDirector = UCombatSpawnDirector::Get(this))
+	{
+		SpawnDirector->CancelRequest(this);
+	}
+}
+
+void ACombatEnemySpawner::ScheduleSpawn(float Delay)
+{
+	// let the spawn director fit the spawn into its per-frame budget alongside every other spawner's
+	if (UCombatSpawnDirector* SpawnDirector = UCombatSpawnDirector::Get(this))
+	{
+		SpawnDirector->RequestSpawn(this, Delay, FSimpleDelegate::CreateUObject(this, &ACombatEnemySpawner::SpawnEnemy));
+		return;
+	}
+
+	// no director, spawn on our own timer
+	if (Delay > 0.0f)
+	{
+		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, Delay);
+	}
+	else
+	{
+		SpawnEnemy();
+	}
 }
 
 void ACombatEnemySpawner::SpawnEnemy()
@@ -53,21 +82,45 @@ void ACombatEnemySpawner::SpawnEnemy()
 	// ensure the enemy class is valid
 	if (IsValid(EnemyClass))
 	{
-		// spawn the enemy at the reference capsule's transform
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		// hand the enemy to the crowd; we subscribe to it whenever it becomes an actor
+		if (bSpawnIntoCrowd)
+		{
+			if (UCombatCrowdSubsystem* Crowd = UCombatCrowdSubsystem::Get(this))
+			{
+				Crowd->AddEnemy(EnemyClass, SpawnCapsule->GetComponentTransform(), FOnCrowdEnemyPromoted::CreateUObject(this, &ACombatEnemySpawner::AdoptEnemy), FSimpleDelegate::CreateUObject(this, &ACombatEnemySpawner::OnCrowdCleared));
+				return;
+			}
+		}
 
-		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+		// spawn the enemy at the reference capsule's transform, reusing a pooled one if there is one
+		ACombatEnemy* SpawnedEnemy = nullptr;
+
+		if (UCombatActorPool* Pool = UCombatActorPool::Get(this))
+		{
+			SpawnedEnemy = Pool->Acquire<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform());
+		}
+		else
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+			SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+		}
 
 		// was the enemy successfully created?
 		if (SpawnedEnemy)
 		{
-			// subscribe to the death delegate
-			SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+			AdoptEnemy(SpawnedEnemy);
 		}
 	}
 }
 
+void ACombatEnemySpawner::AdoptEnemy(ACombatEnemy* Enemy)
+{
+	// subscribe to the death delegate
+	Enemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+}
+
 void ACombatEnemySpawner::OnEnemyDied()
 {
 	// decrease the spawn counter
@@ -82,7 +135,20 @@ void ACombatEnemySpawner::OnEnemyDied()
 	}
 
 	// schedule the next enemy spawn
-	GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, RespawnDelay);
+	ScheduleSpawn(RespawnDelay);
+}
+
+void ACombatEnemySpawner::OnCrowdCleared()
+{
+	// the enemy we were waiting on is gone without dying: nothing left to spawn, and nothing to activate
+	SpawnCount = 0;
+
+	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+
+	if (UCombatSpawnDirector* SpawnDirector = UCombatSpawnDirector::Get(this))
+	{
+		SpawnDirector->CancelRequest(this);
+	}
 }
 
 void ACombatEnemySpawner::SpawnerDepleted()
@@ -115,8 +181,8 @@ void ACombatEnemySpawner::ActivateInteraction(AActor* ActivationInstigator)
 	// raise the activation flag
 	bHasBeenActivated = true;
 
-	// spawn the first enemy
-	SpawnEnemy();
+	// spawn the first enemy as soon as the spawn director has room
+	ScheduleSpawn(0.0f);
 }
 
 void ACombatEnemySpawner::DeactivateInteraction(AActor* ActivationInstigator)
@@ -50,6 +50,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	float RespawnDelay = 5.0f;
 
+	/** If true, enemies are added to the crowd and only become actors once a player or the live camera gets close */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner")
+	bool bSpawnIntoCrowd = false;
+
 	/** Time to wait after this spawner is depleted before activating the actor list */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation", meta = (ClampMin = 0, ClampMax = 10))
 	float ActivationDelay = 1.0f;
@@ -61,7 +65,7 @@ protected:
 	/** Flag to ensure this is only activated once */
 	bool bHasBeenActivated = false;
 
-	/** Timer to spawn enemies after a delay */
+	/** Timer to spawn enemies after a delay when there's no spawn director, and to activate the actor list */
 	FTimerHandle SpawnTimer;
 
 public:	
@@ -79,13 +83,22 @@ public:
 
 protected:
 
+	/** Queues the next enemy spawn with the spawn director, or on the spawn timer if there's none */
+	void ScheduleSpawn(float Delay);
+
 	/** Spawn an enemy and subscribe to its death event */
 	void SpawnEnemy();
 
+	/** Subscribes to a spawned enemy's death event */
+	void AdoptEnemy(ACombatEnemy* Enemy);
+
 	/** Called when the spawned enemy has died */
 	UFUNCTION()
 	void OnEnemyDied();
 
+	/** Called when the crowd is cleared while our enemy is still an entity */
+	void OnCrowdCleared();
+
 	/** Called after the last spawned enemy has died */
 	void SpawnerDepleted();
 
@@ -0,0 +1,183 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSpawnDirector.h"
+#include "ThirdPersonCameraMan.h"
+#include "Algo/Sort.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatSpawnDirector, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Combat spawn director"), STAT_CombatSpawnDirector, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat spawn queue depth"), STAT_CombatSpawnQueueDepth, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatSpawnDirectorCommand(
+	TEXT("combat.SpawnDirector"),
+	TEXT("Print spawn queue depth, wait times and per-frame spawn cost"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (const UCombatSpawnDirector* Director = UCombatSpawnDirector::Get(World))
+		{
+			Director->PrintStats();
+		}
+	}));
+
+UCombatSpawnDirector* UCombatSpawnDirector::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UCombatSpawnDirector>() : nullptr;
+}
+
+TStatId UCombatSpawnDirector::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatSpawnDirector, STATGROUP_Tickables);
+}
+
+void UCombatSpawnDirector::RequestSpawn(AActor* Requester, float Delay, FSimpleDelegate Spawn)
+{
+	CancelRequest(Requester);
+
+	FSpawnRequest& Request = Requests.AddDefaulted_GetRef();
+	Request.Requester = Requester;
+	Request.Spawn = MoveTemp(Spawn);
+	Request.DueTime = GetWorld()->GetTimeSeconds() + FMath::Max(0.0f, Delay);
+}
+
+void UCombatSpawnDirector::CancelRequest(AActor* Requester)
+{
+	Requests.RemoveAllSwap([Requester](const FSpawnRequest& Request) { return Request.Requester.Get() == Requester; }, EAllowShrinking::No);
+}
+
+void UCombatSpawnDirector::AddWaitSample(float WaitMs)
+{
+	const int32 MaxSamples = GetDefault<UCombatSpawnDirectorSettings>()->WaitSamples;
+	if (WaitTimesMs.Num() < MaxSamples)
+	{
+		WaitTimesMs.Add(WaitMs);
+	}
+	else
+	{
+		NextWaitSample %= MaxSamples;
+		WaitTimesMs[NextWaitSample++] = WaitMs;
+	}
+
+	MaxWaitMs = FMath::Max(MaxWaitMs, WaitMs);
+}
+
+void UCombatSpawnDirector::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatSpawnDirector);
+
+	UWorld* World = GetWorld();
+	const UCombatSpawnDirectorSettings* Settings = GetDefault<UCombatSpawnDirectorSettings>();
+	const double Now = World->GetTimeSeconds();
+
+	// drop the requests of spawners that went away
+	Requests.RemoveAllSwap([](const FSpawnRequest& Request) { return !Request.Requester.IsValid() || !Request.Spawn.IsBound(); }, EAllowShrinking::No);
+
+	// gather the due requests
+	TArray<TPair<float, int32>, TInlineAllocator<16>> Due;
+	for (int32 Index = 0; Index < Requests.Num(); ++Index)
+	{
+		if (Requests[Index].DueTime <= Now)
+		{
+			Due.Emplace(0.0f, Index);
+		}
+	}
+
+	LastFrameSpawnMs = 0.0;
+	LastQueueDepth = Due.Num();
+	MaxQueueDepth = FMath::Max(MaxQueueDepth, LastQueueDepth);
+
+	if (Due.Num() == 0)
+	{
+		SET_DWORD_STAT(STAT_CombatSpawnQueueDepth, 0);
+		return;
+	}
+
+	// closest to a player first; waiting counts as getting closer
+	if (Due.Num() > 1)
+	{
+		TArray<FVector, TInlineAllocator<4>> Players;
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+			{
+				Players.Add(Pawn->GetActorLocation());
+			}
+		}
+
+		for (TPair<float, int32>& Entry : Due)
+		{
+			const FSpawnRequest& Request = Requests[Entry.Value];
+			const FVector Location = Request.Requester->GetActorLocation();
+
+			float Distance = Players.Num() > 0 ? UE_BIG_NUMBER : 0.0f;
+			for (const FVector& Player : Players)
+			{
+				Distance = FMath::Min(Distance, static_cast<float>(FVector::Dist(Location, Player)));
+			}
+
+			Entry.Key = Distance - static_cast<float>(Now - Request.DueTime) * Settings->AgingDistancePerSecond;
+		}
+
+		Algo::Sort(Due, [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	}
+
+	// serve within the budget; the first one always goes so the queue can't stall behind one expensive spawn
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumServedThisFrame = 0;
+
+	for (const TPair<float, int32>& Entry : Due)
+	{
+		if (Settings->bEnabled && NumServedThisFrame > 0
+			&& (NumServedThisFrame >= Settings->MaxSpawnsPerFrame || LastFrameSpawnMs >= Settings->SpawnBudgetMs))
+		{
+			break;
+		}
+
+		// the spawn may queue the spawner's next request and grow the array, so mark this one served and work off a copy
+		FSpawnRequest& Request = Requests[Entry.Value];
+		const FSimpleDelegate Spawn = MoveTemp(Request.Spawn);
+		const double DueTime = Request.DueTime;
+		Request.Requester.Reset();
+
+		AddWaitSample(static_cast<float>(Now - DueTime) * 1000.0f);
+		Spawn.ExecuteIfBound();
+		++NumServedThisFrame;
+
+		LastFrameSpawnMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+
+	// drop the served requests
+	Requests.RemoveAllSwap([](const FSpawnRequest& Request) { return !Request.Requester.IsValid(); }, EAllowShrinking::No);
+
+	NumServed += NumServedThisFrame;
+	NumDeferred += Due.Num() - NumServedThisFrame;
+	MaxFrameSpawnMs = FMath::Max(MaxFrameSpawnMs, LastFrameSpawnMs);
+	LastQueueDepth = Due.Num() - NumServedThisFrame;
+
+	SET_DWORD_STAT(STAT_CombatSpawnQueueDepth, LastQueueDepth);
+}
+
+void UCombatSpawnDirector::PrintStats() const
+{
+	TArray<float> Sorted = WaitTimesMs;
+	Sorted.Sort();
+
+	float MeanWaitMs = 0.0f;
+	for (const float WaitMs : Sorted)
+	{
+		MeanWaitMs += WaitMs;
+	}
+	MeanWaitMs = Sorted.Num() > 0 ? MeanWaitMs / Sorted.Num() : 0.0f;
+
+	UE_LOG(LogCombatSpawnDirector, Display, TEXT("Spawn director: %d queued, %d due now (max %d); %d served, %d frame deferrals"),
+		Requests.Num(), LastQueueDepth, MaxQueueDepth, NumServed, NumDeferred);
+	UE_LOG(LogCombatSpawnDirector, Display, TEXT("  wait past due: mean %.1f ms, p95 %.1f ms, max %.1f ms over the last %d spawns; spawn cost per frame max %.3f ms"),
+		MeanWaitMs, ThirdPersonCameraMan::NearestRankPercentile(Sorted, 0.95f), MaxWaitMs, Sorted.Num(), MaxFrameSpawnMs);
+}
@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSpawnDirector.generated.h"
+
+/**
+ *  Spawn director tuning ([/Script/ThirdPersonCameraMan.CombatSpawnDirectorSettings] in DefaultGame.ini)
+ */
+UCLASS(config=Game, defaultconfig)
+class UCombatSpawnDirectorSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** If false, every request is served the frame it's due, as the spawners' own timers used to */
+	UPROPERTY(config, EditAnywhere, Category="Budget")
+	bool bEnabled = true;
+
+	/** Spawns served per frame at most */
+	UPROPERTY(config, EditAnywhere, Category="Budget", meta = (ClampMin = 1))
+	int32 MaxSpawnsPerFrame = 2;
+
+	/** No further spawns are served in a frame once they've taken this long. The first due spawn is always served */
+	UPROPERTY(config, EditAnywhere, Category="Budget", meta = (ClampMin = 0, Units = "ms"))
+	float SpawnBudgetMs = 2.0f;
+
+	/** Each second a request waits counts as being this much closer to a player, so far spawners aren't starved */
+	UPROPERTY(config, EditAnywhere, Category="Priority", meta = (ClampMin = 0, Units = "cm"))
+	float AgingDistancePerSecond = 1000.0f;
+
+	/** Wait times kept for the percentile figures */
+	UPROPERTY(config, EditAnywhere, Category="Stats", meta = (ClampMin = 1))
+	int32 WaitSamples = 256;
+};
+
+/**
+ *  Serves enemy spawn requests from every spawner under a per-frame count and time budget,
+ *  so spawners coming due in the same frame don't stack their spawns into one hitch.
+ *  Due requests are served closest to a player pawn first, with waiting time ageing them up the queue.
+ *  combat.SpawnDirector prints queue depth, wait times and spawn costs.
+ */
+UCLASS()
+class UCombatSpawnDirector : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the subsystem for the provided world context */
+	static UCombatSpawnDirector* Get(const UObject* WorldContext);
+
+	/** Queues a spawn for the requester, due after the provided delay. Replaces any request it already has queued */
+	void RequestSpawn(AActor* Requester, float Delay, FSimpleDelegate Spawn);
+
+	/** Drops the requester's queued spawn */
+	void CancelRequest(AActor* Requester);
+
+	/** Number of queued requests that are due and still waiting */
+	int32 GetQueueDepth() const { return LastQueueDepth; }
+
+	/** Logs queue and timing figures */
+	void PrintStats() const;
+
+	/** Serves due requests within the budget */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Only game worlds spawn enemies */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+	}
+
+private:
+
+	/** A queued spawn */
+	struct FSpawnRequest
+	{
+		TWeakObjectPtr<AActor> Requester;
+		FSimpleDelegate Spawn;
+
+		/** World time the request becomes due */
+		double DueTime = 0.0;
+	};
+
+	/** Records how long a served request waited past its due time */
+	void AddWaitSample(float WaitMs);
+
+	/** Queued requests, due or not */
+	TArray<FSpawnRequest> Requests;
+
+	/** Ring buffer of recent wait times */
+	TArray<float> WaitTimesMs;
+	int32 NextWaitSample = 0;
+
+	/** Queue and spawn figures */
+	int32 LastQueueDepth = 0;
+	int32 MaxQueueDepth = 0;
+	int32 NumServed = 0;
+	int32 NumDeferred = 0;
+	float MaxWaitMs = 0.0f;
+	double LastFrameSpawnMs = 0.0;
+	double MaxFrameSpawnMs = 0.0;
+};
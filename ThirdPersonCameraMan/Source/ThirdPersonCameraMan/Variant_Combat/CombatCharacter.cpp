@@ -3,23 +3,28 @@
 
 #include "CombatCharacter.h"
 #include "Components/CapsuleComponent.h"
-#include "Components/WidgetComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Camera/CameraComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputComponent.h"
-#include "CombatLifeBar.h"
+#include "CombatHealthBarSubsystem.h"
+#include "CombatRagdollManager.h"
+#include "CombatSignificanceSubsystem.h"
 #include "Engine/DamageEvents.h"
 #include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
 #include "CombatPlayerController.h"
+#include "CombatMeleeQuerySubsystem.h"
 
 ACombatCharacter::ACombatCharacter()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	// let the significance pass throttle animation through update rate optimizations
+	GetMesh()->bEnableUpdateRateOptimizations = true;
+
 	// bind the attack montage ended delegate
 	OnAttackMontageEnded.BindUObject(this, &ACombatCharacter::AttackMontageEnded);
 
@@ -43,10 +48,6 @@ ACombatCharacter::ACombatCharacter()
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	FollowCamera->bUsePawnControlRotation = false;
 
-	// create the life bar widget component
-	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
-	LifeBar->SetupAttachment(RootComponent);
-
 	// set the player tag
 	Tags.Add(FName("Player"));
 }
@@ -170,7 +171,10 @@ void ACombatCharacter::ResetHP()
 	CurrentHP = MaxHP;
 
 	// update the life bar
-	LifeBarWidget->SetLifePercentage(1.0f);
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->SetPercent(this, 1.0f);
+	}
 }
 
 void ACombatCharacter::ComboAttack()
@@ -181,6 +185,9 @@ void ACombatCharacter::ComboAttack()
 	// reset the combo count
 	ComboCount = 0;
 
+	// start a new swing for the weapon trail
+	WeaponTrail.BeginSwing(WeaponTrailSweepBudget);
+
 	// play the attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
@@ -204,6 +211,9 @@ void ACombatCharacter::ChargedAttack()
 	// reset the charge loop flag
 	bHasLoopedChargedAttack = false;
 
+	// start a new swing for the weapon trail
+	WeaponTrail.BeginSwing(WeaponTrailSweepBudget);
+
 	// play the charged attack montage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
@@ -243,48 +253,48 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupt
 void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 {
 	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	FCombatMeleeQuery Query;
+	Query.Attacker = this;
 
 	// start at the provided socket location, sweep forward
-	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
-	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
-
-	// check for pawn and world dynamic collision object types
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	Query.Start = GetMesh()->GetSocketLocation(DamageSourceBone);
+	Query.End = Query.Start + (GetActorForwardVector() * MeleeTraceDistance);
 
 	// use a sphere shape for the sweep
-	FCollisionShape CollisionShape;
-	CollisionShape.SetSphere(MeleeTraceRadius);
+	Query.Radius = MeleeTraceRadius;
+
+	// check for pawn and world dynamic collision object types
+	Query.ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	Query.ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
 
-	// ignore self
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	Query.Damage = MeleeDamage;
+	Query.KnockbackImpulse = MeleeKnockbackImpulse;
+	Query.LaunchImpulse = MeleeLaunchImpulse;
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	// hand the sweep to the melee query subsystem; hits are dispatched once it resolves
+	if (UCombatMeleeQuerySubsystem* MeleeQueries = UCombatMeleeQuerySubsystem::Get(this))
 	{
-		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		if (MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail)
 		{
-			// check if we've hit a damageable actor
-			ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
+			// follow the configured trail bone, or this notify's bone if there's none
+			TrailBoneName = WeaponTrailBone.IsNone() ? DamageSourceBone : WeaponTrailBone;
 
-			if (Damageable)
-			{
-				// knock upwards and away from the impact normal
-				const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
-
-				// pass the damage event to the actor
-				Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
-
-				// call the BP handler to play effects, etc.
-				DealtDamage(MeleeDamage, CurrentHit.ImpactPoint);
-			}
+			// sweep the path the bone took since the last trace instead
+			WeaponTrail.QueueSweeps(MeleeQueries, Query, GetMesh()->GetSocketLocation(TrailBoneName), GetWorld()->GetTimeSeconds(), WeaponTrailWindow, WeaponTrailMinStep);
+		}
+		else
+		{
+			MeleeQueries->QueueAttack(Query);
 		}
 	}
 }
 
+void ACombatCharacter::AttackHitDealt(float Damage, const FVector& ImpactPoint)
+{
+	// call the BP handler to play effects, etc.
+	DealtDamage(Damage, ImpactPoint);
+}
+
 void ACombatCharacter::CheckCombo()
 {
 	// are we playing a non-charge attack animation?
@@ -307,6 +317,9 @@ void ACombatCharacter::CheckCombo()
 				{
 					AnimInstance->Montage_JumpToSection(ComboSectionNames[ComboCount], ComboAttackMontage);
 				}
+
+				// each combo stage is a swing of its own
+				WeaponTrail.BeginSwing(WeaponTrailSweepBudget);
 			}
 		}
 	}
@@ -322,6 +335,9 @@ void ACombatCharacter::CheckChargedAttack()
 	{
 		AnimInstance->Montage_JumpToSection(bIsChargingAttack ? ChargeLoopSection : ChargeAttackSection, ChargedAttackMontage);
 	}
+
+	// the loop or the release is a new swing
+	WeaponTrail.BeginSwing(WeaponTrailSweepBudget);
 }
 
 void ACombatCharacter::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
@@ -357,8 +373,17 @@ void ACombatCharacter::HandleDeath()
 	// enable full ragdoll physics
 	GetMesh()->SetSimulatePhysics(true);
 
+	// count the ragdoll against the physics budget
+	if (UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this))
+	{
+		Ragdolls->AddRagdoll(GetMesh(), ECombatRagdollKind::Death);
+	}
+
 	// hide the life bar
-	LifeBar->SetHiddenInGame(true);
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->SetShown(this, false);
+	}
 
 	// pull back the camera
 	GetCameraBoom()->TargetArmLength = DeathCameraDistance;
@@ -398,11 +423,18 @@ float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dama
 	else
 	{
 		// update the life bar
-		LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+		if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+		{
+			HealthBars->SetPercent(this, CurrentHP / MaxHP);
+		}
 
-		// enable partial ragdoll physics, but keep the pelvis vertical
-		GetMesh()->SetPhysicsBlendWeight(0.5f);
-		GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
+		// enable partial ragdoll physics, but keep the pelvis vertical, if the physics budget allows it
+		UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this);
+		if (!Ragdolls || Ragdolls->AddRagdoll(GetMesh(), ECombatRagdollKind::HitReaction))
+		{
+			GetMesh()->SetPhysicsBlendWeight(0.5f);
+			GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
+		}
 	}
 
 	// return the received damage amount
@@ -418,6 +450,11 @@ void ACombatCharacter::Landed(const FHitResult& Hit)
 	{
 		// disable ragdoll physics
 		GetMesh()->SetPhysicsBlendWeight(0.0f);
+
+		if (UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this))
+		{
+			Ragdolls->RemoveRagdoll(GetMesh());
+		}
 	}
 }
 
@@ -425,29 +462,63 @@ void ACombatCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// get the life bar from the widget component
-	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-	check(LifeBarWidget);
-
 	// initialize the camera
 	GetCameraBoom()->TargetArmLength = DefaultCameraDistance;
 
 	// save the relative transform for the mesh so we can reset the ragdoll later
 	MeshStartingTransform = GetMesh()->GetRelativeTransform();
 
-	// set the life bar color
-	LifeBarWidget->SetBarColor(LifeBarColor);
+	// add a life bar in our color to the batched health bar renderer
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->AddBar(this, LifeBarHeight, LifeBarColor);
+	}
+
+	// let the significance pass throttle us when nobody is looking
+	if (UCombatSignificanceSubsystem* Significance = UCombatSignificanceSubsystem::Get(this))
+	{
+		Significance->Register(this);
+	}
 
 	// reset HP to maximum
 	ResetHP();
 }
 
+void ACombatCharacter::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// follow the damage bone while attacking so the next attack trace can sweep its path
+	if (bIsAttacking && MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail && !TrailBoneName.IsNone())
+	{
+		WeaponTrail.AddSample(GetMesh()->GetSocketLocation(TrailBoneName), GetWorld()->GetTimeSeconds(), WeaponTrailWindow);
+	}
+}
+
 void ACombatCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	// stop rating our significance
+	if (UCombatSignificanceSubsystem* Significance = UCombatSignificanceSubsystem::Get(this))
+	{
+		Significance->Unregister(this);
+	}
+
+	// stop counting the ragdoll
+	if (UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(this))
+	{
+		Ragdolls->RemoveRagdoll(GetMesh());
+	}
+
 	// clear the respawn timer
 	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+
+	// remove the life bar
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this))
+	{
+		HealthBars->RemoveBar(this);
+	}
 }
 
 void ACombatCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
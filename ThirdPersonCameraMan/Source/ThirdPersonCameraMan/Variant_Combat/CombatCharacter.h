@@ -6,6 +6,7 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "CombatWeaponTrail.h"
 #include "Animation/AnimInstance.h"
 #include "CombatCharacter.generated.h"
 
@@ -13,8 +14,6 @@ class USpringArmComponent;
 class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
-class UCombatLifeBar;
-class UWidgetComponent;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
 
@@ -38,10 +37,6 @@ class ACombatCharacter : public ACharacter, public ICombatAttacker, public IComb
 	/** Follow camera */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
-
-	/** Life bar widget component */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
-	UWidgetComponent* LifeBar;
 	
 protected:
 
@@ -77,18 +72,18 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category="Damage")
 	float CurrentHP = 0.0f;
 
-	/** Life bar widget fill color */
+	/** Life bar fill color */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FLinearColor LifeBarColor;
 
+	/** Height of the life bar above the character's origin */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
+	float LifeBarHeight = 120.0f;
+
 	/** Name of the pelvis bone, for damage ragdoll physics */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
 
-	/** Pointer to the life bar widget */
-	UPROPERTY(EditAnywhere, Category="Damage")
-	TObjectPtr<UCombatLifeBar> LifeBarWidget;
-
 	/** Max amount of time that may elapse for a non-combo attack input to not be considered stale */
 	UPROPERTY(EditAnywhere, Category="Melee Attack", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
 	float AttackInputCacheTimeTolerance = 1.0f;
@@ -107,6 +102,32 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 200, Units = "cm"))
 	float MeleeTraceRadius = 75.0f;
 
+	/** Shape of the melee attack collision check */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace")
+	ECombatMeleeTraceMode MeleeTraceMode = ECombatMeleeTraceMode::Forward;
+
+	/** Bone the weapon trail follows. If none, the bone of the last attack trace notify is followed */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (EditCondition = "MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail"))
+	FName WeaponTrailBone;
+
+	/** Only this much of the bone's path before an attack trace is swept, so the attack windup isn't */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 1, Units = "s", EditCondition = "MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail"))
+	float WeaponTrailWindow = 0.2f;
+
+	/** Steps along the bone's path shorter than this are merged into one sweep */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 0, ClampMax = 100, Units = "cm", EditCondition = "MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail"))
+	float WeaponTrailMinStep = 10.0f;
+
+	/** Maximum number of sweeps a single swing may run, however many attack traces it has */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Trace", meta = (ClampMin = 1, ClampMax = 32, EditCondition = "MeleeTraceMode == ECombatMeleeTraceMode::WeaponTrail"))
+	int32 WeaponTrailSweepBudget = 8;
+
+	/** Records the damage bone's path and the actors hit during the current swing */
+	FCombatWeaponTrail WeaponTrail;
+
+	/** Bone the weapon trail is currently following */
+	FName TrailBoneName;
+
 	/** Amount of damage a melee attack will deal */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 100))
 	float MeleeDamage = 1.0f;
@@ -249,6 +270,9 @@ public:
 	/** Performs the charged attack hold check */
 	virtual void CheckChargedAttack() override;
 
+	/** Plays damage dealt effects for a resolved attack hit */
+	virtual void AttackHitDealt(float Damage, const FVector& ImpactPoint) override;
+
 	// ~end CombatAttacker interface
 
 	// ~begin CombatDamageable interface
@@ -290,6 +314,9 @@ protected:
 	/** Initialization */
 	virtual void BeginPlay() override;
 
+	/** Follows the damage bone for weapon trail traces */
+	virtual void Tick(float DeltaSeconds) override;
+
 	/** Cleanup */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
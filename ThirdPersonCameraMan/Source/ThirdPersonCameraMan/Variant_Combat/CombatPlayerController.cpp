@@ -11,6 +11,7 @@
 #include "Engine/World.h"
 #include "Blueprint/UserWidget.h"
 #include "ThirdPersonCameraMan.h"
+#include "CombatHealthBarOverlay.h"
 #include "Widgets/Input/SVirtualJoystick.h"
 
 void ACombatPlayerController::BeginPlay()
@@ -35,6 +36,18 @@ void ACombatPlayerController::BeginPlay()
 		}
 
 	}
+
+	// life bars are drawn by one overlay per local player
+	if (IsLocalPlayerController())
+	{
+		HealthBarOverlay = CreateWidget<UCombatHealthBarOverlay>(this, HealthBarOverlayClass ? HealthBarOverlayClass.Get() : UCombatHealthBarOverlay::StaticClass());
+
+		if (HealthBarOverlay)
+		{
+			// keep it under the rest of the player's UI
+			HealthBarOverlay->AddToPlayerScreen(-1);
+		}
+	}
 }
 
 void ACombatPlayerController::SetupInputComponent()
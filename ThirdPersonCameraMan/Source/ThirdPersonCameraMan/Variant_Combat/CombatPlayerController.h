@@ -8,6 +8,7 @@
 
 class UInputMappingContext;
 class ACombatCharacter;
+class UCombatHealthBarOverlay;
 
 /**
  *  Simple Player Controller for a third person combat game
@@ -36,6 +37,14 @@ protected:
 	/** Pointer to the mobile controls widget */
 	TObjectPtr<UUserWidget> MobileControlsWidget;
 
+	/** Overlay that draws every visible life bar */
+	UPROPERTY(EditAnywhere, Category="UI")
+	TSubclassOf<UCombatHealthBarOverlay> HealthBarOverlayClass;
+
+	/** Pointer to the life bar overlay */
+	UPROPERTY()
+	TObjectPtr<UCombatHealthBarOverlay> HealthBarOverlay;
+
 	/** Character class to respawn when the possessed pawn is destroyed */
 	UPROPERTY(EditAnywhere, Category="Respawn")
 	TSubclassOf<ACombatCharacter> CharacterClass;
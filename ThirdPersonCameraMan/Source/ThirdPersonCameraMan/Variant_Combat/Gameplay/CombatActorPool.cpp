@@ -0,0 +1,316 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatActorPool.h"
+#include "CombatPoolable.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatPool, Log, All);
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatPoolCommand(
+	TEXT("combat.Pool"),
+	TEXT("Print actor pool figures. Args: [empty]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UCombatActorPool* Pool = UCombatActorPool::Get(World))
+		{
+			if (Args.Num() > 0 && Args[0] == TEXT("empty"))
+			{
+				Pool->Empty();
+			}
+			Pool->PrintStats();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatPoolBenchCommand(
+	TEXT("combat.PoolBench"),
+	TEXT("Spawn and GC cost of waves with and without the pool. Args: class=<class path> [count=N] [waves=N]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatActorPool* Pool = UCombatActorPool::Get(World);
+		if (!Pool)
+		{
+			return;
+		}
+
+		FString ClassPath;
+		int32 Count = 20;
+		int32 Waves = 5;
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("class="), ClassPath);
+			FParse::Value(*Arg, TEXT("count="), Count);
+			FParse::Value(*Arg, TEXT("waves="), Waves);
+		}
+
+		const TSubclassOf<AActor> ActorClass = TSoftClassPtr<AActor>(FSoftObjectPath(ClassPath)).LoadSynchronous();
+		if (!ActorClass || !ActorClass->ImplementsInterface(UCombatPoolable::StaticClass()))
+		{
+			UE_LOG(LogCombatPool, Error, TEXT("combat.PoolBench needs class=<path to a CombatPoolable actor class>"));
+			return;
+		}
+
+		Count = FMath::Max(1, Count);
+		Waves = FMath::Max(1, Waves);
+
+		// each wave spawns Count actors, then kills them all; a full GC follows every wave
+		auto RunWaves = [&](bool bPooled, double& OutMaxSpawnMs, double& OutMeanSpawnMs, double& OutMeanGCMs)
+		{
+			OutMaxSpawnMs = OutMeanSpawnMs = OutMeanGCMs = 0.0;
+			const FVector Origin = FVector(0.0f, 0.0f, 10000.0f);
+
+			for (int32 Wave = 0; Wave < Waves; ++Wave)
+			{
+				TArray<AActor*> Spawned;
+				for (int32 Index = 0; Index < Count; ++Index)
+				{
+					const FTransform Transform(Origin + FVector(Index * 200.0f, Wave * 200.0f, 0.0f));
+					const double Start = FPlatformTime::Seconds();
+
+					AActor* Actor = nullptr;
+					if (bPooled)
+					{
+						Actor = Pool->Acquire(ActorClass, Transform);
+					}
+					else
+					{
+						FActorSpawnParameters SpawnParams;
+						SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+						Actor = World->SpawnActor<AActor>(ActorClass, Transform, SpawnParams);
+					}
+
+					const double SpawnMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+					OutMaxSpawnMs = FMath::Max(OutMaxSpawnMs, SpawnMs);
+					OutMeanSpawnMs += SpawnMs;
+					Spawned.Add(Actor);
+				}
+
+				for (AActor* Actor : Spawned)
+				{
+					if (!Actor)
+					{
+						continue;
+					}
+
+					if (bPooled)
+					{
+						Pool->Release(Actor);
+					}
+					else
+					{
+						Actor->Destroy();
+					}
+				}
+
+				const double GCStart = FPlatformTime::Seconds();
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+				OutMeanGCMs += (FPlatformTime::Seconds() - GCStart) * 1000.0;
+			}
+
+			OutMeanSpawnMs /= Count * Waves;
+			OutMeanGCMs /= Waves;
+		};
+
+		double MaxSpawnMs, MeanSpawnMs, MeanGCMs;
+		RunWaves(false, MaxSpawnMs, MeanSpawnMs, MeanGCMs);
+		UE_LOG(LogCombatPool, Display, TEXT("Pool bench %s, %d waves of %d: without pool  spawn mean %.3f ms max %.3f ms, GC %.2f ms/wave"),
+			*ActorClass->GetName(), Waves, Count, MeanSpawnMs, MaxSpawnMs, MeanGCMs);
+
+		// the pooled run starts warm, as it would after the world start pre-warm
+		Pool->PrewarmNow(ActorClass, Count);
+		RunWaves(true, MaxSpawnMs, MeanSpawnMs, MeanGCMs);
+		UE_LOG(LogCombatPool, Display, TEXT("Pool bench %s, %d waves of %d: with pool     spawn mean %.3f ms max %.3f ms, GC %.2f ms/wave"),
+			*ActorClass->GetName(), Waves, Count, MeanSpawnMs, MaxSpawnMs, MeanGCMs);
+	}));
+
+UCombatActorPool* UCombatActorPool::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UCombatActorPool>() : nullptr;
+}
+
+TStatId UCombatActorPool::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatActorPool, STATGROUP_Tickables);
+}
+
+void UCombatActorPool::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// parked actors are server state, like the actors they stand in for
+	if (InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	const UCombatActorPoolSettings* Settings = GetDefault<UCombatActorPoolSettings>();
+	if (!Settings->bEnabled)
+	{
+		return;
+	}
+
+	for (const TPair<TSoftClassPtr<AActor>, int32>& Entry : Settings->Prewarm)
+	{
+		Prewarm(Entry.Key.LoadSynchronous(), Entry.Value);
+	}
+}
+
+void UCombatActorPool::Tick(float DeltaTime)
+{
+	int32 Budget = GetDefault<UCombatActorPoolSettings>()->PrewarmPerFrame;
+	while (Budget > 0 && PrewarmQueue.Num() > 0)
+	{
+		TPair<TSubclassOf<AActor>, int32>& Entry = PrewarmQueue[0];
+		const int32 Batch = FMath::Min(Budget, Entry.Value);
+		PrewarmNow(Entry.Key, Batch);
+
+		Budget -= Batch;
+		Entry.Value -= Batch;
+		if (Entry.Value <= 0)
+		{
+			PrewarmQueue.RemoveAt(0);
+		}
+	}
+}
+
+AActor* UCombatActorPool::SpawnFresh(TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform) const
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	return GetWorld()->SpawnActor<AActor>(ActorClass, SpawnTransform, SpawnParams);
+}
+
+AActor* UCombatActorPool::Acquire(TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform)
+{
+	if (!ActorClass)
+	{
+		return nullptr;
+	}
+
+	const double Start = FPlatformTime::Seconds();
+
+	// reuse the most recently parked instance that's still around
+	if (TArray<TWeakObjectPtr<AActor>>* Free = Parked.Find(ActorClass.Get()))
+	{
+		while (Free->Num() > 0)
+		{
+			AActor* Actor = Free->Pop(EAllowShrinking::No).Get();
+			if (IsValid(Actor))
+			{
+				CastChecked<ICombatPoolable>(Actor)->OnAcquiredFromPool(SpawnTransform);
+
+				++NumReused;
+				MaxReuseMs = FMath::Max(MaxReuseMs, (FPlatformTime::Seconds() - Start) * 1000.0);
+				return Actor;
+			}
+		}
+	}
+
+	AActor* Actor = SpawnFresh(ActorClass, SpawnTransform);
+
+	++NumSpawned;
+	MaxSpawnMs = FMath::Max(MaxSpawnMs, (FPlatformTime::Seconds() - Start) * 1000.0);
+	return Actor;
+}
+
+bool UCombatActorPool::Release(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return false;
+	}
+
+	const UCombatActorPoolSettings* Settings = GetDefault<UCombatActorPoolSettings>();
+	const TArray<TWeakObjectPtr<AActor>>* Free = Parked.Find(Actor->GetClass());
+
+	// already parked: releasing again must not reset it twice or hand it out to two owners
+	if (Free && Free->Contains(Actor))
+	{
+		return true;
+	}
+
+	const bool bHasRoom = !Free || Free->Num() < Settings->MaxPooledPerClass;
+
+	if (!Settings->bEnabled || !bHasRoom || !Actor->Implements<UCombatPoolable>())
+	{
+		Actor->Destroy();
+		++NumDestroyed;
+		return false;
+	}
+
+	Park(Actor);
+	++NumParked;
+	return true;
+}
+
+void UCombatActorPool::Park(AActor* Actor)
+{
+	CastChecked<ICombatPoolable>(Actor)->OnReturnedToPool();
+	Parked.FindOrAdd(Actor->GetClass()).Add(Actor);
+}
+
+void UCombatActorPool::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+	if (ActorClass && Count > 0 && ActorClass->ImplementsInterface(UCombatPoolable::StaticClass()))
+	{
+		PrewarmQueue.Emplace(ActorClass, Count);
+	}
+}
+
+void UCombatActorPool::PrewarmNow(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+	if (!ActorClass || !ActorClass->ImplementsInterface(UCombatPoolable::StaticClass()))
+	{
+		return;
+	}
+
+	const int32 MaxPooled = GetDefault<UCombatActorPoolSettings>()->MaxPooledPerClass;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const TArray<TWeakObjectPtr<AActor>>* Free = Parked.Find(ActorClass.Get());
+		if (Free && Free->Num() >= MaxPooled)
+		{
+			return;
+		}
+
+		// spawned in play, then parked straight away
+		if (AActor* Actor = SpawnFresh(ActorClass, FTransform::Identity))
+		{
+			Park(Actor);
+		}
+	}
+}
+
+void UCombatActorPool::Empty()
+{
+	for (TPair<TObjectKey<UClass>, TArray<TWeakObjectPtr<AActor>>>& Entry : Parked)
+	{
+		for (const TWeakObjectPtr<AActor>& Actor : Entry.Value)
+		{
+			if (Actor.IsValid())
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+
+	Parked.Reset();
+	PrewarmQueue.Reset();
+}
+
+void UCombatActorPool::PrintStats() const
+{
+	for (const TPair<TObjectKey<UClass>, TArray<TWeakObjectPtr<AActor>>>& Entry : Parked)
+	{
+		const UClass* ActorClass = Entry.Key.ResolveObjectPtr();
+		UE_LOG(LogCombatPool, Display, TEXT("  %s: %d parked"), ActorClass ? *ActorClass->GetName() : TEXT("?"), Entry.Value.Num());
+	}
+
+	const int32 NumAcquired = NumReused + NumSpawned;
+	UE_LOG(LogCombatPool, Display, TEXT("Pool: %d acquires, %.0f%% reused (max %.3f ms), %d spawned (max %.3f ms); %d parked, %d destroyed on release"),
+		NumAcquired, NumAcquired > 0 ? 100.0 * NumReused / NumAcquired : 0.0, MaxReuseMs, NumSpawned, MaxSpawnMs, NumParked, NumDestroyed);
+}
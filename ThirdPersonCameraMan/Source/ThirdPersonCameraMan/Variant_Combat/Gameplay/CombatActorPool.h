@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatActorPool.generated.h"
+
+/**
+ *  Actor pool tuning ([/Script/ThirdPersonCameraMan.CombatActorPoolSettings] in DefaultGame.ini)
+ */
+UCLASS(config=Game, defaultconfig)
+class UCombatActorPoolSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** If false, every acquire spawns and every release destroys */
+	UPROPERTY(config, EditAnywhere, Category="Pool")
+	bool bEnabled = true;
+
+	/** Parked actors kept per class; releases beyond this destroy the actor */
+	UPROPERTY(config, EditAnywhere, Category="Pool", meta = (ClampMin = 0))
+	int32 MaxPooledPerClass = 32;
+
+	/** Instances spawned and parked per class when the world starts */
+	UPROPERTY(config, EditAnywhere, Category="Pool")
+	TMap<TSoftClassPtr<AActor>, int32> Prewarm;
+
+	/** Pre-warm spawns per frame, so pre-warming doesn't become the hitch it's meant to prevent */
+	UPROPERTY(config, EditAnywhere, Category="Pool", meta = (ClampMin = 1))
+	int32 PrewarmPerFrame = 2;
+};
+
+/**
+ *  Keeps dead ICombatPoolable actors parked out of play and hands them back out instead of spawning new ones,
+ *  so waves don't hitch on SpawnActor and dead enemies don't feed the garbage collector.
+ *  Classes listed in the settings are pre-warmed a few instances per frame at world start.
+ *  combat.Pool prints hit rates and acquire times; combat.PoolBench compares spawn and GC cost with and without it.
+ */
+UCLASS()
+class UCombatActorPool : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the subsystem for the provided world context */
+	static UCombatActorPool* Get(const UObject* WorldContext);
+
+	/** Reuses a parked actor of the class or spawns a new one */
+	AActor* Acquire(TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform);
+
+	/** Typed acquire */
+	template<class T>
+	T* Acquire(TSubclassOf<T> ActorClass, const FTransform& SpawnTransform)
+	{
+		return Cast<T>(Acquire(TSubclassOf<AActor>(ActorClass.Get()), SpawnTransform));
+	}
+
+	/** Parks the actor if it's poolable and there's room, destroys it otherwise. Returns true if it was parked */
+	bool Release(AActor* Actor);
+
+	/** Queues instances of the class to be spawned and parked over the next frames */
+	void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/** Spawns and parks instances of the class right away */
+	void PrewarmNow(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/** Destroys every parked actor */
+	void Empty();
+
+	/** Logs pool figures */
+	void PrintStats() const;
+
+	/** Queues the configured pre-warm */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Serves the pre-warm queue */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Only game worlds spawn combat actors */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+	}
+
+private:
+
+	/** Spawns an actor of the class, bypassing the pool */
+	AActor* SpawnFresh(TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform) const;
+
+	/** Parks an actor without any checks */
+	void Park(AActor* Actor);
+
+	/** Parked actors per class */
+	TMap<TObjectKey<UClass>, TArray<TWeakObjectPtr<AActor>>> Parked;
+
+	/** Pending pre-warm spawns per class */
+	TArray<TPair<TSubclassOf<AActor>, int32>> PrewarmQueue;
+
+	/** Acquire figures */
+	int32 NumReused = 0;
+	int32 NumSpawned = 0;
+	int32 NumParked = 0;
+	int32 NumDestroyed = 0;
+	double MaxReuseMs = 0.0;
+	double MaxSpawnMs = 0.0;
+};
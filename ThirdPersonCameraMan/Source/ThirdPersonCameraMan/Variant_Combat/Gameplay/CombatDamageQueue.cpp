@@ -0,0 +1,210 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDamageQueue.h"
+#include "CombatDamageable.h"
+#include "CombatDamageStream.h"
+#include "CombatMeleeQuerySubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatDamage, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Combat damage resolve"), STAT_CombatDamageResolve, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat damage hits"), STAT_CombatDamageHits, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat damage events"), STAT_CombatDamageEvents, STATGROUP_Game);
+
+static TAutoConsoleVariable<bool> CVarCombatDamageQueue(
+	TEXT("combat.DamageQueue"),
+	true,
+	TEXT("If true, damage is queued and applied once per frame with hits coalesced per target and source; if false, it's applied as it's dealt"),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatDamageStatsCommand(
+	TEXT("combat.DamageStats"),
+	TEXT("Print damage queue figures: hits, coalesced events, streamed events and resolve time"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (const UCombatDamageQueue* DamageQueue = UCombatDamageQueue::Get(World))
+		{
+			DamageQueue->PrintStats();
+		}
+	}));
+
+UCombatDamageQueue* UCombatDamageQueue::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UCombatDamageQueue>() : nullptr;
+}
+
+TStatId UCombatDamageQueue::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatDamageQueue, STATGROUP_Tickables);
+}
+
+void UCombatDamageQueue::Initialize(FSubsystemCollectionBase& Collection)
+{
+	// tickables tick in the order they're registered: initializing the melee queries first puts their
+	// end of frame flush ahead of this pass, so a swing's damage is applied the frame it's swept
+	Collection.InitializeDependency<UCombatMeleeQuerySubsystem>();
+
+	Super::Initialize(Collection);
+}
+
+void UCombatDamageQueue::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// only a server with clients has anyone to stream to
+	if (InWorld.GetNetMode() == NM_DedicatedServer || InWorld.GetNetMode() == NM_ListenServer)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		Stream = InWorld.SpawnActor<ACombatDamageStream>(SpawnParams);
+	}
+}
+
+void UCombatDamageQueue::Enqueue(AActor* Target, AActor* Source, float Damage, const FVector& Location, const FVector& Impulse)
+{
+	if (!Target || !Target->Implements<UCombatDamageable>())
+	{
+		return;
+	}
+
+	// damage is server authoritative; clients only hear about it through the stream
+	if (!Target->HasAuthority())
+	{
+		return;
+	}
+
+	// unqueued, each hit is an event of its own
+	if (!CVarCombatDamageQueue.GetValueOnGameThread())
+	{
+		FCombatDamageEvent Event;
+		Event.Target = Target;
+		Event.Source = Source;
+		Event.Damage = Damage;
+		Event.Location = Location;
+		Event.Impulse = Impulse;
+		Event.NumHits = 1;
+		ApplyEvent(Event);
+		OnDamageResolved.Broadcast(Event);
+		return;
+	}
+
+	Queued.Add({ Target, Source, Damage, Location, Impulse });
+}
+
+void UCombatDamageQueue::ApplyEvent(const FCombatDamageEvent& Event)
+{
+	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(Event.Target.Get()))
+	{
+		Damageable->ApplyDamage(Event.Damage, Event.Source.Get(), Event.Location, Event.Impulse);
+	}
+}
+
+void UCombatDamageQueue::ReceiveStreamedEvents(TConstArrayView<FCombatDamageEvent> Events)
+{
+	for (const FCombatDamageEvent& Event : Events)
+	{
+		OnDamageResolved.Broadcast(Event);
+	}
+}
+
+void UCombatDamageQueue::Tick(float DeltaTime)
+{
+	if (Queued.Num() == 0)
+	{
+		LastNumHits = LastNumEvents = 0;
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CombatDamageResolve);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// take the queue, so damage dealt while applying (e.g. from a death) lands in the next pass
+	Swap(Queued, Resolving);
+	Queued.Reset();
+	const TArray<FQueuedHit>& Hits = Resolving;
+
+	// coalesce every hit of a source on a target into one event, in the order the pairs first appeared
+	for (const FQueuedHit& Hit : Hits)
+	{
+		AActor* Target = Hit.Target.Get();
+		if (!Target)
+		{
+			continue;
+		}
+
+		AActor* Source = Hit.Source.Get();
+		const TPair<TObjectKey<AActor>, TObjectKey<AActor>> Key(Target, Source);
+
+		if (const int32* Existing = ResolvedIndices.Find(Key))
+		{
+			FCombatDamageEvent& Event = Resolved[*Existing];
+			Event.Damage += Hit.Damage;
+			Event.Impulse += Hit.Impulse;
+			Event.NumHits = static_cast<uint8>(FMath::Min<int32>(Event.NumHits + 1, MAX_uint8));
+			continue;
+		}
+
+		ResolvedIndices.Add(Key, Resolved.Num());
+
+		FCombatDamageEvent& Event = Resolved.AddDefaulted_GetRef();
+		Event.Target = Target;
+		Event.Source = Source;
+		Event.Damage = Hit.Damage;
+		Event.Location = Hit.Location;
+		Event.Impulse = Hit.Impulse;
+		Event.NumHits = 1;
+	}
+
+	// one pass over the targets
+	for (const FCombatDamageEvent& Event : Resolved)
+	{
+		ApplyEvent(Event);
+		OnDamageResolved.Broadcast(Event);
+	}
+
+	// stream what fits this frame's budget to the clients
+	if (ACombatDamageStream* DamageStream = Stream.Get())
+	{
+		const int32 NumStreamed = FMath::Min(Resolved.Num(), GetDefault<UCombatDamageQueueSettings>()->MaxStreamedEventsPerFrame);
+		if (NumStreamed > 0)
+		{
+			if (NumStreamed == Resolved.Num())
+			{
+				DamageStream->MulticastDamageEvents(Resolved);
+			}
+			else
+			{
+				DamageStream->MulticastDamageEvents(TArray<FCombatDamageEvent>(Resolved.GetData(), NumStreamed));
+			}
+			TotalStreamed += NumStreamed;
+		}
+	}
+
+	LastNumHits = Hits.Num();
+	LastNumEvents = Resolved.Num();
+	MaxNumHits = FMath::Max(MaxNumHits, LastNumHits);
+	TotalHits += LastNumHits;
+	TotalEvents += LastNumEvents;
+	LastResolveMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	MaxResolveMs = FMath::Max(MaxResolveMs, LastResolveMs);
+
+	INC_DWORD_STAT_BY(STAT_CombatDamageHits, LastNumHits);
+	INC_DWORD_STAT_BY(STAT_CombatDamageEvents, LastNumEvents);
+
+	// keep the allocations, not the actor pointers
+	Resolved.Reset();
+	ResolvedIndices.Reset();
+}
+
+void UCombatDamageQueue::PrintStats() const
+{
+	UE_LOG(LogCombatDamage, Display, TEXT("Damage queue: %s; last pass %d hits -> %d events in %.3f ms (max %d hits, %.3f ms)"),
+		CVarCombatDamageQueue.GetValueOnGameThread() ? TEXT("on") : TEXT("off"), LastNumHits, LastNumEvents, LastResolveMs, MaxNumHits, MaxResolveMs);
+	UE_LOG(LogCombatDamage, Display, TEXT("  total %lld hits -> %lld events (%.0f%% coalesced away), %lld streamed to clients"),
+		TotalHits, TotalEvents, TotalHits > 0 ? 100.0 * (TotalHits - TotalEvents) / TotalHits : 0.0, TotalStreamed);
+}
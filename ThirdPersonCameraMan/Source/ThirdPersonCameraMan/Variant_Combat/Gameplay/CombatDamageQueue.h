@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/NetSerialization.h"
+#include "UObject/ObjectKey.h"
+#include "CombatDamageQueue.generated.h"
+
+class ACombatDamageStream;
+
+/**
+ *  A resolved damage event, as applied on the server and streamed to clients.
+ *  Every hit of one source on one target within a frame is coalesced into a single event.
+ */
+USTRUCT(BlueprintType)
+struct FCombatDamageEvent
+{
+	GENERATED_BODY()
+
+	/** Actor that took the damage */
+	UPROPERTY(BlueprintReadOnly, Category="Damage")
+	TObjectPtr<AActor> Target = nullptr;
+
+	/** Actor that dealt it */
+	UPROPERTY(BlueprintReadOnly, Category="Damage")
+	TObjectPtr<AActor> Source = nullptr;
+
+	/** Total damage of the coalesced hits */
+	UPROPERTY(BlueprintReadOnly, Category="Damage")
+	float Damage = 0.0f;
+
+	/** Impact point of the first hit */
+	UPROPERTY(BlueprintReadOnly, Category="Damage")
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	/** Sum of the hits' impulses */
+	UPROPERTY(BlueprintReadOnly, Category="Damage")
+	FVector_NetQuantize10 Impulse = FVector::ZeroVector;
+
+	/** Number of hits coalesced into this event */
+	UPROPERTY(BlueprintReadOnly, Category="Damage")
+	uint8 NumHits = 0;
+};
+
+/** Called for every resolved damage event, on the server as it's applied and on clients as it arrives */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCombatDamageResolved, const FCombatDamageEvent&);
+
+/**
+ *  Damage queue tuning ([/Script/ThirdPersonCameraMan.CombatDamageQueueSettings] in DefaultGame.ini)
+ */
+UCLASS(config=Game, defaultconfig)
+class UCombatDamageQueueSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Resolved events sent to clients per frame at most; the rest are applied but not streamed */
+	UPROPERTY(config, EditAnywhere, Category="Replication", meta = (ClampMin = 0))
+	int32 MaxStreamedEventsPerFrame = 64;
+};
+
+/**
+ *  Collects damage from melee sweeps, hazards and anything else that deals it, and applies it once per frame
+ *  in a single pass: all hits of one source on one target are coalesced into one ICombatDamageable::ApplyDamage
+ *  call, so lava contacts and multi-hit swings cost one TakeDamage, one impulse and one BP event per target.
+ *  Damage enqueued after this frame's pass is applied in the next one. Only the server applies damage.
+ *  Resolved events are streamed to clients through an unreliable multicast on ACombatDamageStream.
+ */
+UCLASS()
+class UCombatDamageQueue : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the subsystem for the provided world context */
+	static UCombatDamageQueue* Get(const UObject* WorldContext);
+
+	/** Queues damage on an ICombatDamageable target, or applies it right away if the queue is disabled. Ignored unless the target has authority */
+	void Enqueue(AActor* Target, AActor* Source, float Damage, const FVector& Location, const FVector& Impulse);
+
+	/** Called for every resolved damage event */
+	FOnCombatDamageResolved OnDamageResolved;
+
+	/** Broadcasts events streamed from the server */
+	void ReceiveStreamedEvents(TConstArrayView<FCombatDamageEvent> Events);
+
+	/** Logs queue figures */
+	void PrintStats() const;
+
+	/** Makes sure the melee queries tick before this queue resolves */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Spawns the damage stream on the server */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Resolves the queued damage */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Only game worlds deal damage */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+	}
+
+private:
+
+	/** A queued hit */
+	struct FQueuedHit
+	{
+		TWeakObjectPtr<AActor> Target;
+		TWeakObjectPtr<AActor> Source;
+		float Damage;
+		FVector Location;
+		FVector Impulse;
+	};
+
+	/** Applies one resolved event to its target */
+	void ApplyEvent(const FCombatDamageEvent& Event);
+
+	/** Hits queued since the last pass */
+	TArray<FQueuedHit> Queued;
+
+	/** Hits being resolved in the current pass, swapped with Queued to keep both allocations */
+	TArray<FQueuedHit> Resolving;
+
+	/** Events resolved in the last pass, reused between frames */
+	TArray<FCombatDamageEvent> Resolved;
+
+	/** Index of each target / source pair in Resolved during a pass */
+	TMap<TPair<TObjectKey<AActor>, TObjectKey<AActor>>, int32> ResolvedIndices;
+
+	/** Server side replicated stream */
+	TWeakObjectPtr<ACombatDamageStream> Stream;
+
+	/** Queue figures */
+	int32 LastNumHits = 0;
+	int32 LastNumEvents = 0;
+	int32 MaxNumHits = 0;
+	int64 TotalHits = 0;
+	int64 TotalEvents = 0;
+	int64 TotalStreamed = 0;
+	double LastResolveMs = 0.0;
+	double MaxResolveMs = 0.0;
+};
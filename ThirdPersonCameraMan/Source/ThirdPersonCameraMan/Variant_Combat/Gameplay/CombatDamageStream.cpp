@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatDamageStream.h"
+
+ACombatDamageStream::ACombatDamageStream()
+{
+	// every client gets every event
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+}
+
+void ACombatDamageStream::MulticastDamageEvents_Implementation(const TArray<FCombatDamageEvent>& Events)
+{
+	// the server already broadcast these as it applied them
+	if (HasAuthority())
+	{
+		return;
+	}
+
+	if (UCombatDamageQueue* DamageQueue = UCombatDamageQueue::Get(this))
+	{
+		DamageQueue->ReceiveStreamedEvents(Events);
+	}
+}
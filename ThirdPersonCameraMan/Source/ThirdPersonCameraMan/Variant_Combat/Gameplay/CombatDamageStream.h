@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "CombatDamageQueue.h"
+#include "CombatDamageStream.generated.h"
+
+/**
+ *  Always relevant actor spawned by the damage queue on listen and dedicated servers.
+ *  Sends up to MaxStreamedEventsPerFrame of each frame's resolved damage events to clients in one unreliable multicast,
+ *  where the queue's OnDamageResolved broadcasts them. Events past the budget or lost in transit aren't resent,
+ *  so they're only fit for cosmetics; damage itself is only ever applied on the server.
+ */
+UCLASS(NotPlaceable, Transient)
+class ACombatDamageStream : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Constructor */
+	ACombatDamageStream();
+
+	/** Sends a frame's resolved events to clients */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastDamageEvents(const TArray<FCombatDamageEvent>& Events);
+};
@@ -5,6 +5,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
+#include "CombatActorPool.h"
 
 ACombatDamageableBox::ACombatDamageableBox()
 {
@@ -19,14 +20,63 @@ ACombatDamageableBox::ACombatDamageableBox()
 	// enable physics
 	Mesh->SetSimulatePhysics(true);
 
+	// let damage zones track the box
+	Mesh->SetGenerateOverlapEvents(true);
+
 	// disable navigation relevance so boxes don't affect NavMesh generation
 	Mesh->bNavigationRelevant = false;
 }
 
 void ACombatDamageableBox::RemoveFromLevel()
 {
-	// destroy this actor
-	Destroy();
+	// park this actor for reuse if there's a pool, destroy it otherwise
+	if (UCombatActorPool* Pool = UCombatActorPool::Get(this))
+	{
+		Pool->Release(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void ACombatDamageableBox::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// save the spawn state for pooled reuse
+	StartingHP = CurrentHP;
+	StartingObjectType = Mesh->GetCollisionObjectType();
+}
+
+void ACombatDamageableBox::OnAcquiredFromPool(const FTransform& SpawnTransform)
+{
+	// move to the spawn point without carrying over any velocity
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// restore the HP and the collision object type changed on death
+	CurrentHP = StartingHP;
+	Mesh->SetCollisionObjectType(StartingObjectType);
+
+	// bring the box back into play
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	Mesh->SetSimulatePhysics(true);
+}
+
+void ACombatDamageableBox::OnReturnedToPool()
+{
+	// clear the death timer
+	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	// stop the physics body where it is
+	Mesh->SetSimulatePhysics(false);
+	Mesh->SetPhysicsLinearVelocity(FVector::ZeroVector);
+	Mesh->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+
+	// take the box out of play
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
 }
 
 void ACombatDamageableBox::EndPlay(EEndPlayReason::Type EndPlayReason)
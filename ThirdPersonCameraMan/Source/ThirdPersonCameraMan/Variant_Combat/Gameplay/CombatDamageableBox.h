@@ -5,13 +5,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatDamageable.h"
+#include "CombatPoolable.h"
 #include "CombatDamageableBox.generated.h"
 
 /**
  *  A simple physics box that reacts to damage through the ICombatDamageable interface
  */
 UCLASS(abstract)
-class ACombatDamageableBox : public AActor, public ICombatDamageable
+class ACombatDamageableBox : public AActor, public ICombatDamageable, public ICombatPoolable
 {
 	GENERATED_BODY()
 	
@@ -37,6 +38,10 @@ protected:
 	/** Timer to defer destruction of this box after its HP are depleted */
 	FTimerHandle DeathTimer;
 
+	/** HP and collision object type at spawn, restored when the box is reused from the pool */
+	float StartingHP = 0.0f;
+	TEnumAsByte<ECollisionChannel> StartingObjectType = ECC_WorldDynamic;
+
 	/** Blueprint damage handler for effect playback */
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
 	void OnBoxDamaged(const FVector& DamageLocation, const FVector& DamageImpulse);
@@ -45,11 +50,14 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
 	void OnBoxDestroyed();
 
-	/** Timer callback to remove the box from the level after it dies */
+	/** Timer callback to remove the box from the level after it dies, returning it to the actor pool if there is one */
 	void RemoveFromLevel();
 
 public:
 
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
 	/** EndPlay cleanup */
 	void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
@@ -65,4 +73,14 @@ public:
 	virtual void ApplyHealing(float Healing, AActor* Healer) override;
 
 	// ~End CombatDamageable interface
+
+	// ~Begin CombatPoolable interface
+
+	/** Resets HP, collision and physics at the provided transform */
+	virtual void OnAcquiredFromPool(const FTransform& SpawnTransform) override;
+
+	/** Takes the box out of play while it waits in the pool */
+	virtual void OnReturnedToPool() override;
+
+	// ~End CombatPoolable interface
 };
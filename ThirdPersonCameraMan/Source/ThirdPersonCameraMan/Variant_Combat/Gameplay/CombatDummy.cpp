@@ -2,6 +2,7 @@
 
 
 #include "CombatDummy.h"
+#include "CombatSignificanceSubsystem.h"
 #include "Components/SceneComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
@@ -31,6 +32,28 @@ ACombatDummy::ACombatDummy()
 	PhysicsConstraint->SetConstrainedComponents(BasePlate, NAME_None, Dummy, NAME_None);
 }
 
+void ACombatDummy::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// tick (for BP effects) at a lower rate when nobody is looking
+	if (UCombatSignificanceSubsystem* Significance = UCombatSignificanceSubsystem::Get(this))
+	{
+		Significance->Register(this);
+	}
+}
+
+void ACombatDummy::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// stop rating our significance
+	if (UCombatSignificanceSubsystem* Significance = UCombatSignificanceSubsystem::Get(this))
+	{
+		Significance->Unregister(this);
+	}
+}
+
 void ACombatDummy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
 	// apply impulse to the dummy
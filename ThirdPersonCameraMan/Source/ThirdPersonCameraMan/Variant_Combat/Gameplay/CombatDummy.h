@@ -54,6 +54,12 @@ public:
 
 protected:
 
+	/** Registers with the significance pass */
+	virtual void BeginPlay() override;
+
+	/** Unregisters from the significance pass */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 	/** Blueprint handle to apply damage effects */
 	UFUNCTION(BlueprintImplementableEvent, Category="Combat", meta = (DisplayName = "On Dummy Damaged"))
 	void BP_OnDummyDamaged(const FVector& Location, const FVector& Direction);
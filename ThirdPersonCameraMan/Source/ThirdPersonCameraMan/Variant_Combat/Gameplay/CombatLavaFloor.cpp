@@ -3,7 +3,12 @@
 
 #include "CombatLavaFloor.h"
 #include "CombatDamageable.h"
+#include "CombatDamageQueue.h"
+#include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 ACombatLavaFloor::ACombatLavaFloor()
 {
@@ -12,16 +17,105 @@ ACombatLavaFloor::ACombatLavaFloor()
 	// create the mesh
 	RootComponent = Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 
-	// bind the hit handler
-	Mesh->OnComponentHit.AddDynamic(this, &ACombatLavaFloor::OnFloorHit);
+	// create the damage zone
+	DamageZone = CreateDefaultSubobject<UBoxComponent>(TEXT("Damage Zone"));
+	DamageZone->SetupAttachment(Mesh);
+
+	// the zone is sized in world units whatever the floor's scale
+	DamageZone->SetUsingAbsoluteScale(true);
+
+	// set the collision properties
+	DamageZone->SetCollisionProfileName(FName("OverlapAllDynamic"));
+
+	// bind the overlap handlers
+	DamageZone->OnComponentBeginOverlap.AddDynamic(this, &ACombatLavaFloor::OnZoneBeginOverlap);
+	DamageZone->OnComponentEndOverlap.AddDynamic(this, &ACombatLavaFloor::OnZoneEndOverlap);
+}
+
+void ACombatLavaFloor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	// cover the top face of the mesh, ZoneHeight deep
+	if (const UStaticMesh* StaticMesh = Mesh->GetStaticMesh())
+	{
+		const FBox LocalBounds = StaticMesh->GetBoundingBox();
+		const FVector Scale = Mesh->GetComponentScale();
+
+		DamageZone->SetBoxExtent(FVector(LocalBounds.GetExtent().X * FMath::Abs(Scale.X), LocalBounds.GetExtent().Y * FMath::Abs(Scale.Y), ZoneHeight * 0.5f));
+		DamageZone->SetRelativeLocation(FVector(LocalBounds.GetCenter().X, LocalBounds.GetCenter().Y, LocalBounds.Max.Z + ZoneHeight * 0.5f / FMath::Max(FMath::Abs(Scale.Z), UE_KINDA_SMALL_NUMBER)));
+	}
+}
+
+void ACombatLavaFloor::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// clear the damage timer
+	GetWorld()->GetTimerManager().ClearTimer(DamageTimer);
+}
+
+void ACombatLavaFloor::OnZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	// only damageable actors are tracked
+	if (!OtherActor || !OtherActor->Implements<UCombatDamageable>())
+	{
+		return;
+	}
+
+	// an actor overlapping with several components is still one occupant
+	if (Occupants.Contains(OtherActor))
+	{
+		return;
+	}
+
+	Occupants.Add(OtherActor);
+
+	// start ticking on the first occupant; the first tick lands right away
+	if (!DamageTimer.IsValid())
+	{
+		GetWorld()->GetTimerManager().SetTimer(DamageTimer, this, &ACombatLavaFloor::DamageOccupants, DamageInterval, true, 0.0f);
+	}
 }
 
-void ACombatLavaFloor::OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void ACombatLavaFloor::OnZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
-	// check if the hit actor is damageable by casting to the interface
-	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(OtherActor))
+	// keep actors that still overlap with another of their components
+	if (!OtherActor || DamageZone->IsOverlappingActor(OtherActor))
 	{
+		return;
+	}
+
+	Occupants.RemoveSwap(OtherActor);
+}
+
+void ACombatLavaFloor::DamageOccupants()
+{
+	// forget occupants that went away without an end overlap
+	Occupants.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Occupant) { return !Occupant.IsValid(); });
+
+	// stop ticking once the zone is empty
+	if (Occupants.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(DamageTimer);
+		return;
+	}
+
+	UCombatDamageQueue* DamageQueue = UCombatDamageQueue::Get(this);
+
+	for (const TWeakObjectPtr<AActor>& Occupant : Occupants)
+	{
+		AActor* Target = Occupant.Get();
+		const FVector Location = Target->GetActorLocation();
+
 		// damage the actor
-		Damageable->ApplyDamage(Damage, this, Hit.ImpactPoint, FVector::ZeroVector);
+		if (DamageQueue)
+		{
+			DamageQueue->Enqueue(Target, this, Damage, Location, FVector::ZeroVector);
+		}
+		else if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(Target))
+		{
+			Damageable->ApplyDamage(Damage, this, Location, FVector::ZeroVector);
+		}
 	}
 }
@@ -8,9 +8,12 @@
 
 class UStaticMeshComponent;
 class UPrimitiveComponent;
+class UBoxComponent;
 
 /**
- *  A basic actor that applies damage on contact through the ICombatDamageable interface. 
+ *  A damage zone over a floor mesh. Damageable actors inside the zone take damage through the ICombatDamageable
+ *  interface at a fixed rate from a single timer, so the cost scales with the number of occupants rather than
+ *  with physics contacts, and doesn't depend on the frame rate.
  */
 UCLASS(abstract)
 class ACombatLavaFloor : public AActor
@@ -21,20 +24,51 @@ class ACombatLavaFloor : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Mesh;
 
+	/** Damage zone covering the top of the floor mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* DamageZone;
+
 protected:
 
-	/** Amount of damage to deal on contact */
+	/** Amount of damage dealt to each occupant on every damage tick */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	float Damage = 10000.0f;
 
+	/** Time between damage ticks */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0.05, ClampMax = 10, Units = "s"))
+	float DamageInterval = 0.25f;
+
+	/** Height of the damage zone above the floor surface */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 1, ClampMax = 500, Units = "cm"))
+	float ZoneHeight = 50.0f;
+
+	/** Damageable actors currently inside the zone */
+	TArray<TWeakObjectPtr<AActor>> Occupants;
+
+	/** Damage tick timer, only running while the zone has occupants */
+	FTimerHandle DamageTimer;
+
 public:	
 
 	/** Constructor */
 	ACombatLavaFloor();
 
+	/** Fits the damage zone to the floor mesh */
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+	/** EndPlay cleanup */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 protected:
 
-	/** Blocking hit handler */
+	/** Adds damageable actors entering the zone */
 	UFUNCTION()
-	void OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+	void OnZoneBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Removes actors leaving the zone */
+	UFUNCTION()
+	void OnZoneEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/** Damages every occupant */
+	void DamageOccupants();
 };
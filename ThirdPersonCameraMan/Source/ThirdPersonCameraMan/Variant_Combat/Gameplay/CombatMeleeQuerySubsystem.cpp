@@ -0,0 +1,442 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatMeleeQuerySubsystem.h"
+#include "CombatAttacker.h"
+#include "CombatDamageable.h"
+#include "CombatDamageQueue.h"
+#include "ThirdPersonCameraMan.h"
+#include "Algo/Sort.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatMelee, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Combat melee queries"), STAT_CombatMeleeQueries, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat melee sweeps"), STAT_CombatMeleeSweeps, STATGROUP_Game);
+
+static TAutoConsoleVariable<int32> CVarCombatMeleeQueryMode(
+	TEXT("combat.MeleeQueryMode"),
+	1,
+	TEXT("How melee attack sweeps run: 0 = immediately, as each attack is queued (attack notify or weapon trail step), 1 = batched at the end of the frame, 2 = async, resolved next frame"),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatMeleeBenchCommand(
+	TEXT("combat.MeleeBench"),
+	TEXT("Per-frame melee query cost of every query mode. Args: [counts=10,100,500] [frames=N] | stop"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatMeleeQuerySubsystem* Queries = UCombatMeleeQuerySubsystem::Get(World);
+		if (!Queries)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+		{
+			Queries->StopBenchmark();
+			return;
+		}
+
+		TArray<int32> Counts = { 10, 100, 500 };
+		int32 Frames = 120;
+		for (const FString& Arg : Args)
+		{
+			FString CountList;
+			if (FParse::Value(*Arg, TEXT("counts="), CountList, false))
+			{
+				TArray<FString> Parts;
+				CountList.ParseIntoArray(Parts, TEXT(","));
+				Counts.Reset();
+				for (const FString& Part : Parts)
+				{
+					Counts.Add(FMath::Max(1, FCString::Atoi(*Part)));
+				}
+			}
+			FParse::Value(*Arg, TEXT("frames="), Frames);
+		}
+		Queries->StartBenchmark(Counts, Frames);
+	}));
+
+namespace CombatMeleeQueries
+{
+	/** Frames at the start of each benchmark step that aren't measured, so async sweeps from the previous step drain first */
+	constexpr int32 BenchWarmupFrames = 2;
+
+	/** Number of query modes the benchmark cycles through */
+	constexpr int32 NumModes = 3;
+
+	const TCHAR* ModeName(ECombatMeleeQueryMode Mode)
+	{
+		switch (Mode)
+		{
+		case ECombatMeleeQueryMode::Immediate:	return TEXT("immediate");
+		case ECombatMeleeQueryMode::Batched:	return TEXT("batched");
+		default:								return TEXT("async");
+		}
+	}
+}
+
+UCombatMeleeQuerySubsystem* UCombatMeleeQuerySubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UCombatMeleeQuerySubsystem>() : nullptr;
+}
+
+TStatId UCombatMeleeQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatMeleeQuerySubsystem, STATGROUP_Tickables);
+}
+
+ECombatMeleeQueryMode UCombatMeleeQuerySubsystem::GetMode() const
+{
+	if (BenchStep != INDEX_NONE)
+	{
+		return static_cast<ECombatMeleeQueryMode>(BenchStep % CombatMeleeQueries::NumModes);
+	}
+
+	return static_cast<ECombatMeleeQueryMode>(FMath::Clamp(CVarCombatMeleeQueryMode.GetValueOnGameThread(), 0, CombatMeleeQueries::NumModes - 1));
+}
+
+UCombatMeleeQuerySubsystem::FPendingQuery UCombatMeleeQuerySubsystem::MakePending(const FCombatMeleeQuery& Query, bool bBenchmark) const
+{
+	FPendingQuery Pending;
+	Pending.Query = Query;
+	Pending.AttackerName = Query.Attacker.IsValid() ? Query.Attacker->GetFName() : NAME_None;
+	Pending.bBenchmark = bBenchmark;
+	return Pending;
+}
+
+void UCombatMeleeQuerySubsystem::QueueAttack(const FCombatMeleeQuery& Query)
+{
+	if (GetMode() != ECombatMeleeQueryMode::Immediate)
+	{
+		Queued.Add(MakePending(Query, false));
+		return;
+	}
+
+	// sweep and dispatch right away
+	SCOPE_CYCLE_COUNTER(STAT_CombatMeleeQueries);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// reuse one scratch query, hit array included; an attack queued by a hit while it's being dispatched gets its own
+	TArray<FPendingQuery> Nested;
+	TArray<FPendingQuery>& Resolved = bDispatchingImmediate ? Nested : ImmediateScratch;
+	TGuardValue<bool> DispatchGuard(bDispatchingImmediate, true);
+
+	if (Resolved.Num() == 0)
+	{
+		Resolved.AddDefaulted();
+	}
+	FPendingQuery& Pending = Resolved[0];
+	Pending.Query = Query;
+	Pending.AttackerName = Query.Attacker.IsValid() ? Query.Attacker->GetFName() : NAME_None;
+	Pending.Hits.Reset();
+	Pending.bBenchmark = false;
+
+	Sweep(Pending);
+	Dispatch(Resolved);
+
+	// don't keep the attacker or the swing's hit set alive until the next attack
+	Pending.Query = FCombatMeleeQuery();
+
+	FrameQueryCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+void UCombatMeleeQuerySubsystem::Sweep(FPendingQuery& Pending) const
+{
+	const FCombatMeleeQuery& Query = Pending.Query;
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatMeleeSweep), false, Query.Attacker.Get());
+
+	GetWorld()->SweepMultiByObjectType(Pending.Hits, Query.Start, Query.End, FQuat::Identity, Query.ObjectParams, FCollisionShape::MakeSphere(Query.Radius), QueryParams);
+	INC_DWORD_STAT(STAT_CombatMeleeSweeps);
+}
+
+void UCombatMeleeQuerySubsystem::IssueAsync(FPendingQuery& Pending) const
+{
+	const FCombatMeleeQuery& Query = Pending.Query;
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatMeleeSweep), false, Query.Attacker.Get());
+
+	Pending.Handle = GetWorld()->AsyncSweepByObjectType(EAsyncTraceType::Multi, Query.Start, Query.End, FQuat::Identity, Query.ObjectParams, FCollisionShape::MakeSphere(Query.Radius), QueryParams);
+	INC_DWORD_STAT(STAT_CombatMeleeSweeps);
+}
+
+void UCombatMeleeQuerySubsystem::Dispatch(TArray<FPendingQuery>& Resolved)
+{
+	// attackers by name; a stable sort keeps each attacker's attacks in the order they were queued
+	Algo::StableSort(Resolved, [](const FPendingQuery& A, const FPendingQuery& B)
+	{
+		return A.AttackerName.LexicalLess(B.AttackerName);
+	});
+
+	UCombatDamageQueue* DamageQueue = UCombatDamageQueue::Get(this);
+
+	for (FPendingQuery& Pending : Resolved)
+	{
+		// hits by distance along the sweep, ties broken by actor name
+		Algo::Sort(Pending.Hits, [](const FHitResult& A, const FHitResult& B)
+		{
+			if (A.Time != B.Time)
+			{
+				return A.Time < B.Time;
+			}
+
+			// hits without an actor go last
+			const AActor* ActorA = A.GetActor();
+			const AActor* ActorB = B.GetActor();
+			if (!ActorA || !ActorB)
+			{
+				return ActorA != nullptr;
+			}
+			return ActorA->GetFName().LexicalLess(ActorB->GetFName());
+		});
+
+		FrameHits += Pending.Hits.Num();
+
+		// the attacker may have been removed while the sweep was in flight
+		AActor* Attacker = Pending.Query.Attacker.Get();
+		if (Pending.bBenchmark || !Attacker)
+		{
+			continue;
+		}
+
+		const FCombatMeleeQuery& Query = Pending.Query;
+		ICombatAttacker* AttackerInterface = Cast<ICombatAttacker>(Attacker);
+
+		for (const FHitResult& CurrentHit : Pending.Hits)
+		{
+			AActor* HitActor = CurrentHit.GetActor();
+			if (!HitActor || (!Query.RequiredTargetTag.IsNone() && !HitActor->ActorHasTag(Query.RequiredTargetTag)))
+			{
+				continue;
+			}
+
+			// check if we've hit a damageable actor
+			if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(HitActor))
+			{
+				// skip actors this swing already damaged
+				if (Query.SwingHits.IsValid())
+				{
+					bool bAlreadyHit = false;
+					Query.SwingHits->Add(HitActor, &bAlreadyHit);
+					if (bAlreadyHit)
+					{
+						continue;
+					}
+				}
+
+				// knock upwards and away from the impact normal
+				const FVector Impulse = (CurrentHit.ImpactNormal * -Query.KnockbackImpulse) + (FVector::UpVector * Query.LaunchImpulse);
+
+				// queue the damage; every hit this attacker lands on the actor this frame is applied in one go
+				if (DamageQueue)
+				{
+					DamageQueue->Enqueue(HitActor, Attacker, Query.Damage, CurrentHit.ImpactPoint, Impulse);
+				}
+				else
+				{
+					Damageable->ApplyDamage(Query.Damage, Attacker, CurrentHit.ImpactPoint, Impulse);
+				}
+
+				// let the attacker play its effects
+				if (AttackerInterface)
+				{
+					AttackerInterface->AttackHitDealt(Query.Damage, CurrentHit.ImpactPoint);
+				}
+			}
+		}
+	}
+}
+
+void UCombatMeleeQuerySubsystem::Tick(float DeltaTime)
+{
+	if (BenchStep != INDEX_NONE)
+	{
+		QueueBenchmarkAttacks();
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CombatMeleeQueries);
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		// resolve the sweeps issued last frame
+		if (InFlight.Num() > 0)
+		{
+			UWorld* World = GetWorld();
+			for (FPendingQuery& Pending : InFlight)
+			{
+				FTraceDatum Datum;
+				if (World->QueryTraceData(Pending.Handle, Datum))
+				{
+					Pending.Hits = MoveTemp(Datum.OutHits);
+				}
+			}
+			Dispatch(InFlight);
+			InFlight.Reset();
+		}
+
+		// flush this frame's queue; queries left over from a mode switch to immediate are flushed as batched
+		if (Queued.Num() > 0)
+		{
+			FrameSweeps += Queued.Num();
+			if (GetMode() == ECombatMeleeQueryMode::Async)
+			{
+				for (FPendingQuery& Pending : Queued)
+				{
+					IssueAsync(Pending);
+				}
+				Swap(InFlight, Queued);
+			}
+			else
+			{
+				for (FPendingQuery& Pending : Queued)
+				{
+					Sweep(Pending);
+				}
+				Dispatch(Queued);
+			}
+			Queued.Reset();
+		}
+
+		FrameQueryCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+
+	if (BenchStep != INDEX_NONE)
+	{
+		StepBenchmark();
+	}
+
+	FrameQueryCycles = 0;
+	FrameSweeps = 0;
+	FrameHits = 0;
+}
+
+bool UCombatMeleeQuerySubsystem::StartBenchmark(const TArray<int32>& AttackerCounts, int32 FramesPerStep)
+{
+	if (BenchStep != INDEX_NONE)
+	{
+		UE_LOG(LogCombatMelee, Warning, TEXT("Melee benchmark already running; `combat.MeleeBench stop` first"));
+		return false;
+	}
+
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	APawn* Centre = PC ? PC->GetPawn() : nullptr;
+	if (!Centre || AttackerCounts.Num() == 0)
+	{
+		UE_LOG(LogCombatMelee, Error, TEXT("Melee benchmark needs a local player pawn to surround"));
+		return false;
+	}
+
+	BenchCentre = Centre;
+	BenchCounts = AttackerCounts;
+	BenchFramesPerStep = FMath::Max(1, FramesPerStep);
+	BenchStep = 0;
+	BenchFrame = 0;
+	BenchFrameMs.Reset(BenchFramesPerStep);
+	BenchSweeps = 0;
+	BenchHits = 0;
+
+	UE_LOG(LogCombatMelee, Display, TEXT("Melee benchmark: %d attacker counts x %d modes, %d frames each"), BenchCounts.Num(), CombatMeleeQueries::NumModes, BenchFramesPerStep);
+	return true;
+}
+
+void UCombatMeleeQuerySubsystem::StopBenchmark()
+{
+	if (BenchStep == INDEX_NONE)
+	{
+		return;
+	}
+
+	BenchStep = INDEX_NONE;
+	UE_LOG(LogCombatMelee, Display, TEXT("Melee benchmark stopped"));
+}
+
+void UCombatMeleeQuerySubsystem::QueueBenchmarkAttacks()
+{
+	const AActor* Centre = BenchCentre.Get();
+	if (!Centre)
+	{
+		UE_LOG(LogCombatMelee, Warning, TEXT("Melee benchmark pawn is gone"));
+		StopBenchmark();
+		return;
+	}
+
+	// attackers on rings around the pawn, each swinging an enemy-sized sweep at it; the pawn itself is ignored
+	const int32 Count = BenchCounts[BenchStep / CombatMeleeQueries::NumModes];
+	const FVector Target = Centre->GetActorLocation();
+
+	FCombatMeleeQuery Query;
+	Query.Attacker = BenchCentre;
+	Query.Radius = 50.0f;
+	Query.ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	Query.ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const float Angle = UE_TWO_PI * Index / Count;
+		const float Distance = 150.0f + 50.0f * (Index % 5);
+		const FVector Direction(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+
+		Query.Start = Target + Direction * Distance;
+		Query.End = Query.Start - Direction * 75.0f;
+
+		FPendingQuery Pending = MakePending(Query, true);
+		if (GetMode() == ECombatMeleeQueryMode::Immediate)
+		{
+			// stand-in for the notify-time sweep, timed the same way
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			TArray<FPendingQuery> Resolved;
+			Sweep(Resolved.Add_GetRef(MoveTemp(Pending)));
+			Dispatch(Resolved);
+			FrameQueryCycles += FPlatformTime::Cycles64() - StartCycles;
+			++FrameSweeps;
+		}
+		else
+		{
+			Queued.Add(MoveTemp(Pending));
+		}
+	}
+}
+
+void UCombatMeleeQuerySubsystem::StepBenchmark()
+{
+	if (++BenchFrame > CombatMeleeQueries::BenchWarmupFrames)
+	{
+		BenchFrameMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds64(FrameQueryCycles)));
+		BenchSweeps += FrameSweeps;
+		BenchHits += FrameHits;
+	}
+
+	if (BenchFrameMs.Num() < BenchFramesPerStep)
+	{
+		return;
+	}
+
+	BenchFrameMs.Sort();
+	float TotalMs = 0.0f;
+	for (const float Ms : BenchFrameMs)
+	{
+		TotalMs += Ms;
+	}
+
+	const ECombatMeleeQueryMode Mode = GetMode();
+	const int32 Count = BenchCounts[BenchStep / CombatMeleeQueries::NumModes];
+	UE_LOG(LogCombatMelee, Display, TEXT("Melee queries %4d attackers %-9s: mean %.3f ms  p95 %.3f ms  max %.3f ms  (%.0f sweeps, %.1f hits per frame)"),
+		Count, CombatMeleeQueries::ModeName(Mode), TotalMs / BenchFrameMs.Num(),
+		ThirdPersonCameraMan::NearestRankPercentile(BenchFrameMs, 0.95f), BenchFrameMs.Last(),
+		static_cast<double>(BenchSweeps) / BenchFrameMs.Num(), static_cast<double>(BenchHits) / BenchFrameMs.Num());
+
+	BenchFrame = 0;
+	BenchFrameMs.Reset();
+	BenchSweeps = 0;
+	BenchHits = 0;
+
+	if (++BenchStep >= BenchCounts.Num() * CombatMeleeQueries::NumModes)
+	{
+		BenchStep = INDEX_NONE;
+		UE_LOG(LogCombatMelee, Display, TEXT("Melee benchmark done"));
+	}
+}
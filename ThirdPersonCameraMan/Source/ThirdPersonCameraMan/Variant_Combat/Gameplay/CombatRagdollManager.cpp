@@ -0,0 +1,355 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatRagdollManager.h"
+#include "CameraRig.h"
+#include "DirectorGameState.h"
+#include "Algo/StableSort.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatRagdoll, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Combat ragdoll budget"), STAT_CombatRagdollBudget, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat ragdoll active bodies"), STAT_CombatRagdollBodies, STATGROUP_Game);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Combat physics frame span (ms)"), STAT_CombatPhysicsFrameSpanMs, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatRagdollsCommand(
+	TEXT("combat.Ragdolls"),
+	TEXT("Print ragdoll budget figures: active bodies, sleeping / frozen ragdolls and physics frame span"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (const UCombatRagdollManager* Ragdolls = UCombatRagdollManager::Get(World))
+		{
+			Ragdolls->PrintStats();
+		}
+	}));
+
+namespace CombatRagdolls
+{
+	/** Weight of the latest physics frame span in the running average */
+	constexpr double AverageWeight = 0.05;
+}
+
+UCombatRagdollManager* UCombatRagdollManager::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UCombatRagdollManager>() : nullptr;
+}
+
+TStatId UCombatRagdollManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatRagdollManager, STATGROUP_Tickables);
+}
+
+void UCombatRagdollManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (FPhysScene* PhysScene = InWorld.GetPhysicsScene())
+	{
+		PreTickHandle = PhysScene->OnPhysScenePreTick.AddUObject(this, &UCombatRagdollManager::OnPhysicsPreTick);
+		PostTickHandle = PhysScene->OnPhysScenePostTick.AddUObject(this, &UCombatRagdollManager::OnPhysicsPostTick);
+	}
+}
+
+void UCombatRagdollManager::Deinitialize()
+{
+	if (FPhysScene* PhysScene = GetWorld()->GetPhysicsScene())
+	{
+		PhysScene->OnPhysScenePreTick.Remove(PreTickHandle);
+		PhysScene->OnPhysScenePostTick.Remove(PostTickHandle);
+	}
+
+	Super::Deinitialize();
+}
+
+void UCombatRagdollManager::OnPhysicsPreTick(FChaosScene* Scene, float DeltaSeconds)
+{
+	PhysicsSpanStart = FPlatformTime::Seconds();
+}
+
+void UCombatRagdollManager::OnPhysicsPostTick(FChaosScene* Scene)
+{
+	if (PhysicsSpanStart <= 0.0)
+	{
+		return;
+	}
+
+	LastPhysicsSpanMs = (FPlatformTime::Seconds() - PhysicsSpanStart) * 1000.0;
+	MaxPhysicsSpanMs = FMath::Max(MaxPhysicsSpanMs, LastPhysicsSpanMs);
+	AvgPhysicsSpanMs = FMath::Lerp(AvgPhysicsSpanMs, LastPhysicsSpanMs, CombatRagdolls::AverageWeight);
+	PhysicsSpanStart = 0.0;
+
+	SET_FLOAT_STAT(STAT_CombatPhysicsFrameSpanMs, LastPhysicsSpanMs);
+}
+
+bool UCombatRagdollManager::AddRagdoll(USkeletalMeshComponent* Mesh, ECombatRagdollKind Kind)
+{
+	if (!Mesh)
+	{
+		return false;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// already simulating: a death takes over a hit reaction
+	if (FRagdoll* Existing = Ragdolls.FindByPredicate([Mesh](const FRagdoll& Ragdoll) { return Ragdoll.Mesh.Get() == Mesh; }))
+	{
+		if (Kind == ECombatRagdollKind::Death && Existing->Kind != ECombatRagdollKind::Death)
+		{
+			Existing->Kind = Kind;
+			Existing->StartTime = Now;
+		}
+		return true;
+	}
+
+	// hit reactions are cosmetic, so they only start if they fit; deaths always do and the budget catches up next tick
+	if (Kind == ECombatRagdollKind::HitReaction
+		&& CountActiveBodies() + Mesh->Bodies.Num() > GetDefault<UCombatRagdollSettings>()->MaxActiveBodies)
+	{
+		++NumHitReactionsDenied;
+		return false;
+	}
+
+	FRagdoll& Ragdoll = Ragdolls.AddDefaulted_GetRef();
+	Ragdoll.Mesh = Mesh;
+	Ragdoll.Kind = Kind;
+	Ragdoll.StartTime = Now;
+	return true;
+}
+
+void UCombatRagdollManager::RemoveRagdoll(USkeletalMeshComponent* Mesh)
+{
+	const int32 Index = Ragdolls.IndexOfByPredicate([Mesh](const FRagdoll& Ragdoll) { return Ragdoll.Mesh.Get() == Mesh; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// give a frozen mesh its animation and collision back
+	if (Ragdolls[Index].State == EState::Frozen && Mesh)
+	{
+		Mesh->bBlendPhysics = Ragdolls[Index].bFrozenBlendPhysics;
+		Mesh->bPauseAnims = false;
+		Mesh->SetComponentTickEnabled(true);
+		Mesh->SetCollisionEnabled(Ragdolls[Index].FrozenCollision);
+	}
+
+	Ragdolls.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+int32 UCombatRagdollManager::CountActiveBodies() const
+{
+	int32 Bodies = 0;
+	for (const FRagdoll& Ragdoll : Ragdolls)
+	{
+		if (Ragdoll.State == EState::Simulating)
+		{
+			if (const USkeletalMeshComponent* Mesh = Ragdoll.Mesh.Get())
+			{
+				Bodies += Mesh->Bodies.Num();
+			}
+		}
+	}
+	return Bodies;
+}
+
+void UCombatRagdollManager::Sleep(FRagdoll& Ragdoll, double Now)
+{
+	Ragdoll.Mesh->PutAllRigidBodiesToSleep();
+	Ragdoll.State = EState::Asleep;
+	Ragdoll.SleepTime = Now;
+	++NumSlept;
+}
+
+void UCombatRagdollManager::Freeze(FRagdoll& Ragdoll)
+{
+	USkeletalMeshComponent* Mesh = Ragdoll.Mesh.Get();
+
+	// make the bodies kinematic where they lie and keep the bones reading from them; with animation and the mesh
+	// tick off nothing drives them back, so the mesh holds the last simulated pose
+	Mesh->PutAllRigidBodiesToSleep();
+	Ragdoll.bFrozenBlendPhysics = Mesh->bBlendPhysics;
+	Mesh->bBlendPhysics = true;
+	Mesh->SetAllBodiesSimulatePhysics(false);
+	Mesh->bPauseAnims = true;
+	Mesh->SetComponentTickEnabled(false);
+
+	// the kinematic bodies left behind only need to be traced against, not pushed on
+	Ragdoll.FrozenCollision = Mesh->GetCollisionEnabled();
+	Mesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+
+	Ragdoll.State = EState::Frozen;
+	++NumFrozen;
+}
+
+void UCombatRagdollManager::EndHitReaction(FRagdoll& Ragdoll)
+{
+	Ragdoll.Mesh->SetPhysicsBlendWeight(0.0f);
+}
+
+void UCombatRagdollManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatRagdollBudget);
+
+	UWorld* World = GetWorld();
+	const UCombatRagdollSettings* Settings = GetDefault<UCombatRagdollSettings>();
+	const double Now = World->GetTimeSeconds();
+
+	// forget meshes that went away or stopped simulating on their own. Hit reactions keep the root (pelvis) body
+	// kinematic, so any simulating body counts, and one whose blend was ended has stopped even if its bodies haven't
+	Ragdolls.RemoveAllSwap([](const FRagdoll& Ragdoll)
+	{
+		const USkeletalMeshComponent* Mesh = Ragdoll.Mesh.Get();
+		if (!Mesh)
+		{
+			return true;
+		}
+		if (Ragdoll.State == EState::Frozen)
+		{
+			return false;
+		}
+		const bool bBlendEnded = Ragdoll.Kind == ECombatRagdollKind::HitReaction && Mesh->GetPhysicsBlendWeight() <= 0.0f;
+		return bBlendEnded || !Mesh->IsAnySimulatingPhysics();
+	}, EAllowShrinking::No);
+
+	if (Ragdolls.Num() == 0)
+	{
+		LastActiveBodies = 0;
+		SET_DWORD_STAT(STAT_CombatRagdollBodies, 0);
+		return;
+	}
+
+	// freeze deaths that have simulated long enough, or slept through their grace period
+	for (FRagdoll& Ragdoll : Ragdolls)
+	{
+		if (Ragdoll.Kind != ECombatRagdollKind::Death || Ragdoll.State == EState::Frozen)
+		{
+			continue;
+		}
+
+		const bool bTooOld = Now - Ragdoll.StartTime > Settings->MaxSimulationTime;
+		const bool bSleptOut = Ragdoll.State == EState::Asleep && Now - Ragdoll.SleepTime > Settings->SleepToFreezeDelay;
+		if (bTooOld || bSleptOut)
+		{
+			Freeze(Ragdoll);
+		}
+	}
+
+	// everything the players might be looking at
+	TArray<FVector, TInlineAllocator<8>> Interest;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			Interest.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	if (const ADirectorGameState* GS = World->GetGameState<ADirectorGameState>())
+	{
+		if (GS->ActiveCamera)
+		{
+			Interest.Add(GS->ActiveCamera->GetActorLocation());
+		}
+	}
+
+	// rank the simulating ones against the budget
+	TArray<FBudgetCandidate, TInlineAllocator<32>> Candidates;
+	TArray<int32, TInlineAllocator<32>> CandidateRagdolls;
+	for (int32 Index = 0; Index < Ragdolls.Num(); ++Index)
+	{
+		const FRagdoll& Ragdoll = Ragdolls[Index];
+		if (Ragdoll.State != EState::Simulating)
+		{
+			continue;
+		}
+
+		const FVector Location = Ragdoll.Mesh->GetComponentLocation();
+		float Distance = Interest.Num() > 0 ? UE_BIG_NUMBER : 0.0f;
+		for (const FVector& Point : Interest)
+		{
+			Distance = FMath::Min(Distance, static_cast<float>(FVector::Dist(Location, Point)));
+		}
+
+		FBudgetCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+		Candidate.Distance = Distance;
+		Candidate.Age = static_cast<float>(Now - Ragdoll.StartTime);
+		Candidate.Bodies = Ragdoll.Mesh->Bodies.Num();
+		CandidateRagdolls.Add(Index);
+	}
+
+	// past the budget, hit reactions end and deaths go to sleep
+	TArray<int32> OverBudget;
+	const int32 Bodies = SelectOverBudget(Candidates, Settings->MaxActiveBodies, Settings->AgeDistancePerSecond, OverBudget);
+	for (const int32 Candidate : OverBudget)
+	{
+		FRagdoll& Ragdoll = Ragdolls[CandidateRagdolls[Candidate]];
+		if (Ragdoll.Kind == ECombatRagdollKind::HitReaction)
+		{
+			EndHitReaction(Ragdoll);
+		}
+		else
+		{
+			Sleep(Ragdoll, Now);
+		}
+	}
+
+	LastActiveBodies = Bodies;
+	SET_DWORD_STAT(STAT_CombatRagdollBodies, Bodies);
+}
+
+int32 UCombatRagdollManager::SelectOverBudget(TConstArrayView<FBudgetCandidate> Candidates, int32 MaxBodies, float AgeDistancePerSecond, TArray<int32>& OutOverBudget)
+{
+	OutOverBudget.Reset();
+
+	// each second simulated counts as extra distance, so old ragdolls rank behind new ones at the same range
+	TArray<TPair<float, int32>, TInlineAllocator<32>> Ranked;
+	for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+	{
+		Ranked.Emplace(Candidates[Index].Distance + Candidates[Index].Age * AgeDistancePerSecond, Index);
+	}
+
+	Algo::StableSort(Ranked, [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+
+	// keep what fits; a big ragdoll past the budget doesn't stop a smaller one further down from fitting
+	int32 Bodies = 0;
+	for (const TPair<float, int32>& Entry : Ranked)
+	{
+		const int32 CandidateBodies = Candidates[Entry.Value].Bodies;
+		if (Bodies + CandidateBodies <= MaxBodies)
+		{
+			Bodies += CandidateBodies;
+		}
+		else
+		{
+			OutOverBudget.Add(Entry.Value);
+		}
+	}
+
+	return Bodies;
+}
+
+void UCombatRagdollManager::PrintStats() const
+{
+	int32 NumSimulating = 0;
+	int32 NumAsleep = 0;
+	int32 NumFrozenNow = 0;
+	for (const FRagdoll& Ragdoll : Ragdolls)
+	{
+		NumSimulating += Ragdoll.State == EState::Simulating ? 1 : 0;
+		NumAsleep += Ragdoll.State == EState::Asleep ? 1 : 0;
+		NumFrozenNow += Ragdoll.State == EState::Frozen ? 1 : 0;
+	}
+
+	UE_LOG(LogCombatRagdoll, Display, TEXT("Ragdolls: %d simulating (%d / %d bodies), %d asleep, %d frozen; %d put to sleep, %d frozen, %d hit reactions denied so far"),
+		NumSimulating, LastActiveBodies, GetDefault<UCombatRagdollSettings>()->MaxActiveBodies, NumAsleep, NumFrozenNow, NumSlept, NumFrozen, NumHitReactionsDenied);
+	UE_LOG(LogCombatRagdoll, Display, TEXT("  physics frame span (StartPhysics..EndPhysics, incl. TG_DuringPhysics): last %.2f ms, avg %.2f ms, max %.2f ms"),
+		LastPhysicsSpanMs, AvgPhysicsSpanMs, MaxPhysicsSpanMs);
+}
@@ -0,0 +1,168 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatRagdollManager.generated.h"
+
+class USkeletalMeshComponent;
+class FChaosScene;
+
+/** Why a mesh is simulating */
+UENUM()
+enum class ECombatRagdollKind : uint8
+{
+	/** Partial blend while taking damage, ended on landing */
+	HitReaction,
+
+	/** Full ragdoll after death */
+	Death
+};
+
+/**
+ *  Ragdoll budget tuning ([/Script/ThirdPersonCameraMan.CombatRagdollSettings] in DefaultGame.ini)
+ */
+UCLASS(config=Game, defaultconfig)
+class UCombatRagdollSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Simulated bodies allowed at once, over all ragdolls and hit reactions */
+	UPROPERTY(config, EditAnywhere, Category="Budget", meta = (ClampMin = 0))
+	int32 MaxActiveBodies = 200;
+
+	/** Each second a ragdoll has simulated counts as being this much farther from the players, so old ones go first */
+	UPROPERTY(config, EditAnywhere, Category="Priority", meta = (ClampMin = 0, Units = "cm"))
+	float AgeDistancePerSecond = 500.0f;
+
+	/** Over-budget death ragdolls are put to sleep first, then frozen once they have slept this long */
+	UPROPERTY(config, EditAnywhere, Category="Budget", meta = (ClampMin = 0, Units = "s"))
+	float SleepToFreezeDelay = 0.5f;
+
+	/** Death ragdolls are frozen in their pose after simulating this long, budget or not */
+	UPROPERTY(config, EditAnywhere, Category="Budget", meta = (ClampMin = 0, Units = "s"))
+	float MaxSimulationTime = 4.0f;
+};
+
+/**
+ *  Keeps the number of simulated ragdoll bodies within a budget.
+ *  Ragdolls and hit reactions are ranked by distance to the nearest player pawn or live camera rig, aged by how long
+ *  they've simulated. Those past the budget lose their hit reaction, or for deaths are put to sleep and then frozen
+ *  in their last pose, with kinematic bodies and animation off. combat.Ragdolls reports active bodies and the physics
+ *  frame span (StartPhysics to EndPhysics on the game thread, so it includes TG_DuringPhysics work, not just the solver).
+ */
+UCLASS()
+class UCombatRagdollManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the subsystem for the provided world context */
+	static UCombatRagdollManager* Get(const UObject* WorldContext);
+
+	/** Registers a simulating mesh. Returns false if a hit reaction doesn't fit the budget and shouldn't start */
+	bool AddRagdoll(USkeletalMeshComponent* Mesh, ECombatRagdollKind Kind);
+
+	/** Forgets a mesh that stopped simulating, undoing a freeze */
+	void RemoveRagdoll(USkeletalMeshComponent* Mesh);
+
+	/** Logs ragdoll and physics figures */
+	void PrintStats() const;
+
+	/** Hooks the physics frame span timing */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Unhooks the physics scene */
+	virtual void Deinitialize() override;
+
+	/** Enforces the budget */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** A simulating ragdoll as the budget ranks it */
+	struct FBudgetCandidate
+	{
+		/** Distance to the nearest player pawn or live camera rig */
+		float Distance = 0.0f;
+
+		/** Seconds it has simulated */
+		float Age = 0.0f;
+
+		/** Simulated bodies it costs */
+		int32 Bodies = 0;
+	};
+
+	/** Ranks candidates nearest and newest first and keeps each that still fits MaxBodies. Fills OutOverBudget with the indices of the rest, returns the bodies kept */
+	static int32 SelectOverBudget(TConstArrayView<FBudgetCandidate> Candidates, int32 MaxBodies, float AgeDistancePerSecond, TArray<int32>& OutOverBudget);
+
+protected:
+
+	/** Only game worlds ragdoll */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+	}
+
+private:
+
+	/** Where a ragdoll is in its budget life */
+	enum class EState : uint8
+	{
+		Simulating,
+		Asleep,
+		Frozen
+	};
+
+	/** A registered ragdoll */
+	struct FRagdoll
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+		ECombatRagdollKind Kind = ECombatRagdollKind::Death;
+		EState State = EState::Simulating;
+		double StartTime = 0.0;
+		double SleepTime = 0.0;
+
+		/** Mesh collision and physics blending before it was frozen */
+		TEnumAsByte<ECollisionEnabled::Type> FrozenCollision = ECollisionEnabled::NoCollision;
+		bool bFrozenBlendPhysics = false;
+	};
+
+	/** Number of simulated bodies counted against the budget */
+	int32 CountActiveBodies() const;
+
+	/** Puts a death ragdoll to sleep */
+	void Sleep(FRagdoll& Ragdoll, double Now);
+
+	/** Freezes a death ragdoll into its current pose */
+	void Freeze(FRagdoll& Ragdoll);
+
+	/** Ends a hit reaction's partial blend */
+	void EndHitReaction(FRagdoll& Ragdoll);
+
+	/** Physics frame span, from the start of the scene tick to its end on the game thread */
+	void OnPhysicsPreTick(FChaosScene* Scene, float DeltaSeconds);
+	void OnPhysicsPostTick(FChaosScene* Scene);
+
+	/** Registered ragdolls */
+	TArray<FRagdoll> Ragdolls;
+
+	/** Physics scene delegate handles */
+	FDelegateHandle PreTickHandle;
+	FDelegateHandle PostTickHandle;
+
+	/** Budget and physics figures */
+	int32 LastActiveBodies = 0;
+	int32 NumSlept = 0;
+	int32 NumFrozen = 0;
+	int32 NumHitReactionsDenied = 0;
+	double PhysicsSpanStart = 0.0;
+	double LastPhysicsSpanMs = 0.0;
+	double MaxPhysicsSpanMs = 0.0;
+	double AvgPhysicsSpanMs = 0.0;
+};
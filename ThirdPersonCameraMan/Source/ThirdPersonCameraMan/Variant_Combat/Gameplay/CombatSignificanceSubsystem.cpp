@@ -0,0 +1,429 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatSignificanceSubsystem.h"
+#include "CameraRig.h"
+#include "CombatActorPool.h"
+#include "CombatCrowdSubsystem.h"
+#include "CombatEnemy.h"
+#include "CombatHealthBarSubsystem.h"
+#include "DirectorGameState.h"
+#include "ThirdPersonCameraMan.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "Camera/CameraComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "CoreGlobals.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatSignificance, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Combat significance"), STAT_CombatSignificance, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat significance high"), STAT_CombatSignificanceHigh, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat significance medium"), STAT_CombatSignificanceMedium, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat significance low"), STAT_CombatSignificanceLow, STATGROUP_Game);
+
+static TAutoConsoleVariable<bool> CVarCombatSignificance(
+	TEXT("combat.Significance"),
+	true,
+	TEXT("If true, combat actors are throttled by significance; if false, everything runs at the High level"),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatSignificanceCommand(
+	TEXT("combat.SignificanceStats"),
+	TEXT("Print the number of combat actors at each significance level"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (const UCombatSignificanceSubsystem* Significance = UCombatSignificanceSubsystem::Get(World))
+		{
+			Significance->PrintStats();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs GCombatSignificanceBenchCommand(
+	TEXT("combat.SignificanceBench"),
+	TEXT("Game thread time of an enemy arena with significance off, then on. Args: [count=N] [frames=N] [class=<enemy class path>] | stop"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UCombatSignificanceSubsystem* Significance = UCombatSignificanceSubsystem::Get(World);
+		if (!Significance)
+		{
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+		{
+			Significance->StopBenchmark();
+			return;
+		}
+
+		FString ClassPath;
+		int32 Count = 100;
+		int32 Frames = 300;
+		for (const FString& Arg : Args)
+		{
+			FParse::Value(*Arg, TEXT("class="), ClassPath);
+			FParse::Value(*Arg, TEXT("count="), Count);
+			FParse::Value(*Arg, TEXT("frames="), Frames);
+		}
+
+		// the crowd's default enemy unless told otherwise
+		const TSubclassOf<ACombatEnemy> EnemyClass = ClassPath.IsEmpty()
+			? GetDefault<UCombatCrowdSettings>()->DefaultEnemyClass.LoadSynchronous()
+			: TSoftClassPtr<ACombatEnemy>(FSoftObjectPath(ClassPath)).LoadSynchronous();
+
+		Significance->StartBenchmark(EnemyClass, Count, Frames);
+	}));
+
+namespace CombatSignificance
+{
+	/** Actors not rendered within this long can't be seen from any view */
+	constexpr float RecentlyRenderedTolerance = 0.2f;
+
+	/** Frames skipped at the start of each benchmark step while the levels settle */
+	constexpr int32 BenchWarmupFrames = 10;
+
+	/** Benchmark enemies are placed no closer than this to the player */
+	constexpr float BenchMinRadius = 300.0f;
+
+	const TCHAR* LevelName(ECombatSignificance Significance)
+	{
+		switch (Significance)
+		{
+		case ECombatSignificance::High:		return TEXT("high");
+		case ECombatSignificance::Medium:	return TEXT("medium");
+		default:							return TEXT("low");
+		}
+	}
+}
+
+const FCombatSignificanceLevel& UCombatSignificanceSettings::GetLevel(ECombatSignificance Significance) const
+{
+	switch (Significance)
+	{
+	case ECombatSignificance::High:		return High;
+	case ECombatSignificance::Medium:	return Medium;
+	default:							return Low;
+	}
+}
+
+UCombatSignificanceSubsystem* UCombatSignificanceSubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UCombatSignificanceSubsystem>() : nullptr;
+}
+
+TStatId UCombatSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatSignificanceSubsystem::Register(AActor* Actor)
+{
+	if (!Actor || Actors.ContainsByPredicate([Actor](const FSignificantActor& Entry) { return Entry.Actor.Get() == Actor; }))
+	{
+		return;
+	}
+
+	FSignificantActor& Entry = Actors.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+
+	// actors that stay High would otherwise never be applied and keep the engine's screen size URO
+	Entry.bApplied = Apply(Actor, ECombatSignificance::High);
+}
+
+void UCombatSignificanceSubsystem::Unregister(AActor* Actor)
+{
+	Actors.RemoveAllSwap([Actor](const FSignificantActor& Entry) { return Entry.Actor.Get() == Actor; }, EAllowShrinking::No);
+}
+
+ECombatSignificance UCombatSignificanceSubsystem::GetSignificance(const AActor* Actor) const
+{
+	const FSignificantActor* Entry = Actors.FindByPredicate([Actor](const FSignificantActor& Entry) { return Entry.Actor.Get() == Actor; });
+	return Entry ? Entry->Significance : ECombatSignificance::High;
+}
+
+void UCombatSignificanceSubsystem::GatherViews(TArray<FView>& OutViews) const
+{
+	const UWorld* World = GetWorld();
+	const float Margin = GetDefault<UCombatSignificanceSettings>()->ViewConeMargin;
+
+	auto AddView = [&OutViews, Margin](const FVector& Location, const FRotator& Rotation, float FOV)
+	{
+		FView& View = OutViews.AddDefaulted_GetRef();
+		View.Location = Location;
+		View.Direction = Rotation.Vector();
+		View.CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Min(FOV * 0.5f + Margin, 180.0f)));
+	};
+
+	// every player's view; on a server that includes the remote players, so their own surroundings stay at full rate
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PC = It->Get())
+		{
+			FVector Location;
+			FRotator Rotation;
+			PC->GetPlayerViewPoint(Location, Rotation);
+			AddView(Location, Rotation, PC->PlayerCameraManager ? PC->PlayerCameraManager->GetFOVAngle() : 90.0f);
+		}
+	}
+
+	// whatever the live camera films
+	if (const ADirectorGameState* GS = World->GetGameState<ADirectorGameState>())
+	{
+		if (GS->ActiveCamera && GS->ActiveCamera->CameraComponent)
+		{
+			const UCameraComponent* Camera = GS->ActiveCamera->CameraComponent;
+			AddView(Camera->GetComponentLocation(), Camera->GetComponentRotation(), Camera->FieldOfView);
+		}
+	}
+}
+
+ECombatSignificance UCombatSignificanceSubsystem::Rate(const FVector& Location, ECombatSignificance Current, TConstArrayView<FView> Views, bool bRendered, const UCombatSignificanceSettings& Settings)
+{
+	float Distance = UE_BIG_NUMBER;
+	for (const FView& View : Views)
+	{
+		const FVector ToActor = Location - View.Location;
+		const float ViewDistance = static_cast<float>(ToActor.Size());
+		const bool bInCone = ViewDistance <= KINDA_SMALL_NUMBER || FVector::DotProduct(ToActor / ViewDistance, View.Direction) >= View.CosHalfAngle;
+
+		Distance = FMath::Min(Distance, bRendered && bInCone ? ViewDistance : ViewDistance * Settings.HiddenDistanceScale);
+	}
+
+	// moving up a level takes getting a bit closer than the threshold
+	const float UpMargin = Settings.Hysteresis;
+	const float FullDistance = Current == ECombatSignificance::High ? Settings.FullDetailDistance : Settings.FullDetailDistance - UpMargin;
+	const float ReducedDistance = Current == ECombatSignificance::Low ? Settings.ReducedDetailDistance - UpMargin : Settings.ReducedDetailDistance;
+
+	if (Distance <= FullDistance)
+	{
+		return ECombatSignificance::High;
+	}
+
+	return Distance <= ReducedDistance ? ECombatSignificance::Medium : ECombatSignificance::Low;
+}
+
+bool UCombatSignificanceSubsystem::Apply(AActor* Actor, ECombatSignificance Significance) const
+{
+	const FCombatSignificanceLevel& Level = GetDefault<UCombatSignificanceSettings>()->GetLevel(Significance);
+
+	Actor->SetActorTickInterval(Level.TickInterval);
+
+	// animation: every LOD skips the same number of frames, so URO follows significance instead of screen size
+	const ACharacter* Character = Cast<ACharacter>(Actor);
+	USkeletalMeshComponent* Mesh = Character ? Character->GetMesh() : Actor->FindComponentByClass<USkeletalMeshComponent>();
+	const bool bAnimReady = !Mesh || !Mesh->bEnableUpdateRateOptimizations || Mesh->AnimUpdateRateParams;
+	if (Mesh && Mesh->AnimUpdateRateParams)
+	{
+		FAnimUpdateRateParameters* Params = Mesh->AnimUpdateRateParams;
+		Params->bShouldUseLodMap = true;
+		Params->LODToFrameSkipMap.Reset();
+		for (int32 LOD = 0; LOD < FMath::Max(Mesh->GetNumLODs(), 1); ++LOD)
+		{
+			Params->LODToFrameSkipMap.Add(LOD, Level.AnimUpdateRate - 1);
+		}
+	}
+
+	// AI decisions
+	if (const APawn* Pawn = Cast<APawn>(Actor))
+	{
+		if (const AAIController* AIController = Cast<AAIController>(Pawn->GetController()))
+		{
+			if (UBrainComponent* Brain = AIController->GetBrainComponent())
+			{
+				Brain->SetComponentTickInterval(Level.StateTreeTickInterval);
+			}
+		}
+	}
+
+	if (UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(Actor))
+	{
+		HealthBars->SetSignificant(Actor, Level.bShowLifeBar);
+	}
+
+	return bAnimReady;
+}
+
+void UCombatSignificanceSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatSignificance);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// the benchmark decides while it runs
+	const bool bEnabled = BenchStep == INDEX_NONE ? CVarCombatSignificance.GetValueOnGameThread() : BenchStep == 1;
+
+	Actors.RemoveAllSwap([](const FSignificantActor& Entry) { return !Entry.Actor.IsValid(); }, EAllowShrinking::No);
+
+	TArray<FView, TInlineAllocator<8>> Views;
+	if (bEnabled)
+	{
+		GatherViews(Views);
+	}
+
+	const UCombatSignificanceSettings* Settings = GetDefault<UCombatSignificanceSettings>();
+	const bool bCanRender = GetWorld()->GetNetMode() != NM_DedicatedServer;
+
+	LastChanges = 0;
+	LevelCounts[0] = LevelCounts[1] = LevelCounts[2] = 0;
+
+	for (FSignificantActor& Entry : Actors)
+	{
+		AActor* Actor = Entry.Actor.Get();
+
+		// parked in the actor pool: keep the level it had, it's re-rated once it's back in play
+		if (Actor->IsHidden() && bEnabled)
+		{
+			++LevelCounts[static_cast<int32>(Entry.Significance)];
+			continue;
+		}
+
+		// the renderer already knows what's occluded; without one, only the view cone counts
+		const bool bRendered = !bCanRender || Actor->WasRecentlyRendered(CombatSignificance::RecentlyRenderedTolerance);
+
+		// nobody watching (e.g. between a server start and the first login) rates everything Low
+		const ECombatSignificance Significance = !bEnabled ? ECombatSignificance::High
+			: Views.Num() > 0 ? Rate(Actor->GetActorLocation(), Entry.Significance, Views, bRendered, *Settings)
+			: ECombatSignificance::Low;
+
+		// apply on change, once for everything when significance is toggled, and until a level has fully applied
+		if (Significance != Entry.Significance || bEnabled != bWasEnabled || !Entry.bApplied)
+		{
+			LastChanges += (Significance != Entry.Significance || bEnabled != bWasEnabled) ? 1 : 0;
+			Entry.Significance = Significance;
+			Entry.bApplied = Apply(Actor, Significance);
+		}
+
+		++LevelCounts[static_cast<int32>(Significance)];
+	}
+
+	bWasEnabled = bEnabled;
+
+	SET_DWORD_STAT(STAT_CombatSignificanceHigh, LevelCounts[0]);
+	SET_DWORD_STAT(STAT_CombatSignificanceMedium, LevelCounts[1]);
+	SET_DWORD_STAT(STAT_CombatSignificanceLow, LevelCounts[2]);
+
+	LastTickMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	if (BenchStep != INDEX_NONE)
+	{
+		StepBenchmark();
+	}
+}
+
+bool UCombatSignificanceSubsystem::StartBenchmark(TSubclassOf<ACombatEnemy> EnemyClass, int32 Count, int32 FramesPerStep)
+{
+	if (BenchStep != INDEX_NONE)
+	{
+		UE_LOG(LogCombatSignificance, Warning, TEXT("Significance benchmark already running; `combat.SignificanceBench stop` first"));
+		return false;
+	}
+
+	UCombatActorPool* Pool = UCombatActorPool::Get(this);
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	const APawn* Centre = PC ? PC->GetPawn() : nullptr;
+	if (!Pool || !Centre || !EnemyClass)
+	{
+		UE_LOG(LogCombatSignificance, Error, TEXT("Significance benchmark needs a local player pawn and an enemy class"));
+		return false;
+	}
+
+	// a sunflower spiral out past the reduced detail distance, so every level is populated
+	const float MaxRadius = GetDefault<UCombatSignificanceSettings>()->ReducedDetailDistance * 1.5f;
+	Count = FMath::Max(1, Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const float Radius = FMath::Max(CombatSignificance::BenchMinRadius, MaxRadius * FMath::Sqrt((Index + 0.5f) / Count));
+		const float Angle = Index * UE_GOLDEN_RATIO * UE_TWO_PI;
+		const FVector Location = Centre->GetActorLocation() + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Radius;
+
+		if (ACombatEnemy* Enemy = Pool->Acquire<ACombatEnemy>(EnemyClass, FTransform(FRotator(0.0f, FMath::RadiansToDegrees(Angle) + 180.0f, 0.0f), Location)))
+		{
+			// hold the arena still, so both steps see the same levels; StateTree and animation keep running
+			Enemy->GetCharacterMovement()->DisableMovement();
+			BenchEnemies.Add(Enemy);
+		}
+	}
+
+	BenchFramesPerStep = FMath::Max(1, FramesPerStep);
+	BenchStep = 0;
+	BenchFrame = 0;
+	BenchFrameMs.Reset(BenchFramesPerStep);
+
+	UE_LOG(LogCombatSignificance, Display, TEXT("Significance benchmark: %d enemies, %d frames with significance off, then on"), BenchEnemies.Num(), BenchFramesPerStep);
+	return true;
+}
+
+void UCombatSignificanceSubsystem::StopBenchmark()
+{
+	if (BenchStep == INDEX_NONE)
+	{
+		return;
+	}
+
+	BenchStep = INDEX_NONE;
+
+	// give the arena back to the pool
+	UCombatActorPool* Pool = UCombatActorPool::Get(this);
+	for (const TWeakObjectPtr<ACombatEnemy>& Enemy : BenchEnemies)
+	{
+		if (Enemy.IsValid() && Pool)
+		{
+			Pool->Release(Enemy.Get());
+		}
+	}
+	BenchEnemies.Reset();
+
+	UE_LOG(LogCombatSignificance, Display, TEXT("Significance benchmark done"));
+}
+
+void UCombatSignificanceSubsystem::StepBenchmark()
+{
+	// previous frame's game thread time, as `stat unit` reports it
+	if (++BenchFrame > CombatSignificance::BenchWarmupFrames)
+	{
+		BenchFrameMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+	}
+
+	if (BenchFrameMs.Num() < BenchFramesPerStep)
+	{
+		return;
+	}
+
+	BenchFrameMs.Sort();
+	float TotalMs = 0.0f;
+	for (const float Ms : BenchFrameMs)
+	{
+		TotalMs += Ms;
+	}
+
+	UE_LOG(LogCombatSignificance, Display, TEXT("Significance %-3s %4d enemies: game thread mean %.3f ms  p95 %.3f ms  max %.3f ms  (%d high, %d medium, %d low)"),
+		BenchStep == 1 ? TEXT("on") : TEXT("off"), BenchEnemies.Num(), TotalMs / BenchFrameMs.Num(),
+		ThirdPersonCameraMan::NearestRankPercentile(BenchFrameMs, 0.95f), BenchFrameMs.Last(),
+		LevelCounts[0], LevelCounts[1], LevelCounts[2]);
+
+	BenchFrame = 0;
+	BenchFrameMs.Reset();
+
+	if (++BenchStep > 1)
+	{
+		StopBenchmark();
+	}
+}
+
+void UCombatSignificanceSubsystem::PrintStats() const
+{
+	UE_LOG(LogCombatSignificance, Display, TEXT("Significance %s: %d actors, %d %s, %d %s, %d %s; %d level changes, %.3f ms last tick"),
+		bWasEnabled ? TEXT("on") : TEXT("off"), Actors.Num(),
+		LevelCounts[0], CombatSignificance::LevelName(ECombatSignificance::High),
+		LevelCounts[1], CombatSignificance::LevelName(ECombatSignificance::Medium),
+		LevelCounts[2], CombatSignificance::LevelName(ECombatSignificance::Low),
+		LastChanges, LastTickMs);
+}
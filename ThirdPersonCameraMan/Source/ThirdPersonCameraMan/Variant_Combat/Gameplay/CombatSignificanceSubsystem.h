@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSignificanceSubsystem.generated.h"
+
+class ACombatEnemy;
+
+/** How much of its update budget an actor gets */
+UENUM()
+enum class ECombatSignificance : uint8
+{
+	High,
+	Medium,
+	Low
+};
+
+/** Update rates applied to actors at one significance level */
+USTRUCT()
+struct FCombatSignificanceLevel
+{
+	GENERATED_BODY()
+
+	FCombatSignificanceLevel() = default;
+	FCombatSignificanceLevel(float InTickInterval, int32 InAnimUpdateRate, float InStateTreeTickInterval, bool bInShowLifeBar)
+		: TickInterval(InTickInterval), AnimUpdateRate(InAnimUpdateRate), StateTreeTickInterval(InStateTreeTickInterval), bShowLifeBar(bInShowLifeBar)
+	{}
+
+	/** Actor tick interval, 0 for every frame */
+	UPROPERTY(config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, Units = "s"))
+	float TickInterval = 0.0f;
+
+	/** Skeletal animation is updated once every this many frames (URO), 1 for every frame */
+	UPROPERTY(config, EditAnywhere, Category="Significance", meta = (ClampMin = 1))
+	int32 AnimUpdateRate = 1;
+
+	/** StateTree tick interval of the AI controller, 0 for every frame */
+	UPROPERTY(config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, Units = "s"))
+	float StateTreeTickInterval = 0.0f;
+
+	/** If false, the actor's life bar isn't drawn */
+	UPROPERTY(config, EditAnywhere, Category="Significance")
+	bool bShowLifeBar = true;
+};
+
+/**
+ *  Significance tuning ([/Script/ThirdPersonCameraMan.CombatSignificanceSettings] in DefaultGame.ini)
+ */
+UCLASS(config=Game, defaultconfig)
+class UCombatSignificanceSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Actors closer than this to a view are High, closer than ReducedDetailDistance Medium, Low otherwise */
+	UPROPERTY(config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, Units = "cm"))
+	float FullDetailDistance = 1500.0f;
+	UPROPERTY(config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, Units = "cm"))
+	float ReducedDetailDistance = 4000.0f;
+
+	/** Distances to views that can't see the actor (outside the view cone, or not rendered) count this many times farther */
+	UPROPERTY(config, EditAnywhere, Category="Significance", meta = (ClampMin = 1))
+	float HiddenDistanceScale = 2.5f;
+
+	/** Added to half the view's field of view when testing the view cone, so actors at the screen edge count as seen */
+	UPROPERTY(config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, ClampMax = 90, Units = "deg"))
+	float ViewConeMargin = 15.0f;
+
+	/** An actor must come this much closer than a threshold to move up a level, so it doesn't flicker on the boundary */
+	UPROPERTY(config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, Units = "cm"))
+	float Hysteresis = 200.0f;
+
+	/** Update rates per level */
+	UPROPERTY(config, EditAnywhere, Category="Levels")
+	FCombatSignificanceLevel High;
+	UPROPERTY(config, EditAnywhere, Category="Levels")
+	FCombatSignificanceLevel Medium = FCombatSignificanceLevel(0.1f, 2, 0.1f, true);
+	UPROPERTY(config, EditAnywhere, Category="Levels")
+	FCombatSignificanceLevel Low = FCombatSignificanceLevel(0.25f, 4, 0.5f, false);
+
+	/** Returns the update rates of a level */
+	const FCombatSignificanceLevel& GetLevel(ECombatSignificance Significance) const;
+};
+
+/**
+ *  Rates every registered combat actor by its distance to each local player view and the live camera rig,
+ *  counting views that can't see it as farther, and throttles what it doesn't need at full rate: actor tick
+ *  interval, skeletal animation update rate, the AI controller's StateTree tick and the life bar.
+ *  Levels are only applied when they change. combat.SignificanceStats reports the levels and combat.SignificanceBench
+ *  measures the game thread time saved in a benchmark arena.
+ */
+UCLASS()
+class UCombatSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the subsystem for the provided world context */
+	static UCombatSignificanceSubsystem* Get(const UObject* WorldContext);
+
+	/** Starts rating the actor, applying High right away so it runs the configured rates (not engine defaults) until the next update */
+	void Register(AActor* Actor);
+
+	/** Stops rating the actor */
+	void Unregister(AActor* Actor);
+
+	/** Current level of a registered actor, High if it isn't registered */
+	ECombatSignificance GetSignificance(const AActor* Actor) const;
+
+	/** Spawns an arena of enemies around the first player, then measures game thread time with significance off and on */
+	bool StartBenchmark(TSubclassOf<ACombatEnemy> EnemyClass, int32 Count, int32 FramesPerStep);
+
+	/** Ends a running benchmark and returns its enemies to the pool */
+	void StopBenchmark();
+
+	/** Logs level counts and timing */
+	void PrintStats() const;
+
+	/** Rates the actors and applies level changes */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** A view the actors are rated against */
+	struct FView
+	{
+		FVector Location;
+		FVector Direction;
+		float CosHalfAngle;
+	};
+
+	/** Rates a location against the views, moving from the Current level with hysteresis. If bRendered is false no view counts as seeing it */
+	static ECombatSignificance Rate(const FVector& Location, ECombatSignificance Current, TConstArrayView<FView> Views, bool bRendered, const UCombatSignificanceSettings& Settings);
+
+protected:
+
+	/** Only game worlds throttle actors */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+	}
+
+private:
+
+	/** A registered actor */
+	struct FSignificantActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		ECombatSignificance Significance = ECombatSignificance::High;
+
+		/** Whether the whole level has been applied; retried every update until it has */
+		bool bApplied = false;
+	};
+
+	/** Gathers the local player views and the live rig */
+	void GatherViews(TArray<FView>& OutViews) const;
+
+	/** Applies a level's update rates to an actor. False if its mesh isn't ready for the animation rate yet */
+	bool Apply(AActor* Actor, ECombatSignificance Significance) const;
+
+	/** Records a benchmark frame and moves to the next step */
+	void StepBenchmark();
+
+	/** Registered actors */
+	TArray<FSignificantActor> Actors;
+
+	/** Whether levels were being applied last tick, so disabling puts everything back to High once */
+	bool bWasEnabled = true;
+
+	/** Figures */
+	int32 LevelCounts[3] = { 0, 0, 0 };
+	int32 LastChanges = 0;
+	double LastTickMs = 0.0;
+
+	/** Benchmark state */
+	TArray<TWeakObjectPtr<ACombatEnemy>> BenchEnemies;
+	int32 BenchFramesPerStep = 0;
+	int32 BenchStep = INDEX_NONE;
+	int32 BenchFrame = 0;
+	TArray<float> BenchFrameMs;
+};
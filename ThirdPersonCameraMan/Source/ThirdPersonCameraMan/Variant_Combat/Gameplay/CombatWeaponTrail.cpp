@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatWeaponTrail.h"
+
+void FCombatWeaponTrail::BeginSwing(int32 InSweepBudget)
+{
+	Samples.Reset();
+	SampleTimes.Reset();
+
+	// sweeps still in flight from the previous swing keep its hit set alive
+	HitSet = MakeShared<FCombatSwingHitSet>();
+	SweepsLeft = FMath::Max(1, InSweepBudget);
+}
+
+void FCombatWeaponTrail::AddSample(const FVector& Location, double Time, float Window)
+{
+	// drop samples that fell out of the window
+	int32 NumStale = 0;
+	while (NumStale < SampleTimes.Num() && SampleTimes[NumStale] < Time - Window)
+	{
+		++NumStale;
+	}
+
+	if (NumStale > 0)
+	{
+		Samples.RemoveAt(0, NumStale, EAllowShrinking::No);
+		SampleTimes.RemoveAt(0, NumStale, EAllowShrinking::No);
+	}
+
+	Samples.Add(Location);
+	SampleTimes.Add(Time);
+}
+
+int32 FCombatWeaponTrail::QueueSweeps(UCombatMeleeQuerySubsystem* Queries, const FCombatMeleeQuery& Template, const FVector& CurrentLocation, double Time, float Window, float MinStepLength)
+{
+	// a trace outside of a swing gets a swing of its own
+	if (!HitSet.IsValid())
+	{
+		BeginSwing(1);
+	}
+
+	if (!Queries || SweepsLeft <= 0)
+	{
+		return 0;
+	}
+
+	// build the path since the last trace, skipping steps too short to matter
+	TArray<FVector, TInlineAllocator<16>> Path;
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		if (SampleTimes[Index] >= Time - Window && (Path.Num() == 0 || FVector::DistSquared(Path.Last(), Samples[Index]) >= FMath::Square(MinStepLength)))
+		{
+			Path.Add(Samples[Index]);
+		}
+	}
+
+	if (Path.Num() > 0 && FVector::DistSquared(Path.Last(), CurrentLocation) < FMath::Square(MinStepLength))
+	{
+		Path.Last() = CurrentLocation;
+	}
+	else
+	{
+		Path.Add(CurrentLocation);
+	}
+
+	// nothing recorded yet, e.g. the first trace before the bone is known: fall back to the template's forward sweep
+	if (Samples.Num() == 0)
+	{
+		Path = { Template.Start, Template.End };
+	}
+
+	// the bone hasn't moved: one sweep in place
+	else if (Path.Num() == 1)
+	{
+		Path.Add(CurrentLocation);
+	}
+
+	// more steps than the budget allows: resample the path by length into as many steps as we can afford
+	const int32 NumSteps = FMath::Min(Path.Num() - 1, SweepsLeft);
+	if (NumSteps < Path.Num() - 1)
+	{
+		TArray<float, TInlineAllocator<16>> Distances;
+		Distances.Add(0.0f);
+		for (int32 Index = 1; Index < Path.Num(); ++Index)
+		{
+			Distances.Add(Distances.Last() + FVector::Dist(Path[Index - 1], Path[Index]));
+		}
+
+		TArray<FVector, TInlineAllocator<16>> Resampled;
+		Resampled.Add(Path[0]);
+		int32 Segment = 1;
+		for (int32 Step = 1; Step < NumSteps; ++Step)
+		{
+			const float Target = Distances.Last() * Step / NumSteps;
+			while (Segment < Path.Num() - 1 && Distances[Segment] < Target)
+			{
+				++Segment;
+			}
+
+			const float SegmentLength = Distances[Segment] - Distances[Segment - 1];
+			const float Alpha = SegmentLength > UE_KINDA_SMALL_NUMBER ? (Target - Distances[Segment - 1]) / SegmentLength : 1.0f;
+			Resampled.Add(FMath::Lerp(Path[Segment - 1], Path[Segment], Alpha));
+		}
+		Resampled.Add(Path.Last());
+
+		Path = MoveTemp(Resampled);
+	}
+
+	// queue one sweep per step, all sharing the swing's hit set
+	FCombatMeleeQuery Query = Template;
+	Query.SwingHits = HitSet;
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		Query.Start = Path[Step];
+		Query.End = Path[Step + 1];
+		Queries->QueueAttack(Query);
+	}
+
+	SweepsLeft -= NumSteps;
+
+	// the next trace continues from here
+	Samples.Reset();
+	SampleTimes.Reset();
+	Samples.Add(CurrentLocation);
+	SampleTimes.Add(Time);
+
+	return NumSteps;
+}
@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatMeleeQuerySubsystem.h"
+#include "CombatWeaponTrail.generated.h"
+
+/**
+ *  Shape of a melee attack's collision check
+ */
+UENUM(BlueprintType)
+enum class ECombatMeleeTraceMode : uint8
+{
+	/** a single sphere sweep from the damage bone along the actor's forward vector */
+	Forward,
+
+	/** sub-stepped sphere sweeps along the path the damage bone took since the last trace, each target damaged once per swing */
+	WeaponTrail
+};
+
+/**
+ *  Records the path of an attacker's damage bone during a swing and turns it into melee sweeps.
+ *  The attacker samples the bone every frame while attacking; each attack trace sweeps the path since the previous
+ *  trace (bounded by a time window, so the windup isn't swept), resampled by length to fit the swing's sweep budget.
+ *  All of a swing's sweeps share one hit set, so a target is damaged at most once per swing however many notifies
+ *  or sub-steps reach it.
+ */
+struct FCombatWeaponTrail
+{
+	/** Starts a new swing: forgets the path and the actors already hit, and restores the sweep budget */
+	void BeginSwing(int32 InSweepBudget);
+
+	/** Records the damage bone's location, dropping samples older than the window */
+	void AddSample(const FVector& Location, double Time, float Window);
+
+	/** Queues sweeps along the path since the last trace up to the current bone location, or the template's own sweep if no path was recorded. Returns the number of sweeps queued */
+	int32 QueueSweeps(UCombatMeleeQuerySubsystem* Queries, const FCombatMeleeQuery& Template, const FVector& CurrentLocation, double Time, float Window, float MinStepLength);
+
+	/** Sweeps left in this swing's budget */
+	int32 GetSweepsLeft() const { return SweepsLeft; }
+
+private:
+
+	/** Bone locations and the times they were sampled, oldest first */
+	TArray<FVector, TInlineAllocator<16>> Samples;
+	TArray<double, TInlineAllocator<16>> SampleTimes;
+
+	/** Actors this swing already damaged, shared with its in-flight sweeps */
+	TSharedPtr<FCombatSwingHitSet> HitSet;
+
+	/** Sweeps this swing may still run */
+	int32 SweepsLeft = 0;
+};
@@ -33,4 +33,7 @@ public:
 	/** Performs a charged attack's check to loop the charge animation. Usually called from a montage's AnimNotify */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckChargedAttack() = 0;
+
+	/** Called for each damageable actor an attack trace damaged. Melee queries may resolve a frame after the trace was requested */
+	virtual void AttackHitDealt(float Damage, const FVector& ImpactPoint) {}
 };
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "CombatPoolable.generated.h"
+
+/**
+ *  CombatPoolable Interface
+ *  Lets an actor be parked in the combat actor pool instead of destroyed, and reset when it's reused
+ */
+UINTERFACE(MinimalAPI, NotBlueprintable)
+class UCombatPoolable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class ICombatPoolable
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Brings a pooled actor back into play at the provided transform, as if it had just been spawned there */
+	virtual void OnAcquiredFromPool(const FTransform& SpawnTransform) = 0;
+
+	/** Takes the actor out of play: hidden, no collision, no tick, no timers, no logic */
+	virtual void OnReturnedToPool() = 0;
+};
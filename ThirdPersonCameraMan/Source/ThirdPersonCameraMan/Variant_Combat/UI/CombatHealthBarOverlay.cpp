@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHealthBarOverlay.h"
+#include "CombatHealthBarSubsystem.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Rendering/DrawElements.h"
+#include "SceneView.h"
+#include "Styling/CoreStyle.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat health bar projection"), STAT_CombatHealthBarProject, STATGROUP_Game);
+
+void UCombatHealthBarOverlay::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	// the bars are decoration only
+	SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UCombatHealthBarOverlay::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_CombatHealthBarProject);
+
+	ProjectedBars.Reset();
+
+	const UCombatHealthBarSubsystem* HealthBars = UCombatHealthBarSubsystem::Get(this);
+	const ULocalPlayer* LocalPlayer = GetOwningLocalPlayer();
+	if (!HealthBars || !LocalPlayer || !LocalPlayer->ViewportClient)
+	{
+		return;
+	}
+
+	// one view-projection for every bar
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return;
+	}
+
+	const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	if (ViewRect.Area() <= 0)
+	{
+		return;
+	}
+
+	const UCombatHealthBarSettings* Settings = GetDefault<UCombatHealthBarSettings>();
+	const float FadeRange = FMath::Max(Settings->MaxDistance - Settings->FadeStartDistance, 1.0f);
+
+	// the overlay covers this player's view, whatever the DPI scale
+	const FVector2f LocalSize = MyGeometry.GetLocalSize();
+	const FVector2f PixelToLocal = LocalSize / FVector2f(ViewRect.Size());
+	const FVector2f HalfBar = FVector2f(Settings->BarSize) * 0.5f;
+
+	for (const FCombatHealthBar& Bar : HealthBars->GetVisibleBars())
+	{
+		// distance cull
+		const float Distance = static_cast<float>(FVector::Dist(ProjectionData.ViewOrigin, Bar.Location));
+		if (Distance > Settings->MaxDistance)
+		{
+			continue;
+		}
+
+		// behind the viewer
+		FVector2D Pixel;
+		if (!FSceneView::ProjectWorldToScreen(Bar.Location, ViewRect, ViewProjection, Pixel))
+		{
+			continue;
+		}
+
+		// off screen
+		const FVector2f Centre = (FVector2f(Pixel) - FVector2f(ViewRect.Min)) * PixelToLocal;
+		if (Centre.X < -HalfBar.X || Centre.Y < -HalfBar.Y || Centre.X > LocalSize.X + HalfBar.X || Centre.Y > LocalSize.Y + HalfBar.Y)
+		{
+			continue;
+		}
+
+		FProjectedBar& Projected = ProjectedBars.AddDefaulted_GetRef();
+		Projected.Centre = Centre;
+		Projected.Percent = Bar.Percent;
+		Projected.Color = Bar.Color;
+		Projected.Opacity = 1.0f - FMath::Clamp((Distance - Settings->FadeStartDistance) / FadeRange, 0.0f, 1.0f);
+		Projected.Distance = Distance;
+	}
+
+	// nearer bars draw over farther ones within each paint layer only: every fill is a layer above every background,
+	// so where bars overlap a far bar's fill still paints over a near bar's background
+	ProjectedBars.Sort([](const FProjectedBar& A, const FProjectedBar& B) { return A.Distance > B.Distance; });
+}
+
+int32 UCombatHealthBarOverlay::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	if (ProjectedBars.Num() == 0)
+	{
+		return LayerId;
+	}
+
+	const UCombatHealthBarSettings* Settings = GetDefault<UCombatHealthBarSettings>();
+	const FSlateBrush* Brush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+	const FVector2f BarSize = FVector2f(Settings->BarSize);
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+
+	// every background on one layer and every fill on the next, so each layer batches into a single draw
+	const int32 BackgroundLayer = LayerId + 1;
+	const int32 FillLayer = LayerId + 2;
+
+	for (const FProjectedBar& Bar : ProjectedBars)
+	{
+		const FVector2f TopLeft = Bar.Centre - BarSize * 0.5f;
+
+		FLinearColor BackgroundColor = Settings->BackgroundColor * Tint;
+		BackgroundColor.A *= Bar.Opacity;
+		FSlateDrawElement::MakeBox(OutDrawElements, BackgroundLayer,
+			AllottedGeometry.ToPaintGeometry(BarSize, FSlateLayoutTransform(TopLeft)), Brush, ESlateDrawEffect::None, BackgroundColor);
+
+		if (Bar.Percent > 0.0f)
+		{
+			FLinearColor FillColor = Bar.Color * Tint;
+			FillColor.A *= Bar.Opacity;
+			FSlateDrawElement::MakeBox(OutDrawElements, FillLayer,
+				AllottedGeometry.ToPaintGeometry(FVector2f(BarSize.X * Bar.Percent, BarSize.Y), FSlateLayoutTransform(TopLeft)), Brush, ESlateDrawEffect::None, FillColor);
+		}
+	}
+
+	return FillLayer;
+}
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "CombatHealthBarOverlay.generated.h"
+
+/**
+ *  A full screen overlay that draws every visible health bar for its owning player.
+ *  Bars are projected with a single view-projection matrix per frame, culled by distance and screen bounds,
+ *  faded out with distance and painted as two layers of boxes, so Slate batches them into a couple of draws.
+ */
+UCLASS()
+class UCombatHealthBarOverlay : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** A bar projected to the overlay this frame */
+	struct FProjectedBar
+	{
+		FVector2f Centre;
+		float Percent;
+		FLinearColor Color;
+		float Opacity;
+		float Distance;
+	};
+
+	/** Bars projected this frame, far to near */
+	TArray<FProjectedBar> ProjectedBars;
+
+protected:
+
+	/** Makes the overlay ignore input */
+	virtual void NativeConstruct() override;
+
+	/** Projects, culls and fades this frame's bars */
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	/** Paints the projected bars */
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+};
@@ -0,0 +1,141 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHealthBarSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat health bar gather"), STAT_CombatHealthBarGather, STATGROUP_Game);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat health bars gathered"), STAT_CombatHealthBarsGathered, STATGROUP_Game);
+
+namespace CombatHealthBars
+{
+	/** Actors not rendered within this long are treated as occluded */
+	constexpr float RecentlyRenderedTolerance = 0.2f;
+}
+
+UCombatHealthBarSubsystem* UCombatHealthBarSubsystem::Get(const UObject* WorldContext)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UCombatHealthBarSubsystem>() : nullptr;
+}
+
+TStatId UCombatHealthBarSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatHealthBarSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatHealthBarSubsystem::AddBar(AActor* Owner, float Height, const FLinearColor& Color)
+{
+	if (!Owner)
+	{
+		return;
+	}
+
+	// re-adding an actor just resets its bar
+	if (const int32* Existing = BarIndices.Find(Owner))
+	{
+		Heights[*Existing] = Height;
+		Percents[*Existing] = 1.0f;
+		Colors[*Existing] = Color;
+		Shown[*Existing] = true;
+		return;
+	}
+
+	BarIndices.Add(Owner, Owners.Num());
+	Owners.Add(Owner);
+	OwnerKeys.Add(Owner);
+	Heights.Add(Height);
+	Percents.Add(1.0f);
+	Colors.Add(Color);
+	Shown.Add(true);
+	Significant.Add(true);
+}
+
+void UCombatHealthBarSubsystem::RemoveBar(AActor* Owner)
+{
+	int32 Index = INDEX_NONE;
+	if (!BarIndices.RemoveAndCopyValue(Owner, Index))
+	{
+		return;
+	}
+
+	// swap the last bar into the hole; re-keyed from the stored key, as the last owner may already be garbage collected
+	const int32 Last = Owners.Num() - 1;
+	if (Index != Last)
+	{
+		BarIndices.Add(OwnerKeys[Last], Index);
+	}
+
+	Owners.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	OwnerKeys.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Heights.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Percents.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Colors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Shown.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Significant.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UCombatHealthBarSubsystem::SetPercent(const AActor* Owner, float Percent)
+{
+	if (const int32* Index = BarIndices.Find(Owner))
+	{
+		Percents[*Index] = FMath::Clamp(Percent, 0.0f, 1.0f);
+	}
+}
+
+void UCombatHealthBarSubsystem::SetShown(const AActor* Owner, bool bShown)
+{
+	if (const int32* Index = BarIndices.Find(Owner))
+	{
+		Shown[*Index] = bShown;
+	}
+}
+
+void UCombatHealthBarSubsystem::SetSignificant(const AActor* Owner, bool bSignificant)
+{
+	if (const int32* Index = BarIndices.Find(Owner))
+	{
+		Significant[*Index] = bSignificant;
+	}
+}
+
+void UCombatHealthBarSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatHealthBarGather);
+
+	VisibleBars.Reset();
+
+	// nobody to draw for
+	if (GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	const bool bCullNotRendered = GetDefault<UCombatHealthBarSettings>()->bCullNotRendered;
+
+	for (int32 Index = 0; Index < Owners.Num(); ++Index)
+	{
+		const AActor* Owner = Owners[Index].Get();
+
+		// hidden actors include the ones parked in the actor pool
+		if (!Shown[Index] || !Significant[Index] || !Owner || Owner->IsHidden())
+		{
+			continue;
+		}
+
+		// the renderer already knows what's occluded or off screen
+		if (bCullNotRendered && !Owner->WasRecentlyRendered(CombatHealthBars::RecentlyRenderedTolerance))
+		{
+			continue;
+		}
+
+		FCombatHealthBar& Bar = VisibleBars.AddDefaulted_GetRef();
+		Bar.Location = Owner->GetActorLocation() + FVector(0.0f, 0.0f, Heights[Index]);
+		Bar.Percent = Percents[Index];
+		Bar.Color = Colors[Index];
+	}
+
+	SET_DWORD_STAT(STAT_CombatHealthBarsGathered, VisibleBars.Num());
+}
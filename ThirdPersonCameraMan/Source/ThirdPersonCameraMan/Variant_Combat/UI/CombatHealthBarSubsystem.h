@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatHealthBarSubsystem.generated.h"
+
+/**
+ *  Health bar tuning ([/Script/ThirdPersonCameraMan.CombatHealthBarSettings] in DefaultGame.ini)
+ */
+UCLASS(config=Game, defaultconfig)
+class UCombatHealthBarSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Bars farther than this from the viewer aren't drawn */
+	UPROPERTY(config, EditAnywhere, Category="Culling", meta = (ClampMin = 0, Units = "cm"))
+	float MaxDistance = 3000.0f;
+
+	/** Bars start fading out at this distance, reaching zero at MaxDistance */
+	UPROPERTY(config, EditAnywhere, Category="Culling", meta = (ClampMin = 0, Units = "cm"))
+	float FadeStartDistance = 2000.0f;
+
+	/**
+	 *  If true, bars of actors that weren't rendered recently (occluded or off screen) aren't drawn.
+	 *  Scene captures count as rendering too, so while a camera rig captures, whatever it films keeps its bar even when
+	 *  the player can't see it; the overlay's own screen bounds test still culls bars outside the player's view
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Culling")
+	bool bCullNotRendered = true;
+
+	/** Bar size on screen, in Slate units */
+	UPROPERTY(config, EditAnywhere, Category="Appearance")
+	FVector2D BarSize = FVector2D(80.0f, 8.0f);
+
+	/** Empty part of the bar */
+	UPROPERTY(config, EditAnywhere, Category="Appearance")
+	FLinearColor BackgroundColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.6f);
+};
+
+/** One bar to draw this frame */
+struct FCombatHealthBar
+{
+	FVector Location;
+	float Percent;
+	FLinearColor Color;
+};
+
+/**
+ *  Keeps the health of every damageable actor that shows a life bar, in place of a widget component per actor.
+ *  Each frame the bars that can be seen are gathered into one array, which the health bar overlay of every
+ *  local player projects and draws in one batched pass.
+ */
+UCLASS()
+class UCombatHealthBarSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the subsystem for the provided world context */
+	static UCombatHealthBarSubsystem* Get(const UObject* WorldContext);
+
+	/** Starts drawing a full bar at the provided height above the actor */
+	void AddBar(AActor* Owner, float Height, const FLinearColor& Color);
+
+	/** Stops drawing the actor's bar */
+	void RemoveBar(AActor* Owner);
+
+	/** Sets the actor's bar to the provided 0-1 percentage value */
+	void SetPercent(const AActor* Owner, float Percent);
+
+	/** Shows or hides the actor's bar */
+	void SetShown(const AActor* Owner, bool bShown);
+
+	/** Set by the significance pass: bars of insignificant actors aren't drawn, whether they're shown or not */
+	void SetSignificant(const AActor* Owner, bool bSignificant);
+
+	/** Bars to draw this frame */
+	TConstArrayView<FCombatHealthBar> GetVisibleBars() const { return VisibleBars; }
+
+	/** Gathers this frame's bars */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	/** Only game worlds draw health bars */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+	}
+
+private:
+
+	/** Registered bars, one element per actor in every array */
+	TArray<TWeakObjectPtr<AActor>> Owners;
+	TArray<TObjectKey<AActor>> OwnerKeys;
+	TArray<float> Heights;
+	TArray<float> Percents;
+	TArray<FLinearColor> Colors;
+	TArray<bool> Shown;
+	TArray<bool> Significant;
+
+	/** Index of each actor's bar, keyed like OwnerKeys so an entry can be re-keyed after its actor is gone */
+	TMap<TObjectKey<AActor>, int32> BarIndices;
+
+	/** Bars gathered this frame */
+	TArray<FCombatHealthBar> VisibleBars;
+};
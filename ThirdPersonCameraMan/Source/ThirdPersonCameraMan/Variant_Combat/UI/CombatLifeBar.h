@@ -8,6 +8,8 @@
 
 /**
  *  A basic life bar user widget.
+ *  Deprecated: the combat characters no longer create one; their bars are drawn by UCombatHealthBarOverlay.
+ *  Kept so existing life bar widget Blueprints still load and compile.
  */
 UCLASS(abstract)
 class UCombatLifeBar : public UUserWidget